@@ -0,0 +1,164 @@
+/*
+ * AccessRebuildTestDriver.cpp
+ *
+ * Description: Drives the testing of Dictionary::rebuildForAccesses(). Words
+ *              are looked up with skewed frequencies while accesses are counted,
+ *              then the tree is rebuilt for them: it must keep every element,
+ *              and the counted lookups must take fewer comparisons, close to
+ *              the entropy of the lookups. Snapshots keep the previous tree.
+ *              Prints one line per check and returns the number of failures.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "Dictionary.h"
+#include "TestReport.h"
+#include "WordPair.h"
+#include "ElementDoesNotExistException.h"
+
+using std::cout;
+using std::endl;
+using std::vector;
+
+static const unsigned int WORD_COUNT = 2000;
+static const unsigned int LOOKUP_COUNT = 50000;
+
+static TestReport report;
+
+// Description: Returns the elements of "myWords" in key order.
+vector<WordPair> contentOf(const Dictionary & myWords) {
+
+  vector<WordPair> content;
+  myWords.displayContent([&content](WordPair & anElement) {
+     content.push_back(anElement);
+  });
+  return content;
+}
+
+// Description: Returns true if "a" and "b" hold the same elements, with their translations.
+bool sameContent(const vector<WordPair> & a, const vector<WordPair> & b) {
+
+  if (a.size() != b.size()) {
+     return false;
+  }
+  for (unsigned int i = 0; i < a.size(); i++) {
+     if (a[i].getEnglish() != b[i].getEnglish() || a[i].getTranslation() != b[i].getTranslation()) {
+        return false;
+     }
+  }
+  return true;
+}
+
+// Description: Returns true if every element of "content" is found in "myWords".
+bool findsAll(const Dictionary & myWords, const vector<WordPair> & content) {
+
+  for (const WordPair & anElement : content) {
+     WordPair query(anElement.getEnglish());
+     try {
+        if (myWords.get(query).getTranslation() != anElement.getTranslation()) {
+           return false;
+        }
+     }
+     catch (ElementDoesNotExistException& anException) {
+        return false;
+     }
+  }
+  return true;
+}
+
+// Description: Looks words up with Zipf-like frequencies, the i-th most popular
+//              about 1/i as often as the first, rebuilds the tree, and checks its
+//              content, its lookups and their average comparisons.
+void testRebuild() {
+
+  std::mt19937 generator(2023);
+  vector<unsigned int> order(WORD_COUNT);
+  for (unsigned int i = 0; i < WORD_COUNT; i++) {
+     order[i] = i;
+  }
+  std::shuffle(order.begin(), order.end(), generator);
+  Dictionary myWords;
+  myWords.enableReverseIndex();
+  for (unsigned int i : order) {
+     WordPair aWord("word" + std::to_string(i), "translation" + std::to_string(i % 10));
+     myWords.put(aWord);
+  }
+  vector<WordPair> content = contentOf(myWords);
+
+  //popularity is unrelated to key order and to the order of the puts, so that
+  //neither the balanced tree nor the one built by the puts is the best
+  vector<unsigned int> byPopularity(order);
+  std::shuffle(byPopularity.begin(), byPopularity.end(), generator);
+  vector<double> weights(WORD_COUNT);
+  for (unsigned int i = 0; i < WORD_COUNT; i++) {
+     weights[i] = 1.0 / (i + 1);
+  }
+  std::discrete_distribution<unsigned int> popularity(weights.begin(), weights.end());
+  vector<unsigned long> hits(WORD_COUNT, 0);
+  myWords.enableAccessCounts();
+  for (unsigned int i = 0; i < LOOKUP_COUNT; i++) {
+     unsigned int word = byPopularity[popularity(generator)];
+     WordPair query("word" + std::to_string(word));
+     myWords.get(query);
+     hits[word]++;
+  }
+  myWords.disableAccessCounts();
+  double entropy = 0;
+  for (unsigned long hit : hits) {
+     if (hit > 0) {
+        double p = hit / (double) LOOKUP_COUNT;
+        entropy -= p * std::log2(p);
+     }
+  }
+
+  Dictionary snapshot(myWords);
+  double before = myWords.getAverageAccessComparisons();
+  myWords.rebuildForAccesses();
+  double after = myWords.getAverageAccessComparisons();
+  bool passed = after < before && after <= entropy + 2;
+  if (!passed) {
+     cout << "   " << before << " comparisons before, " << after << " after, entropy " << entropy << endl;
+  }
+  report.check("rebuilt tree takes fewer comparisons, near the entropy", passed);
+
+  passed = sameContent(contentOf(myWords), content) && findsAll(myWords, content)
+           && myWords.getByTranslation("translation3").size() == WORD_COUNT / 10
+           && sameContent(contentOf(snapshot), content) && findsAll(snapshot, content)
+           && snapshot.getAverageAccessComparisons() == before;
+  WordPair newWord("word" + std::to_string(WORD_COUNT), "translation");
+  myWords.put(newWord);
+  content.push_back(newWord);
+  passed = passed && findsAll(myWords, content) && myWords.getElementCount() == WORD_COUNT + 1;
+  report.check("rebuilt tree keeps its elements, the snapshot its shape", passed);
+}
+
+// Description: Checks that rebuilding without counted accesses keeps the
+//              content, and that no comparisons are reported for it.
+void testRebuildWithoutAccesses() {
+
+  Dictionary myWords;
+  for (unsigned int i = 0; i < 100; i++) {
+     WordPair aWord("word" + std::to_string(i * 37 % 100), "translation");
+     myWords.put(aWord);
+  }
+  vector<WordPair> content = contentOf(myWords);
+  myWords.rebuildForAccesses();
+  report.check("rebuild without counted accesses",
+               myWords.getAverageAccessComparisons() == 0 && sameContent(contentOf(myWords), content)
+               && findsAll(myWords, content));
+}
+
+int main() {
+
+  testRebuild();
+  testRebuildWithoutAccesses();
+
+  return report.summarize();
+}
@@ -4,6 +4,9 @@
  * Description: Binary Search Tree data collection ADT class.
  *              Link-based implementation.
  *              Duplicated elements are not allowed.
+ *              Nodes are reference counted and shared between copies:
+ *              copying a BST is O(1) and an insertion copies only the
+ *              path from the root to the new leaf (copy-on-write).
  *
  * Class invariant: It is always a BST.
  * 
@@ -13,7 +16,9 @@
  
 #include "BST.h"
 #include "WordPair.h"
+#include <algorithm>
 #include <iostream>
+#include <new>
 
 
 // You cannot change the prototype of the public methods of this class.
@@ -27,19 +32,33 @@
    BST::BST() { }            
 
    // Copy constructor
+   // Time efficiency: O(1)
    BST::BST(const BST & aBST) {
 
-      //recursive copy function starting at root of new BST
-      root = copyTree(aBST.root);
+      //share the whole tree, nodes are copied lazily on insertion
+      root = shareTree(aBST.root);
       //copy elementCount
       elementCount = aBST.elementCount;
    }
 
    // Destructor 
    BST::~BST() {
-      //recursive delete function
-      deleteTree(root);
+      //drop this tree's reference, unshared nodes are deleted
+      releaseTree(root);
+      root = nullptr;
    }                
+
+   // Description: Makes this BST share the content of "rhs".
+   // Time efficiency: O(1), plus the cost of releasing the previous content.
+   BST & BST::operator=(const BST & rhs) {
+
+      //share first so that self-assignment is harmless
+      BSTNode * newRoot = shareTree(rhs.root);
+      releaseTree(root);
+      root = newRoot;
+      elementCount = rhs.elementCount;
+      return *this;
+   }
    
    
 /* Getters and setters */
@@ -63,11 +82,15 @@
    //            if "newElement" already exists in the binary search tree.
    // Time efficiency: O(log2 n)   
    void BST::insert(WordPair & newElement) {
+      insert(newElement, nullptr);
+   }
+
+   // Description: Same as insert(newElement), also returning the new node and
+   //              appending to "copies" each shared node the insertion copied, with its copy.
+   BSTNode * BST::insert(WordPair & newElement, std::vector<std::pair<BSTNode *, BSTNode *> > * copies) {
 
-      //allocate space for newElement
-      BSTNode * newNode = new BSTNode(newElement);
-      //set children to null since it's being added and set element member
-      newNode->left = nullptr; newNode->right = nullptr; newNode->element = newElement;
+      //allocate space for newElement, children are null since it's being added
+      BSTNode * newNode = new (std::nothrow) BSTNode(newElement);
       
       //new failed throw exception
       if(newNode == nullptr){
@@ -77,20 +100,36 @@
       else if(elementCount == 0){
          this->root = newNode;
          this->elementCount++;
-         return;
+         return newNode;
+      }
+      //the root may be shared with a copy of this BST, take our own before modifying it
+      bool inserted = false;
+      try{
+         BSTNode * previousRoot = this->root;
+         this->root = unshare(this->root);
+         if(copies != nullptr && this->root != previousRoot){
+            copies->push_back(std::make_pair(previousRoot, this->root));
+         }
+         inserted = insertR(newNode, this->root, copies);
+      }
+      catch(...){
+         //copying a shared node failed, "newNode" was never linked
+         delete newNode;
+         throw;
       }
       //if element already exists throw exception, otherwise insert recursively
-      if(!insertR(newNode, this->root)){
+      if(!inserted){
+         delete newNode;
          throw(ElementAlreadyExistsException("Element already exists."));
       }
-      // to do
-	  
+      return newNode;
    } 
 
    // Description: Recursive insertion into a binary search tree.
    //              Returns true when "anElement" has been successfully inserted into the 
    //              binary search tree. Otherwise, returns false.
-   bool BST::insertR(BSTNode * newBSTNode, BSTNode * current) {
+   bool BST::insertR(BSTNode * newBSTNode, BSTNode * current,
+                     std::vector<std::pair<BSTNode *, BSTNode *> > * copies) {
       //technically throws element already exists (would fail anyway)
       if(newBSTNode == nullptr || current == nullptr){
          return false;
@@ -99,23 +138,44 @@
       //if new is greater than current, push it right
       if(newBSTNode->element > current->element){
          if(current->hasRight()){
-            return insertR(newBSTNode, current->right);
+            BSTNode * child = current->right;
+            current->right = unshare(child);
+            if(copies != nullptr && current->right != child){
+               copies->push_back(std::make_pair(child, current->right));
+            }
+            //the subtree only grows if the element was not already in it
+            bool inserted = insertR(newBSTNode, current->right, copies);
+            if(inserted){
+               current->size++;
+            }
+            return inserted;
          }
          //if no right leaf, set it as right leaf of current
          else{
             current->right = newBSTNode;
+            current->size++;
             elementCount++;
             return true;
          }
       }
-      //if new is less than current, push it right
+      //if new is less than current, push it left
       else if(newBSTNode->element < current->element){
          if(current->hasLeft()){
-            return insertR(newBSTNode, current->left);
+            BSTNode * child = current->left;
+            current->left = unshare(child);
+            if(copies != nullptr && current->left != child){
+               copies->push_back(std::make_pair(child, current->left));
+            }
+            bool inserted = insertR(newBSTNode, current->left, copies);
+            if(inserted){
+               current->size++;
+            }
+            return inserted;
          }
          //if no left leaf, set it as left leaf of current
          else{
             current->left = newBSTNode;
+            current->size++;
             elementCount++;
             return true;
          }
@@ -204,6 +264,17 @@
      return;
    }
 
+   // Description: Same as above, for a "visit" that carries state (e.g. a capturing lambda).
+   // Time efficiency: O(n)
+   void BST::traverseInOrder(const std::function<void(WordPair &)> & visit) const {
+
+     //empty exception
+     if (elementCount == 0)  
+       throw EmptyDataCollectionException("Binary search tree is empty.");
+
+     traverseInOrderR(visit, root);
+   }
+
    // Description: Recursive in order traversal of a binary search tree.   
    void BST::traverseInOrderR(void visit(WordPair &), BSTNode* current) const { 
       
@@ -219,34 +290,287 @@
       }
    }
 
-   // Description: Helper function to deep copy BST.
-   // Precondition: BST has been initialized.
-   // Time Efficiency: O(n)
-   BSTNode * BST::copyTree(BSTNode * node){
+   // Description: Recursive in order traversal of a binary search tree.   
+   void BST::traverseInOrderR(const std::function<void(WordPair &)> & visit, BSTNode* current) const { 
 
-      //if node is null return nullptr
-      if(node == nullptr){
+      if(current->hasLeft()){
+         traverseInOrderR(visit, current->left);
+      }
+      visit(current->element);
+      if(current->hasRight()){
+         traverseInOrderR(visit, current->right);
+      }
+   }
+
+   // Description: Returns the number of elements less than "targetElement",
+   //              or at most "targetElement" if "orEqual" is true.
+   // Time efficiency: O(height)
+   unsigned int BST::rank(const WordPair & targetElement, bool orEqual) const {
+
+      unsigned int count = 0;
+      BSTNode * current = root;
+      while(current != nullptr){
+         //current and its left subtree all count, carry on to the right
+         if(targetElement > current->element || (orEqual && !(targetElement < current->element))){
+            count += sizeOf(current->left) + 1;
+            current = current->right;
+         }
+         else{
+            current = current->left;
+         }
+      }
+      return count;
+   }
+
+   // Description: Returns the element at in order position "position" (0 is the smallest).
+   // Exception: Throws the exception "ElementDoesNotExistException"
+   //            if "position" is not less than the number of elements.
+   // Time efficiency: O(height)
+   WordPair & BST::select(unsigned int position) const {
+
+      if(position >= elementCount){
+         throw ElementDoesNotExistException("***Not Found!***");
+      }
+      BSTNode * current = root;
+      while(true){
+         unsigned int leftSize = sizeOf(current->left);
+         if(position < leftSize){
+            current = current->left;
+         }
+         else if(position == leftSize){
+            return current->element;
+         }
+         else{
+            //skip the left subtree and current
+            position -= leftSize + 1;
+            current = current->right;
+         }
+      }
+   }
+
+   // Description: Traverses in order the elements at positions "offset" to
+   //              "offset" + "count" - 1, or up to the last element.
+   // Time efficiency: O(height + count)
+   void BST::traverseRange(unsigned int offset, unsigned int count,
+                           const std::function<void(WordPair &)> & visit) const {
+
+      if(offset >= elementCount || count == 0){
+         return;
+      }
+      unsigned int last = (count > elementCount - offset) ? elementCount : offset + count;
+      traverseRangeR(visit, root, offset, last);
+   }
+
+   // Description: Recursive in order traversal of the elements at in order positions
+   //              "first" (included) to "last" (excluded) of the subtree rooted at "current".
+   void BST::traverseRangeR(const std::function<void(WordPair &)> & visit, BSTNode * current,
+                            unsigned int first, unsigned int last) const {
+
+      if(current == nullptr || first >= last){
+         return;
+      }
+      unsigned int leftSize = sizeOf(current->left);
+      if(first < leftSize){
+         traverseRangeR(visit, current->left, first, last < leftSize ? last : leftSize);
+      }
+      if(first <= leftSize && leftSize < last){
+         visit(current->element);
+      }
+      //positions in the right subtree start after the left subtree and current
+      if(last > leftSize + 1){
+         traverseRangeR(visit, current->right, first > leftSize + 1 ? first - leftSize - 1 : 0,
+                        last - leftSize - 1);
+      }
+   }
+
+   // Description: Rebuilds the binary search tree so that elements retrieved
+   //              often sit near the root (weight-balanced on access counts plus one).
+   // Exception: Throws the exception "UnableToInsertException" if the "new"
+   //            operator failed, leaving the binary search tree unchanged.
+   // Time efficiency: O(n log2 n)
+   void BST::rebuildByAccessCounts() {
+
+      if(elementCount == 0){
+         return;
+      }
+      std::vector<BSTNode *> nodes;
+      nodes.reserve(elementCount);
+      collectInOrderR(root, nodes);
+      //the extra one keeps elements never retrieved balanced among themselves
+      std::vector<double> prefixWeight(nodes.size() + 1, 0);
+      for(unsigned int i = 0; i < nodes.size(); i++){
+         prefixWeight[i + 1] = prefixWeight[i] + nodes[i]->accessCount.load(std::memory_order_relaxed) + 1;
+      }
+      //new nodes, as the old ones may be shared with copies of this BST
+      BSTNode * newRoot = buildWeightedR(nodes, prefixWeight, 0, nodes.size());
+      releaseTree(root);
+      root = newRoot;
+   }
+
+   // Description: Returns a new subtree holding copies of "nodes[first]" to
+   //              "nodes[last - 1]", rooted by Mehlhorn's rule.
+   // Exception: Throws the exception "UnableToInsertException" if the "new" operator failed.
+   BSTNode * BST::buildWeightedR(const std::vector<BSTNode *> & nodes,
+                                 const std::vector<double> & prefixWeight,
+                                 unsigned int first, unsigned int last){
+
+      if(first >= last){
          return nullptr;
       }
-      else{
-         //allocate new node space
-         BSTNode * newNode = new BSTNode(node->element);
-         //post-order traversal of tree copying each node
-         return newNode->left = copyTree(node->left);
-         return newNode->right = copyTree(node->right);
-         return newNode;
+      //the root is the node whose weight straddles the middle of the range
+      double middle = (prefixWeight[first] + prefixWeight[last]) / 2;
+      unsigned int rootIndex = std::upper_bound(prefixWeight.begin() + first + 1,
+                                                prefixWeight.begin() + last + 1, middle)
+                               - prefixWeight.begin() - 1;
+      if(rootIndex >= last){
+         rootIndex = last - 1;
+      }
+
+      BSTNode * left = buildWeightedR(nodes, prefixWeight, first, rootIndex);
+      BSTNode * right = nullptr;
+      try{
+         right = buildWeightedR(nodes, prefixWeight, rootIndex + 1, last);
+      }
+      catch(UnableToInsertException & anException){
+         releaseTree(left);
+         throw;
+      }
+      BSTNode * node = new (std::nothrow) BSTNode(nodes[rootIndex]->element, left, right);
+      if(node == nullptr){
+         releaseTree(left);
+         releaseTree(right);
+         throw UnableToInsertException("'new' operator failed.");
+      }
+      node->accessCount.store(nodes[rootIndex]->accessCount.load(std::memory_order_relaxed),
+                              std::memory_order_relaxed);
+      return node;
+   }
+
+   // Description: Appends the nodes of the subtree rooted at "current" to "nodes", in order.
+   void BST::collectInOrderR(BSTNode * current, std::vector<BSTNode *> & nodes){
+
+      if(current == nullptr){
+         return;
       }
+      collectInOrderR(current->left, nodes);
+      nodes.push_back(current);
+      collectInOrderR(current->right, nodes);
    }
 
-   // Description: Helper function to destruct BST.
-   // Precondition: BST has been initialized.
-   // Time Efficiency: O(n)
-   void BST::deleteTree(BSTNode * node){
-      //if node isn't null delete in post-order
-      if(node!=nullptr){
-         deleteTree(node->left);
-         deleteTree(node->right);
+   // Description: Returns the average number of comparisons made by the
+   //              retrievals counted in the nodes' access counts, in the current shape.
+   // Time efficiency: O(n)
+   double BST::getAverageAccessComparisons() const {
+
+      //breadth first, one level (one more comparison) at a time
+      double comparisons = 0;
+      double accesses = 0;
+      std::vector<BSTNode *> level;
+      if(root != nullptr){
+         level.push_back(root);
+      }
+      for(unsigned int depth = 1; !level.empty(); depth++){
+         std::vector<BSTNode *> next;
+         for(BSTNode * node : level){
+            double count = node->accessCount.load(std::memory_order_relaxed);
+            comparisons += count * depth;
+            accesses += count;
+            if(node->hasLeft()) next.push_back(node->left);
+            if(node->hasRight()) next.push_back(node->right);
+         }
+         level.swap(next);
+      }
+      return accesses == 0 ? 0 : comparisons / accesses;
+   }
+
+   // Description: Returns the node holding "targetElement", or nullptr if there is none.
+   // Time Efficiency: O(depth of "targetElement")
+   BSTNode * BST::findNode(const WordPair & targetElement) const {
+
+      BSTNode * current = root;
+      while(current != nullptr){
+         if(targetElement > current->element){
+            current = current->right;
+         }
+         else if(targetElement < current->element){
+            current = current->left;
+         }
+         else{
+            return current;
+         }
+      }
+      return nullptr;
+   }
+
+   // Description: Returns the nodes an insertion of "targetElement" goes through,
+   //              from the root down: the nodes it may copy.
+   // Time Efficiency: O(depth of "targetElement")
+   std::vector<const BSTNode *> BST::findPath(const WordPair & targetElement) const {
+
+      std::vector<const BSTNode *> path;
+      const BSTNode * current = root;
+      while(current != nullptr){
+         path.push_back(current);
+         if(targetElement > current->element){
+            current = current->right;
+         }
+         else if(targetElement < current->element){
+            current = current->left;
+         }
+         else{
+            break;
+         }
+      }
+      return path;
+   }
+
+   // Description: Returns the number of elements in the subtree rooted at "node".
+   // Time Efficiency: O(1)
+   unsigned int BST::sizeOf(const BSTNode * node){
+      return node == nullptr ? 0 : node->size;
+   }
+
+   // Description: Adds a reference to the subtree rooted at "node" and returns it.
+   // Time Efficiency: O(1)
+   BSTNode * BST::shareTree(BSTNode * node){
+
+      if(node != nullptr){
+         node->refCount.fetch_add(1, std::memory_order_relaxed);
+      }
+      return node;
+   }
+
+   // Description: Drops a reference to the subtree rooted at "node".
+   //              Nodes whose last reference is dropped are deleted.
+   // Time Efficiency: O(n) worst case, O(1) while the subtree is still shared.
+   void BST::releaseTree(BSTNode * node){
+
+      //post-order: children only lose a reference when their parent is deleted
+      if(node != nullptr && node->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1){
+         releaseTree(node->left);
+         releaseTree(node->right);
          delete node;
       }
-      root = nullptr;
-   }
\ No newline at end of file
+   }
+
+   // Description: Returns a node equivalent to "node" that this tree owns alone.
+   //              If "node" is shared, it is cloned (its children are shared
+   //              by the clone) and this tree's reference to it is dropped.
+   // Postcondition: The returned node has a refCount of 1.
+   // Time Efficiency: O(1)
+   BSTNode * BST::unshare(BSTNode * node){
+
+      if(node == nullptr || node->refCount.load(std::memory_order_acquire) == 1){
+         return node;
+      }
+      BSTNode * clone = new (std::nothrow) BSTNode(node->element, node->left, node->right);
+      if(clone == nullptr){
+         throw UnableToInsertException("'new' operator failed.");
+      }
+      clone->accessCount.store(node->accessCount.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      //the clone is a new parent of both children
+      shareTree(clone->left);
+      shareTree(clone->right);
+      releaseTree(node);
+      return clone;
+   }
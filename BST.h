@@ -4,6 +4,9 @@
  * Description: Binary Search Tree data collection ADT class.
  *              Link-based implementation.
  *              Duplicated elements are not allowed.
+ *              Nodes are reference counted and shared between copies:
+ *              copying a BST is O(1) and an insertion copies only the
+ *              path from the root to the new leaf (copy-on-write).
  *
  * Class invariant: It is always a BST.
  * 
@@ -20,6 +23,9 @@
 #include "EmptyDataCollectionException.h"
 #include "UnableToInsertException.h"
 #include "WordPair.h"
+#include <functional>
+#include <utility>
+#include <vector>
 
 
 class BST {
@@ -30,6 +36,7 @@ private:
    BSTNode * root = nullptr; 
    unsigned int elementCount = 0;
    friend class Dictionary;        
+   friend class ShardedDictionary;
 
    /* Utility methods */
    
@@ -38,7 +45,19 @@ private:
    // Description: Recursive insertion into a binary search tree.
    //              Returns true when "anElement" has been successfully inserted into the 
    //              binary search tree. Otherwise, returns false.
-   bool insertR(BSTNode * newBSTNode, BSTNode * current);
+   //              Shared nodes along the search path are unshared before
+   //              they are modified.
+   //              Each node copied that way is appended to "copies", with its copy,
+   //              unless "copies" is null.
+   // Precondition: "current" is owned by this tree alone (refCount of 1).
+   bool insertR(BSTNode * newBSTNode, BSTNode * current,
+                std::vector<std::pair<BSTNode *, BSTNode *> > * copies);
+
+   // Description: Same as insert(newElement), also returning the new node and
+   //              appending to "copies" each shared node the insertion copied,
+   //              with its copy - even if the insertion then fails - so that
+   //              an index of nodes can follow the tree.
+   BSTNode * insert(WordPair & newElement, std::vector<std::pair<BSTNode *, BSTNode *> > * copies);
 
    // Description: Recursive retrieval from a binary search tree.
    // Exception: Throws the exception "ElementDoesNotExistException" 
@@ -47,16 +66,54 @@ private:
 
    // Description: Recursive in order traversal of a binary search tree.   
    void traverseInOrderR(void visit(WordPair &), BSTNode * current) const;
-
-   // Description: Helper function to deep copy BST.
-   // Precondition: BST has been initialized.
-   // Time Efficiency: O(n)
-   BSTNode * copyTree(BSTNode * node);
-
-   // Description: Helper function to destruct BST.
-   // Precondition: BST has been initialized.
-   // Time Efficiency: O(n)
-   void deleteTree(BSTNode * node);
+   void traverseInOrderR(const std::function<void(WordPair &)> & visit, BSTNode * current) const;
+
+   // Description: Recursive in order traversal of the elements at in order positions
+   //              "first" (included) to "last" (excluded) of the subtree rooted at "current".
+   //              Subtrees entirely outside the positions are skipped.
+   void traverseRangeR(const std::function<void(WordPair &)> & visit, BSTNode * current,
+                       unsigned int first, unsigned int last) const;
+
+   // Description: Returns the node holding "targetElement", or nullptr if there is none.
+   // Time Efficiency: O(depth of "targetElement")
+   BSTNode * findNode(const WordPair & targetElement) const;
+
+   // Description: Returns the nodes an insertion of "targetElement" goes through,
+   //              from the root down: the nodes it may copy.
+   // Time Efficiency: O(depth of "targetElement")
+   std::vector<const BSTNode *> findPath(const WordPair & targetElement) const;
+
+   // Description: Appends the nodes of the subtree rooted at "current" to "nodes", in order.
+   static void collectInOrderR(BSTNode * current, std::vector<BSTNode *> & nodes);
+
+   // Description: Returns a new subtree holding copies of "nodes[first]" to
+   //              "nodes[last - 1]", each subtree root chosen so that its left
+   //              and right weights are as close as possible (Mehlhorn's rule).
+   //              "prefixWeight[i]" is the total weight of "nodes[0]" to "nodes[i - 1]".
+   // Exception: Throws the exception "UnableToInsertException" if the "new" operator failed.
+   static BSTNode * buildWeightedR(const std::vector<BSTNode *> & nodes,
+                                   const std::vector<double> & prefixWeight,
+                                   unsigned int first, unsigned int last);
+
+   // Description: Returns the number of elements in the subtree rooted at "node".
+   // Time Efficiency: O(1)
+   static unsigned int sizeOf(const BSTNode * node);
+
+   // Description: Adds a reference to the subtree rooted at "node" and returns it.
+   // Time Efficiency: O(1)
+   static BSTNode * shareTree(BSTNode * node);
+
+   // Description: Drops a reference to the subtree rooted at "node".
+   //              Nodes whose last reference is dropped are deleted.
+   // Time Efficiency: O(n) worst case, O(1) while the subtree is still shared.
+   static void releaseTree(BSTNode * node);
+
+   // Description: Returns a node equivalent to "node" that this tree owns alone.
+   //              If "node" is shared, it is cloned (its children are shared
+   //              by the clone) and this tree's reference to it is dropped.
+   // Postcondition: The returned node has a refCount of 1.
+   // Time Efficiency: O(1)
+   static BSTNode * unshare(BSTNode * node);
 
 
 public:
@@ -68,8 +125,11 @@ public:
 
    /* Constructors and destructor */
    BST();                        // Default constructor
-   BST(const BST & aBST);        // Copy constructor 
+   BST(const BST & aBST);        // Copy constructor - O(1) snapshot
    ~BST();                       // Destructor 
+
+   // Description: Makes this BST share the content of "rhs" - O(1) snapshot.
+   BST & operator=(const BST & rhs);
    
    /* Getters and setters */
    unsigned int getElementCount() const;
@@ -98,6 +158,8 @@ public:
    // Exception: Propagates the exception "ElementDoesNotExistException" 
    //            thrown from the retrieveR(...)
    //            if "targetElement" is not found in the binary search tree.
+   // Note: The returned element may be shared with copies of this BST,
+   //       so it must not be modified through the returned reference.
    // Time efficiency: O(log2 n)
    WordPair & retrieve(WordPair & targetElement) const;
    
@@ -110,5 +172,45 @@ public:
    // Time efficiency: O(n)   
    void traverseInOrder(void visit(WordPair &)) const;
 
+   // Description: Same as above, for a "visit" that carries state (e.g. a capturing lambda).
+   void traverseInOrder(const std::function<void(WordPair &)> & visit) const;
+
+   // Description: Returns the number of elements less than "targetElement",
+   //              or at most "targetElement" if "orEqual" is true.
+   //              "targetElement" need not be in the binary search tree.
+   // Time efficiency: O(height)
+   unsigned int rank(const WordPair & targetElement, bool orEqual = false) const;
+
+   // Description: Returns the element at in order position "position" (0 is the smallest).
+   // Exception: Throws the exception "ElementDoesNotExistException"
+   //            if "position" is not less than the number of elements.
+   // Note: As with retrieve, the element must not be modified through the returned reference.
+   // Time efficiency: O(height)
+   WordPair & select(unsigned int position) const;
+
+   // Description: Traverses in order the elements at positions "offset" to
+   //              "offset" + "count" - 1, or up to the last element.
+   // Time efficiency: O(height + count)
+   void traverseRange(unsigned int offset, unsigned int count,
+                      const std::function<void(WordPair &)> & visit) const;
+
+   // Description: Rebuilds the binary search tree so that elements retrieved
+   //              often sit near the root: each subtree is rooted at the element
+   //              that best balances the access counts (plus one) on its two sides.
+   //              The expected number of comparisons per retrieval is then within
+   //              2 of the entropy of the access counts, rather than log2 n.
+   //              The new nodes keep the access counts; copies of this BST keep
+   //              the previous shape.
+   // Exception: Throws the exception "UnableToInsertException" if the "new"
+   //            operator failed, leaving the binary search tree unchanged.
+   // Time efficiency: O(n log2 n)
+   void rebuildByAccessCounts();
+
+   // Description: Returns the average number of comparisons made by the
+   //              retrievals counted in the nodes' access counts, in the current shape.
+   //              Returns 0 if no retrieval was counted.
+   // Time efficiency: O(n)
+   double getAverageAccessComparisons() const;
+
 }; // end BST
 #endif
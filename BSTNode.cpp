@@ -19,6 +19,7 @@ BSTNode::BSTNode(WordPair & newElement, BSTNode * left, BSTNode * right) {
    this->element = newElement;
    this->left = left;
    this->right = right;   
+   this->size = 1 + (left != nullptr ? left->size : 0) + (right != nullptr ? right->size : 0);
 }
 
 // Boolean helper functions
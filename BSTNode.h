@@ -11,6 +11,7 @@
 #define BST_NODE_H
 
 #include "WordPair.h"
+#include <atomic>
 
 
 class BSTNode {
@@ -21,6 +22,17 @@ public:
     BSTNode * left = nullptr;
     BSTNode * right = nullptr;
 
+    // Number of trees (and parent nodes) sharing this node.
+    // A node may only be modified in place while refCount is 1.
+    std::atomic<unsigned int> refCount{1};
+
+    // Number of elements in the subtree rooted at this node (itself included).
+    unsigned int size = 1;
+
+    // Number of lookups that found this node, when the tree records them.
+    // Incremented by concurrent readers, hence atomic.
+    std::atomic<unsigned long> accessCount{0};
+
     // Constructors
     BSTNode();
     BSTNode(WordPair & element);
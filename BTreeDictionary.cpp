@@ -0,0 +1,275 @@
+/*
+ * BTreeDictionary.cpp
+ * 
+ * Description: Dictonary data collection ADT class.
+ *              B-tree implementation: each node holds up to MAX_KEYS keys,
+ *              and the first 8 bytes of each key are packed in an array of
+ *              integers ("prefixes") that fits in two cache lines. A node is
+ *              searched by a linear scan of its prefixes, and the full keys
+ *              are only compared when prefixes are equal.
+ *              Duplicated elements not allowed.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "BTreeDictionary.h"
+#include <memory>
+#include <new>
+
+/* Constructor and destructor */
+
+   BTreeDictionary::BTreeDictionary(unsigned int normalization) : normalizer(normalization) { }
+
+   // Destructor
+   BTreeDictionary::~BTreeDictionary() {
+      deleteTree(root);
+      root = nullptr;
+   }
+
+
+/* Getters */
+
+   // Description: Returns the number of elements currently stored in the Dictionary.
+   // Time efficiency: O(1)
+   unsigned int BTreeDictionary::getElementCount() const {
+      return elementCount;
+   }
+
+   // Description: Returns the number of levels of the tree (0 when empty).
+   // Time efficiency: O(1)
+   unsigned int BTreeDictionary::getHeight() const {
+      return height;
+   }
+
+
+/* Dictionary operations */
+
+   // Description: Puts "newElement" (association of key-value) into the Dictionary.
+   // Exception: Throws the exception "UnableToInsertException" 
+   //            when newElement cannot be inserted in the Dictionary.  
+   // Exception: Throws the exception "ElementAlreadyExistsException" 
+   //            if "newElement" already exists in the Dictionary.
+   // Time efficiency: O(log n)
+   void BTreeDictionary::put(WordPair & newElement) {
+
+      WordPair keyed = newElement;
+      if (!normalizer.isIdentity()) {
+         keyed.setKey(normalizer.normalize(newElement.getEnglish()));
+      }
+      uint64_t keyPrefix = prefixOf(keyed.getKey());
+
+      //the tree only grows at the root: a full root gets a new parent
+      if (root == nullptr || root->count == MAX_KEYS) {
+         //owned here until it is the root, so a failed split does not leak it
+         std::unique_ptr<Node> newRoot(new (std::nothrow) Node());
+         if (newRoot == nullptr) {
+            throw UnableToInsertException("'new' operator failed.");
+         }
+         if (root != nullptr) {
+            newRoot->leaf = false;
+            newRoot->children[0] = root;
+            splitChild(newRoot.get(), 0);
+         }
+         root = newRoot.release();
+         height++;
+      }
+
+      Node * node = root;
+      while (true) {
+         bool found = false;
+         int pos = search(node, keyed, keyPrefix, found);
+         if (found) {
+            throw ElementAlreadyExistsException("Element already exists.");
+         }
+         if (node->leaf) {
+            WordPair * element = new (std::nothrow) WordPair(keyed);
+            if (element == nullptr) {
+               throw UnableToInsertException("'new' operator failed.");
+            }
+            //shift the larger keys right to make room
+            for (int i = node->count; i > pos; i--) {
+               node->prefix[i] = node->prefix[i - 1];
+               node->elements[i] = node->elements[i - 1];
+            }
+            node->prefix[pos] = keyPrefix;
+            node->elements[pos] = element;
+            node->count++;
+            elementCount++;
+            return;
+         }
+         //split a full child before entering it, so it can take one more key
+         if (node->children[pos]->count == MAX_KEYS) {
+            splitChild(node, pos);
+            if (keyed == *node->elements[pos]) {
+               throw ElementAlreadyExistsException("Element already exists.");
+            }
+            if (keyed > *node->elements[pos]) {
+               pos++;
+            }
+         }
+         node = node->children[pos];
+      }
+   }
+
+   // Description: Gets the element whose key matches "targetElement".
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Exception: Throws the exception ElementDoesNotExistException
+   //            if the key is not found in the Dictionary.
+   // Time efficiency: O(log n)
+   WordPair & BTreeDictionary::get(WordPair & targetElement) const {
+
+      if (elementCount == 0)
+         throw EmptyDataCollectionException("Dictionary is empty.");
+
+      WordPair query = makeQuery(targetElement);
+      uint64_t keyPrefix = prefixOf(query.getKey());
+      const Node * node = root;
+      while (true) {
+         bool found = false;
+         int pos = search(node, query, keyPrefix, found);
+         if (found) {
+            return *node->elements[pos];
+         }
+         if (node->leaf) {
+            throw ElementDoesNotExistException("***Not Found!***");
+         }
+         node = node->children[pos];
+      }
+   }
+
+   // Description: Visits the content of the Dictionary in key order.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   void BTreeDictionary::displayContent(void visit(WordPair &)) const {
+      displayContent(std::function<void(WordPair &)>(visit));
+   }
+
+   // Description: Visits the content of the Dictionary in key order.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Time efficiency: O(n)
+   void BTreeDictionary::displayContent(const std::function<void(WordPair &)> & visit) const {
+
+      if (elementCount == 0)
+         throw EmptyDataCollectionException("Dictionary is empty.");
+
+      traverseInOrderR(visit, root);
+   }
+
+
+/* Utility methods */
+
+   // Description: Returns the first 8 bytes of "key" packed big-endian.
+   //              Shorter keys are padded with zero bytes.
+   uint64_t BTreeDictionary::prefixOf(const string & key) {
+
+      uint64_t prefix = 0;
+      size_t length = key.size() < 8 ? key.size() : 8;
+      for (size_t i = 0; i < length; i++) {
+         prefix |= (uint64_t) (unsigned char) key[i] << (56 - 8 * i);
+      }
+      return prefix;
+   }
+
+   // Description: Returns the position of the first key of "node" not less
+   //              than "key", and sets "found" if that key equals "key".
+   // Time efficiency: O(MAX_KEYS)
+   int BTreeDictionary::search(const Node * node, const WordPair & key, uint64_t keyPrefix, bool & found) {
+
+      //branch-free count of the smaller prefixes, the compiler can vectorize it
+      int pos = 0;
+      for (int i = 0; i < node->count; i++) {
+         pos += (node->prefix[i] < keyPrefix);
+      }
+      //equal prefixes are told apart by the full keys
+      found = false;
+      while (pos < node->count && node->prefix[pos] == keyPrefix) {
+         int comparison = node->elements[pos]->getKey().compare(key.getKey());
+         if (comparison >= 0) {
+            found = (comparison == 0);
+            return pos;
+         }
+         pos++;
+      }
+      return pos;
+   }
+
+   // Description: Splits the full child "index" of "parent" in two, moving
+   //              its middle key up into "parent".
+   // Precondition: "parent" is not full.
+   void BTreeDictionary::splitChild(Node * parent, int index) {
+
+      Node * child = parent->children[index];
+      Node * sibling = new (std::nothrow) Node();
+      if (sibling == nullptr) {
+         throw UnableToInsertException("'new' operator failed.");
+      }
+      const int middle = MAX_KEYS / 2;
+
+      //the keys (and children) after the middle one move to the new sibling
+      sibling->leaf = child->leaf;
+      sibling->count = child->count - middle - 1;
+      for (int i = 0; i < sibling->count; i++) {
+         sibling->prefix[i] = child->prefix[middle + 1 + i];
+         sibling->elements[i] = child->elements[middle + 1 + i];
+      }
+      if (!child->leaf) {
+         for (int i = 0; i <= sibling->count; i++) {
+            sibling->children[i] = child->children[middle + 1 + i];
+         }
+      }
+      child->count = middle;
+
+      //the middle key moves up between the two halves
+      for (int i = parent->count; i > index; i--) {
+         parent->prefix[i] = parent->prefix[i - 1];
+         parent->elements[i] = parent->elements[i - 1];
+         parent->children[i + 1] = parent->children[i];
+      }
+      parent->prefix[index] = child->prefix[middle];
+      parent->elements[index] = child->elements[middle];
+      parent->children[index + 1] = sibling;
+      parent->count++;
+   }
+
+   // Description: Helper function to destruct the subtree rooted at "node".
+   // Time Efficiency: O(n)
+   void BTreeDictionary::deleteTree(Node * node) {
+
+      if (node == nullptr) {
+         return;
+      }
+      for (int i = 0; i < node->count; i++) {
+         delete node->elements[i];
+      }
+      if (!node->leaf) {
+         for (int i = 0; i <= node->count; i++) {
+            deleteTree(node->children[i]);
+         }
+      }
+      delete node;
+   }
+
+   // Description: Recursive in order traversal of the subtree rooted at "node".
+   void BTreeDictionary::traverseInOrderR(const std::function<void(WordPair &)> & visit, Node * node) {
+
+      for (int i = 0; i < node->count; i++) {
+         if (!node->leaf) {
+            traverseInOrderR(visit, node->children[i]);
+         }
+         visit(*node->elements[i]);
+      }
+      if (!node->leaf) {
+         traverseInOrderR(visit, node->children[node->count]);
+      }
+   }
+
+   // Description: Returns "targetElement" with its key normalized by the policy.
+   WordPair BTreeDictionary::makeQuery(const WordPair & targetElement) const {
+
+      if (normalizer.isIdentity()) {
+         return targetElement;
+      }
+      WordPair query;
+      query.setKey(normalizer.normalize(targetElement.getEnglish()));
+      return query;
+   }
@@ -0,0 +1,120 @@
+/*
+ * BTreeDictionary.h
+ * 
+ * Description: Dictonary data collection ADT class.
+ *              B-tree implementation: each node holds up to MAX_KEYS keys,
+ *              and the first 8 bytes of each key are packed in an array of
+ *              integers ("prefixes") that fits in two cache lines. A node is
+ *              searched by a linear scan of its prefixes, and the full keys
+ *              are only compared when prefixes are equal. The tree is about
+ *              log16(n) levels deep instead of log2(n) for the BST, so a
+ *              lookup takes far fewer dependent pointer loads.
+ *              Duplicated elements not allowed.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef BTREE_DICTIONARY_H
+#define BTREE_DICTIONARY_H
+
+#include "KeyNormalizer.h"
+#include "WordPair.h"
+#include "ElementAlreadyExistsException.h"
+#include "ElementDoesNotExistException.h"
+#include "EmptyDataCollectionException.h"
+#include "UnableToInsertException.h"
+#include <cstdint>
+#include <functional>
+
+class BTreeDictionary {
+
+private:
+
+   // Keys per node: 15 prefixes of 8 bytes take 120 bytes, two cache lines.
+   static const int MAX_KEYS = 15;
+
+   // Aligned to a cache line, with the prefixes first: a node's search reads
+   // its first two lines only, prefixes and count alike.
+   struct alignas(64) Node {
+      uint64_t prefix[MAX_KEYS];                // first 8 key bytes, big-endian
+      int count = 0;                            // number of keys
+      bool leaf = true;
+      WordPair * elements[MAX_KEYS];            // elements never move once put
+      Node * children[MAX_KEYS + 1];            // count + 1 children unless leaf
+   };
+
+   Node * root = nullptr;
+   unsigned int elementCount = 0;
+   unsigned int height = 0;
+   KeyNormalizer normalizer;
+
+   // Description: Returns the first 8 bytes of "key" packed big-endian, so that
+   //              comparing prefixes as integers agrees with comparing keys.
+   static uint64_t prefixOf(const string & key);
+
+   // Description: Returns the position of the first key of "node" not less
+   //              than "key", and sets "found" if that key equals "key".
+   // Time efficiency: O(MAX_KEYS)
+   static int search(const Node * node, const WordPair & key, uint64_t keyPrefix, bool & found);
+
+   // Description: Splits the full child "index" of "parent" in two, moving
+   //              its middle key up into "parent".
+   // Precondition: "parent" is not full.
+   static void splitChild(Node * parent, int index);
+
+   // Description: Helper function to destruct the subtree rooted at "node".
+   // Time Efficiency: O(n)
+   static void deleteTree(Node * node);
+
+   // Description: Recursive in order traversal of the subtree rooted at "node".
+   static void traverseInOrderR(const std::function<void(WordPair &)> & visit, Node * node);
+
+   // Description: Returns "targetElement" with its key normalized by the policy.
+   WordPair makeQuery(const WordPair & targetElement) const;
+
+   // Not copyable.
+   BTreeDictionary(const BTreeDictionary &) = delete;
+   BTreeDictionary & operator=(const BTreeDictionary &) = delete;
+
+public:
+
+   // Constructor and destructor
+   // Keys are compared after the "normalization" policy (KeyNormalizer flags).
+   BTreeDictionary(unsigned int normalization = KeyNormalizer::NONE);
+   ~BTreeDictionary();
+
+   // Description: Returns the number of elements currently stored in the Dictionary.
+   unsigned int getElementCount() const;
+
+   // Description: Returns the number of levels of the tree (0 when empty).
+   unsigned int getHeight() const;
+
+   // Description: Puts "newElement" (association of key-value) into the Dictionary.
+   //              Full nodes met on the way down are split, so the insertion
+   //              never has to walk back up.
+   // Precondition: "newElement" does not already exist in the Dictionary.
+   // Exception: Throws the exception "UnableToInsertException" 
+   //            when newElement cannot be inserted in the Dictionary.  
+   // Exception: Throws the exception "ElementAlreadyExistsException" 
+   //            if "newElement" already exists in the Dictionary.
+   // Time efficiency: O(log n)
+   void put(WordPair & newElement);
+
+   // Description: Gets the element whose key matches "targetElement".
+   //              The returned reference stays valid across later puts.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Exception: Throws the exception ElementDoesNotExistException
+   //            if the key is not found in the Dictionary.
+   // Time efficiency: O(log n)
+   WordPair & get(WordPair & targetElement) const;
+
+   // Description: Visits the content of the Dictionary in key order.
+   // Precondition: Dictionary is not empty.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Time efficiency: O(n)
+   void displayContent(void visit(WordPair &)) const;
+   void displayContent(const std::function<void(WordPair &)> & visit) const;
+
+}; // end BTreeDictionary
+#endif
@@ -0,0 +1,174 @@
+/*
+ * BTreeDictionaryTestDriver.cpp
+ *
+ * Description: Drives the testing of the BTreeDictionary ADT class. Random
+ *              puts and gets are checked against a std::map holding what the
+ *              Dictionary should, with keys shorter than a prefix, keys that
+ *              share their first 8 bytes and differ after, and bytes above
+ *              0x7F, so that lookups decided by prefix and by full key compare
+ *              are both checked across many node splits.
+ *              Prints one line per check and returns the number of failures.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include "BTreeDictionary.h"
+#include "KeyNormalizer.h"
+#include "TestReport.h"
+#include "WordPair.h"
+#include "ElementAlreadyExistsException.h"
+#include "ElementDoesNotExistException.h"
+#include "EmptyDataCollectionException.h"
+
+static TestReport report;
+
+// Description: Returns a random key: a short one, one of a few 8 byte stems with
+//              a random tail, or one with bytes above 0x7F.
+string randomKey(std::mt19937 & generator) {
+
+  const char * stems[] = { "translat", "translat", "abcdefgh", "\xC3\xA9t\xC3\xA9" "abcd" };
+  string key;
+  switch (generator() % 4) {
+     case 0:
+        key = string(1 + generator() % 7, 'a');
+        break;
+     case 1:
+        key = string(1 + generator() % 3, '\xC3');
+        break;
+     default:
+        key = stems[generator() % 4];
+  }
+  unsigned int tail = generator() % 4;
+  for (unsigned int i = 0; i < tail; i++) {
+     key += (char) ((generator() % 3 == 0) ? 0x80 + generator() % 0x80 : 'a' + generator() % 26);
+  }
+  for (char & byte : key) {
+     if (byte == 'a' && generator() % 2 == 0) {
+        byte = 'a' + generator() % 26;
+     }
+  }
+  return key;
+}
+
+// Description: Returns true if "myWords" holds exactly the content of "model", in key order.
+bool holdsExactly(const BTreeDictionary & myWords, const std::map<string, string> & model) {
+
+  if (myWords.getElementCount() != model.size()) {
+     return false;
+  }
+  bool passed = true;
+  auto next = model.begin();
+  myWords.displayContent([&passed, &next, &model](WordPair & anElement) {
+     if (next == model.end() || anElement.getEnglish() != next->first
+         || anElement.getTranslation() != next->second) {
+        passed = false;
+     }
+     else {
+        next++;
+     }
+  });
+  return passed && next == model.end();
+}
+
+// Description: Runs random puts, some of keys already put, and random gets,
+//              some of keys never put, checking each outcome against a model.
+void testAgainstModel() {
+
+  BTreeDictionary myWords;
+  std::map<string, string> model;
+  std::mt19937 generator(2023);
+  bool passed = (myWords.getHeight() == 0);
+  try {
+     WordPair query("food");
+     myWords.get(query);
+     passed = false;
+  }
+  catch (EmptyDataCollectionException& anException) { }
+
+  for (unsigned int step = 0; passed && step < 60000; step++) {
+     string english = randomKey(generator);
+     if (generator() % 2 == 0) {
+        WordPair aWord(english, "translation" + std::to_string(step));
+        bool expected = (model.find(english) == model.end());
+        try {
+           myWords.put(aWord);
+           passed = expected;
+           model[english] = aWord.getTranslation();
+        }
+        catch (ElementAlreadyExistsException& anException) {
+           passed = !expected;
+        }
+     }
+     else if (!model.empty()) {
+        auto found = model.find(english);
+        WordPair query(english);
+        try {
+           WordPair & translated = myWords.get(query);
+           passed = (found != model.end() && translated.getTranslation() == found->second);
+        }
+        catch (ElementDoesNotExistException& anException) {
+           passed = (found == model.end());
+        }
+     }
+  }
+  passed = passed && myWords.getHeight() > 2 && holdsExactly(myWords, model);
+  report.check("random puts and gets agree with a model", passed);
+}
+
+// Description: Puts keys in increasing, then decreasing order, which split the
+//              rightmost and leftmost nodes only, and checks the content.
+void testSortedPuts() {
+
+  BTreeDictionary increasing;
+  BTreeDictionary decreasing;
+  std::map<string, string> model;
+  const unsigned int wordCount = 5000;
+  for (unsigned int i = 0; i < wordCount; i++) {
+     string english = "translation" + std::to_string(100000 + i);
+     model[english] = std::to_string(i);
+     WordPair aWord(english, std::to_string(i));
+     increasing.put(aWord);
+     string reversed = "translation" + std::to_string(100000 + wordCount - 1 - i);
+     WordPair reversedWord(reversed, std::to_string(wordCount - 1 - i));
+     decreasing.put(reversedWord);
+  }
+  report.check("keys put in increasing and decreasing order",
+               holdsExactly(increasing, model) && holdsExactly(decreasing, model));
+}
+
+// Description: Checks that keys follow the normalization policy, and that a
+//              reference returned by get() stays valid across later puts.
+void testNormalizationAndReferences() {
+
+  BTreeDictionary myWords(KeyNormalizer::ALL);
+  WordPair cafe("Café", "kahvila");
+  myWords.put(cafe);
+  WordPair query("  CAFE ");
+  WordPair & found = myWords.get(query);
+  for (unsigned int i = 0; i < 1000; i++) {
+     WordPair aWord("word" + std::to_string(i), "translation");
+     myWords.put(aWord);
+  }
+  bool passed = found.getEnglish() == "Café" && found.getTranslation() == "kahvila";
+  try {
+     WordPair duplicate("cafe", "kafe");
+     myWords.put(duplicate);
+     passed = false;
+  }
+  catch (ElementAlreadyExistsException& anException) { }
+  report.check("normalized keys and references across puts", passed && myWords.getElementCount() == 1001);
+}
+
+int main() {
+
+  testAgainstModel();
+  testSortedPuts();
+  testNormalizationAndReferences();
+
+  return report.summarize();
+}
@@ -0,0 +1,135 @@
+/*
+ * BloomFilter.cpp
+ * 
+ * Description: Blocked Bloom filter over the keys of a Dictionary.
+ *              Answers "is this key possibly present?" without touching the
+ *              tree: a "no" is always right, a "yes" is wrong with a small,
+ *              configured probability (the false-positive rate).
+ *              All the bits of a key lie in one 64-byte block, so a query
+ *              costs one hash and one cache miss whatever the number of hashes.
+ *              The blocks are kept in a ChunkedArray, so a copy of the filter
+ *              (taken by a Dictionary put after a snapshot) shares them
+ *              until an insert writes to their chunk.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "BloomFilter.h"
+#include <cmath>
+
+/* Constructor */
+
+   // Description: Sizes the filter for "capacity" keys at "falsePositiveRate".
+   //              The optimal Bloom filter uses -ln(p) / ln(2)^2 bits and
+   //              ln(2) * bits hashes per key. Blocking raises the rate a
+   //              little, as some blocks get more than their share of keys,
+   //              which the extra 1/8 of bits makes up for.
+   BloomFilter::BloomFilter(unsigned int capacity, double falsePositiveRate)
+      : capacity(capacity), falsePositiveRate(falsePositiveRate) {
+
+      double bitsPerKey = -std::log(falsePositiveRate) / (std::log(2.0) * std::log(2.0));
+      double totalBits = bitsPerKey * 1.125 * (capacity > 0 ? capacity : 1);
+      blockCount = (uint32_t) std::ceil(totalBits / (BLOCK_WORDS * 64));
+      if (blockCount == 0) blockCount = 1;
+      hashCount = (unsigned int) std::lround(bitsPerKey * std::log(2.0));
+      if (hashCount < 1) hashCount = 1;
+      if (hashCount > 16) hashCount = 16;
+      bits.assign((size_t) blockCount * BLOCK_WORDS, 0);
+   }
+
+
+/* Filter operations */
+
+   // Description: Adds "key" to the filter, copying the chunk of its block
+   //              first if a copy of the filter shares it.
+   // Time efficiency: O(|key|), O(|key| + CHUNK_SIZE) when the chunk is copied
+   void BloomFilter::insert(const string & key) {
+
+      uint64_t h = hash(key);
+      //upper half picks the block; each probe within it takes 9 bits of a
+      //remix of the hash, as double hashing over 512 bits repeats too often
+      //a chunk holds whole blocks, so the words of the block follow its first one
+      uint64_t * block = &bits.modify(((h >> 32) * blockCount >> 32) * BLOCK_WORDS);
+      uint64_t probes = h;
+      for (unsigned int i = 0; i < hashCount; i++) {
+         if (i % 7 == 0) probes = (probes ^ (probes >> 31)) * 0x9e3779b97f4a7c15ULL;
+         uint32_t bit = (probes >> (64 - 9 * (i % 7 + 1))) & (BLOCK_WORDS * 64 - 1);
+         block[bit >> 6] |= (uint64_t) 1 << (bit & 63);
+      }
+      elementCount++;
+   }
+
+   // Description: Returns false if "key" was certainly never inserted.
+   // Time efficiency: O(|key|)
+   bool BloomFilter::mayContain(const string & key) const {
+
+      uint64_t h = hash(key);
+      const uint64_t * block = &bits[((h >> 32) * blockCount >> 32) * BLOCK_WORDS];
+      uint64_t probes = h;
+      for (unsigned int i = 0; i < hashCount; i++) {
+         if (i % 7 == 0) probes = (probes ^ (probes >> 31)) * 0x9e3779b97f4a7c15ULL;
+         uint32_t bit = (probes >> (64 - 9 * (i % 7 + 1))) & (BLOCK_WORDS * 64 - 1);
+         if ((block[bit >> 6] & ((uint64_t) 1 << (bit & 63))) == 0) {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   // Description: Returns a 64-bit hash of "key" (FNV-1a, then a final mix
+   //              so that short keys still spread over all 64 bits).
+   uint64_t BloomFilter::hash(const string & key) {
+
+      uint64_t h = 14695981039346656037ULL;
+      for (unsigned char c : key) {
+         h = (h ^ c) * 1099511628211ULL;
+      }
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      h *= 0xc4ceb9fe1a85ec53ULL;
+      h ^= h >> 33;
+      return h;
+   }
+
+
+/* Getters */
+
+   unsigned int BloomFilter::getElementCount() const {
+      return elementCount;
+   }
+
+   unsigned int BloomFilter::getCapacity() const {
+      return capacity;
+   }
+
+   unsigned int BloomFilter::getHashCount() const {
+      return hashCount;
+   }
+
+   double BloomFilter::getFalsePositiveRate() const {
+      return falsePositiveRate;
+   }
+
+   // Description: Returns the false-positive rate expected with the keys inserted so far.
+   //              A block holding j keys answers "yes" with probability
+   //              (1 - e^(-k j / 512))^k for k hashes; the keys per block
+   //              follow a Poisson distribution, over which this averages.
+   double BloomFilter::getExpectedFalsePositiveRate() const {
+
+      double keysPerBlock = (double) elementCount / blockCount;
+      double blockBits = BLOCK_WORDS * 64;
+      double rate = 0;
+      double probability = std::exp(-keysPerBlock);     // P(j = 0)
+      for (unsigned int j = 0; j < 4 * keysPerBlock + 64; j++) {
+         rate += probability * std::pow(1 - std::exp(-(double) hashCount * j / blockBits), hashCount);
+         probability *= keysPerBlock / (j + 1);
+      }
+      return rate;
+   }
+
+   // Description: Returns the number of bytes used by the filter.
+   size_t BloomFilter::getMemoryUsage() const {
+      return sizeof(*this) - sizeof(bits) + bits.getMemoryUsage();
+   }
@@ -0,0 +1,73 @@
+/*
+ * BloomFilter.h
+ * 
+ * Description: Blocked Bloom filter over the keys of a Dictionary.
+ *              Answers "is this key possibly present?" without touching the
+ *              tree: a "no" is always right, a "yes" is wrong with a small,
+ *              configured probability (the false-positive rate).
+ *              All the bits of a key lie in one 64-byte block, so a query
+ *              costs one hash and one cache miss whatever the number of hashes.
+ *              The blocks are kept in a ChunkedArray, so a copy of the filter
+ *              (taken by a Dictionary put after a snapshot) shares them
+ *              until an insert writes to their chunk.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+
+#include "ChunkedArray.h"
+#include <cstdint>
+#include <string>
+
+using std::string;
+
+class BloomFilter {
+
+private:
+
+   static const unsigned int BLOCK_WORDS = 8;     // 8 x 64 bits = one cache line
+
+   ChunkedArray<uint64_t> bits;                   // BLOCK_WORDS words per block, never split by a chunk
+   uint32_t blockCount = 1;
+   unsigned int hashCount = 1;
+   unsigned int capacity = 0;
+   unsigned int elementCount = 0;
+   double falsePositiveRate = 0;
+
+   // Description: Returns a 64-bit hash of "key".
+   static uint64_t hash(const string & key);
+
+public:
+
+   // Description: Sizes the filter so that, holding "capacity" keys, it answers
+   //              "possibly present" for an absent key with probability
+   //              "falsePositiveRate".
+   // Precondition: 0 < falsePositiveRate < 1.
+   BloomFilter(unsigned int capacity, double falsePositiveRate);
+
+   // Description: Adds "key" to the filter, copying the chunk of its block
+   //              first if a copy of the filter shares it.
+   // Time efficiency: O(|key|), O(|key| + CHUNK_SIZE) when the chunk is copied
+   void insert(const string & key);
+
+   // Description: Returns false if "key" was certainly never inserted.
+   // Time efficiency: O(|key|)
+   bool mayContain(const string & key) const;
+
+   // Getters
+   unsigned int getElementCount() const;
+   unsigned int getCapacity() const;
+   unsigned int getHashCount() const;
+   double getFalsePositiveRate() const;           // as configured, at capacity
+
+   // Description: Returns the false-positive rate expected with the keys inserted so far.
+   double getExpectedFalsePositiveRate() const;
+
+   // Description: Returns the number of bytes used by the filter.
+   size_t getMemoryUsage() const;
+
+}; // end BloomFilter
+#endif
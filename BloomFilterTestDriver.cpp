@@ -0,0 +1,141 @@
+/*
+ * BloomFilterTestDriver.cpp
+ *
+ * Description: Drives the testing of the BloomFilter class and of the filter
+ *              of a Dictionary. Every key inserted must be reported as maybe
+ *              present, also after the filter is outgrown and rebuilt and
+ *              across snapshots; keys never inserted must be reported as maybe
+ *              present at about the configured false-positive rate.
+ *              Prints one line per check and returns the number of failures.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "BloomFilter.h"
+#include "Dictionary.h"
+#include "TestReport.h"
+#include "WordPair.h"
+#include "ElementDoesNotExistException.h"
+
+using std::cout;
+using std::endl;
+using std::vector;
+
+// Keys probed for false positives in each test.
+static const unsigned int ABSENT_COUNT = 100000;
+
+static TestReport report;
+
+// Description: Returns the fraction of ABSENT_COUNT keys never inserted that
+//              "mayContain" reports as maybe present.
+template <typename Probe>
+double falsePositiveRate(Probe mayContain) {
+
+  unsigned int positives = 0;
+  for (unsigned int i = 0; i < ABSENT_COUNT; i++) {
+     if (mayContain("absent" + std::to_string(i))) {
+        positives++;
+     }
+  }
+  return positives / (double) ABSENT_COUNT;
+}
+
+// Description: Fills filters of several rates to capacity, checking that no key
+//              inserted is missed and that the rate of false positives is within
+//              twice the configured one.
+void testFilterAtCapacity() {
+
+  const double rates[] = { 0.1, 0.01, 0.001 };
+  const unsigned int capacity = 20000;
+  bool passed = true;
+  for (double rate : rates) {
+     BloomFilter filter(capacity, rate);
+     for (unsigned int i = 0; i < capacity; i++) {
+        filter.insert("word" + std::to_string(i));
+     }
+     for (unsigned int i = 0; passed && i < capacity; i++) {
+        passed = filter.mayContain("word" + std::to_string(i));
+     }
+     double measured = falsePositiveRate([&filter](const string & key) { return filter.mayContain(key); });
+     if (measured > 2 * rate) {
+        cout << "   " << measured << " false positives at a rate of " << rate << endl;
+        passed = false;
+     }
+     passed = passed && filter.getElementCount() == capacity && filter.getHashCount() > 0;
+  }
+  report.check("no false negatives, false positives near the configured rate", passed);
+}
+
+// Description: Puts into a Dictionary well past the capacity of its filter, so
+//              that it is rebuilt several times, and into a snapshot of it, and
+//              checks that each finds its own keys and the other's put after the
+//              snapshot are not found.
+void testDictionaryFilter() {
+
+  const unsigned int wordCount = 10000;
+  const double rate = 0.01;
+  Dictionary myWords;
+  myWords.enableBloomFilter(rate);
+  unsigned int firstCapacity = myWords.getBloomFilter()->getCapacity();
+  for (unsigned int i = 0; i < wordCount; i++) {
+     WordPair aWord("word" + std::to_string(i * 7919 % wordCount), "translation");
+     myWords.put(aWord);
+  }
+  Dictionary snapshot(myWords);
+  for (unsigned int i = 0; i < wordCount; i++) {
+     WordPair mine("mine" + std::to_string(i), "translation");
+     myWords.put(mine);
+     WordPair theirs("theirs" + std::to_string(i), "translation");
+     snapshot.put(theirs);
+  }
+
+  bool passed = myWords.getBloomFilter()->getCapacity() > firstCapacity;
+  for (unsigned int i = 0; passed && i < wordCount; i++) {
+     WordPair word("word" + std::to_string(i));
+     WordPair mine("mine" + std::to_string(i));
+     WordPair theirs("theirs" + std::to_string(i));
+     passed = myWords.mayContain(word) && myWords.mayContain(mine)
+              && snapshot.mayContain(word) && snapshot.mayContain(theirs);
+     try {
+        passed = passed && myWords.get(mine).getEnglish() == mine.getEnglish()
+                 && snapshot.get(theirs).getEnglish() == theirs.getEnglish();
+     }
+     catch (ElementDoesNotExistException& anException) {
+        passed = false;
+     }
+  }
+  double measured = falsePositiveRate([&myWords](const string & key) { return myWords.mayContain(WordPair(key)); });
+  passed = passed && measured <= 2 * rate;
+  passed = passed && myWords.getBloomFilter()->getElementCount() == myWords.getElementCount();
+  report.check("no false negatives through a Dictionary, its rebuilds and snapshots", passed);
+}
+
+// Description: Checks that rates outside ]0, 1[ are refused.
+void testInvalidRates() {
+
+  Dictionary myWords;
+  bool passed = true;
+  const double rates[] = { 0, 1, -0.5, 2 };
+  for (double rate : rates) {
+     try {
+        myWords.enableBloomFilter(rate);
+        passed = false;
+     }
+     catch (std::logic_error& anException) { }
+  }
+  report.check("false-positive rates outside ]0, 1[", passed && myWords.getBloomFilter() == nullptr);
+}
+
+int main() {
+
+  testFilterAtCapacity();
+  testDictionaryFilter();
+  testInvalidRates();
+
+  return report.summarize();
+}
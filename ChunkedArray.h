@@ -0,0 +1,109 @@
+/*
+ * ChunkedArray.h
+ *
+ * Description: Array split into chunks of CHUNK_SIZE elements, each held by a
+ *              shared_ptr, for the indexes of a Dictionary. Copying the array
+ *              copies only the chunk pointers, so a copy shares every chunk
+ *              with the original; a chunk is copied the first time either one
+ *              writes to it while the other still holds it (copy on write).
+ *              The first put into a Dictionary after a snapshot thus copies
+ *              the chunk table and the chunks it writes to, not whole indexes.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef CHUNKED_ARRAY_H
+#define CHUNKED_ARRAY_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+template <typename T>
+class ChunkedArray {
+
+public:
+
+   // Elements per chunk: a power of 2, so that a position splits with a shift
+   // and a mask, and a multiple of every group of elements that must stay
+   // contiguous (a Bloom filter block).
+   static const size_t CHUNK_SIZE = 512;
+
+private:
+
+   std::vector< std::shared_ptr< std::vector<T> > > chunks;
+   size_t elementCount = 0;
+
+   // Description: Returns chunk "chunk", copied first if another array shares it.
+   std::vector<T> & unshare(size_t chunk) {
+      if (chunks[chunk].use_count() > 1) {
+         chunks[chunk] = std::make_shared< std::vector<T> >(*chunks[chunk]);
+      }
+      else {
+         //use_count() is a relaxed load: the fence orders the writes to come after
+         //the reads of an array on another thread that has just let go of the chunk
+         std::atomic_thread_fence(std::memory_order_acquire);
+      }
+      return *chunks[chunk];
+   }
+
+public:
+
+   // Description: Returns the number of elements.
+   size_t size() const {
+      return elementCount;
+   }
+
+   bool empty() const {
+      return elementCount == 0;
+   }
+
+   // Description: Makes the array "count" copies of "value", in chunks of its own.
+   // Time efficiency: O(count)
+   void assign(size_t count, const T & value) {
+      chunks.clear();
+      for (size_t start = 0; start < count; start += CHUNK_SIZE) {
+         size_t length = (count - start < CHUNK_SIZE) ? count - start : CHUNK_SIZE;
+         chunks.push_back(std::make_shared< std::vector<T> >(length, value));
+      }
+      elementCount = count;
+   }
+
+   // Description: Returns element "position", for reading.
+   // Precondition: position < size().
+   // Time efficiency: O(1)
+   const T & operator[](size_t position) const {
+      return (*chunks[position / CHUNK_SIZE])[position % CHUNK_SIZE];
+   }
+
+   // Description: Returns element "position", for writing: its chunk is copied
+   //              first if another array shares it. Elements of the same chunk
+   //              lie next to each other, so the reference may be used as a
+   //              pointer into the chunk.
+   // Precondition: position < size().
+   // Time efficiency: O(1), O(CHUNK_SIZE) when the chunk is copied
+   T & modify(size_t position) {
+      return unshare(position / CHUNK_SIZE)[position % CHUNK_SIZE];
+   }
+
+   // Description: Appends "value".
+   // Time efficiency: O(1) amortized, O(CHUNK_SIZE) when the last chunk is copied
+   void push_back(const T & value) {
+      if (elementCount % CHUNK_SIZE == 0) {
+         chunks.push_back(std::make_shared< std::vector<T> >());
+         chunks.back()->reserve(CHUNK_SIZE);
+      }
+      unshare(chunks.size() - 1).push_back(value);
+      elementCount++;
+   }
+
+   // Description: Returns the number of bytes of the chunks, counting shared chunks too.
+   size_t getMemoryUsage() const {
+      return sizeof(*this) + chunks.capacity() * sizeof(chunks[0])
+           + chunks.size() * (sizeof(std::vector<T>) + CHUNK_SIZE * sizeof(T));
+   }
+
+}; // end ChunkedArray
+#endif
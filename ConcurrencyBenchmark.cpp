@@ -0,0 +1,133 @@
+/*
+ * ConcurrencyBenchmark.cpp
+ * 
+ * Description: Compares multi-threaded put and get throughput of a
+ *              mutex-protected Dictionary (BST), a ShardedDictionary and a
+ *              lock-free SkipListDictionary.
+ *
+ *              Usage: bench-concurrent [words] [threads ...]
+ *              Defaults: 200000 words, 1 2 4 8 16 32 threads.
+ *
+ * Author: Aidan de Vaal
+ * Last Modification Date: Nov. 3, 2023
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Dictionary.h"
+#include "ShardedDictionary.h"
+#include "SkipListDictionary.h"
+
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+// Dictionary behind one mutex - what every writer would contend on without sharding.
+class LockedDictionary {
+  private:
+     Dictionary words;
+     mutable std::mutex lock;
+  public:
+     void put(WordPair & newElement) {
+        std::lock_guard<std::mutex> guard(lock);
+        words.put(newElement);
+     }
+     WordPair & get(WordPair & targetElement) const {
+        std::lock_guard<std::mutex> guard(lock);
+        return words.get(targetElement);
+     }
+};
+
+// Description: Returns "count" distinct random lower case words.
+vector<string> makeWords(unsigned int count) {
+
+  std::mt19937 random(42);
+  vector<string> words;
+  words.reserve(count);
+  for (unsigned int i = 0; i < count; i++) {
+     string word = std::to_string(i);
+     unsigned int length = 4 + random() % 8;
+     while (word.size() < length) {
+        word += (char) ('a' + random() % 26);
+     }
+     words.push_back(word);
+  }
+  std::shuffle(words.begin(), words.end(), random);
+  return words;
+}
+
+// Description: Runs "work(thread, threads)" on "threads" threads and returns the elapsed seconds.
+template <class Work>
+double timeThreads(unsigned int threads, Work work) {
+
+  auto start = std::chrono::steady_clock::now();
+  vector<std::thread> workers;
+  for (unsigned int t = 0; t < threads; t++) {
+     workers.emplace_back(work, t, threads);
+  }
+  for (std::thread & worker : workers) {
+     worker.join();
+  }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Description: Puts every word from "threads" threads, then gets every word
+//              from "threads" threads, and prints both throughputs.
+template <class Target>
+void run(const string & name, Target & target, const vector<string> & words, unsigned int threads) {
+
+  double putSeconds = timeThreads(threads, [&](unsigned int t, unsigned int n) {
+     for (size_t i = t; i < words.size(); i += n) {
+        WordPair nextWordPair(words[i], "x");
+        target.put(nextWordPair);
+     }
+  });
+  double getSeconds = timeThreads(threads, [&](unsigned int t, unsigned int n) {
+     for (size_t i = t; i < words.size(); i += n) {
+        WordPair nextWordPair(words[(i * 7919) % words.size()]);
+        target.get(nextWordPair);
+     }
+  });
+  cout << std::setw(10) << name << std::setw(9) << threads
+       << std::setw(14) << (unsigned long) (words.size() / putSeconds)
+       << std::setw(14) << (unsigned long) (words.size() / getSeconds) << endl;
+}
+
+int main(int argc, char *argv[]) {
+
+  unsigned int count = (argc > 1) ? atoi(argv[1]) : 200000;
+  vector<unsigned int> threadCounts;
+  for (int i = 2; i < argc; i++) {
+     threadCounts.push_back(atoi(argv[i]));
+  }
+  if (threadCounts.empty()) {
+     threadCounts = {1, 2, 4, 8, 16, 32};
+  }
+  vector<string> words = makeWords(count);
+
+  cout << "   backend  threads      puts/s        gets/s" << endl;
+  for (unsigned int threads : threadCounts) {
+     {
+        LockedDictionary locked;
+        run("mutex BST", locked, words, threads);
+     }
+     {
+        ShardedDictionary sharded(64);
+        run("sharded", sharded, words, threads);
+     }
+     {
+        SkipListDictionary skipList;
+        run("skip list", skipList, words, threads);
+     }
+  }
+  return 0;
+}
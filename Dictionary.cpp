@@ -4,6 +4,10 @@
  * Description: Dictonary data collection ADT class.
  *              BST-based implementation.
  *              Duplicated elements not allowed.
+ *              Copies share their content with the original (copy-on-write),
+ *              so taking a snapshot of a Dictionary is O(1).
+ *              An optional normalization policy (case, whitespace, accents)
+ *              makes lookups match regardless of those differences.
  * 
  * Author: Aidan de Vaal
  * Date of last modification: Nov. 3, 2023
@@ -12,7 +16,26 @@
 #include "BST.h"
 #include "Dictionary.h"
 #include "WordPair.h"
+#include "WorkStealingPool.h"
+#include <atomic>
 #include <iostream>
+#include <memory>
+#include <sstream>
+
+// Description: Makes "index" this Dictionary's own before it is written to,
+//              copying it first if a snapshot still shares it.
+template <typename Index>
+static void unshare(std::shared_ptr<Index> & index) {
+
+   if (index.use_count() > 1) {
+      index = std::make_shared<Index>(*index);
+   }
+   else {
+      //use_count() is a relaxed load: the fence orders the writes to come after
+      //the reads of a snapshot on another thread that has just let go of the index
+      std::atomic_thread_fence(std::memory_order_acquire);
+   }
+}
 
 // You cannot change the prototype of the public methods of this class.
 // Remember, if you add public methods to this class, our test driver 
@@ -27,12 +50,33 @@
       keyValuePairs = new BST();
    }            
 
+   // Copy constructor
+   // Time efficiency: O(1)
+   Dictionary::Dictionary(const Dictionary & aDict)
+      : normalizer(aDict.normalizer), suggestions(aDict.suggestions), filter(aDict.filter),
+        reverseIndex(aDict.reverseIndex), countAccesses(aDict.countAccesses) {
+      //share aDict's BST nodes, they are copied lazily on put
+      keyValuePairs = new BST(*aDict.keyValuePairs);
+   }
+
    // Destructor 
    Dictionary::~Dictionary() {
-      //call helper recursive delete function
-      deleteDictionary(keyValuePairs->root);
-      // to do
+      //BST destructor releases the nodes this Dictionary no longer shares
+      delete keyValuePairs;
+      keyValuePairs = nullptr;
    }                
+
+   // Description: Makes this Dictionary share the content of "rhs".
+   // Time efficiency: O(1), plus the cost of releasing the previous content.
+   Dictionary & Dictionary::operator=(const Dictionary & rhs) {
+      *keyValuePairs = *rhs.keyValuePairs;
+      normalizer = rhs.normalizer;
+      suggestions = rhs.suggestions;
+      filter = rhs.filter;
+      reverseIndex = rhs.reverseIndex;
+      countAccesses = rhs.countAccesses;
+      return *this;
+   }
    
    
 /* Getters and setters */
@@ -55,26 +99,53 @@
    //            if "newElement" already exists in the Dictionary.   
    void Dictionary::put(WordPair & newElement) {
       
-      //allocate space for newElement
-      BSTNode * newNode = new BSTNode(newElement);
-      //set children to null since it's being added and set element member
-      newNode->left = nullptr; newNode->right = nullptr; newNode->element = newElement;
-
-      //new failed throw exception
-      if(newNode == nullptr){
-         throw UnableToInsertException("'new' operator failed.");
-      }
-      //first element, set it to Dictionary's BST root and increment elementCount
-      else if(keyValuePairs->elementCount == 0){
-         keyValuePairs->root = newNode;
-         keyValuePairs->elementCount++;
-         return;
+      WordPair * stored = &newElement;
+      WordPair keyed;
+      if (!normalizer.isIdentity()) {
+         //the normalized key is computed once here and stored with the element
+         keyed = newElement;
+         keyed.setKey(normalizer.normalize(newElement.getEnglish()));
+         stored = &keyed;
+      }
+      //BST insert copies the nodes it touches that are shared with snapshots
+      if (!reverseIndex) {
+         keyValuePairs->insert(*stored);
+      }
+      else {
+         //the index follows the copies, made even if nothing ends up inserted;
+         //all it needs is reserved first, so that following them cannot fail
+         //once the tree has changed, whatever the insertion throws
+         unshare(reverseIndex);
+         std::vector<const BSTNode *> path = keyValuePairs->findPath(*stored);
+         ReverseIndex::Reservation reservation = reverseIndex->reserve(path, *stored);
+         std::vector<std::pair<BSTNode *, BSTNode *> > copies;
+         copies.reserve(path.size());
+         try {
+            BSTNode * added = keyValuePairs->insert(*stored, &copies);
+            updateReverseIndex(copies, added, reservation);
+         }
+         catch (...) {
+            updateReverseIndex(copies, nullptr, reservation);
+            throw;
+         }
       }
-      //if element already exists throw exception, otherwise insert recursively
-      if(!keyValuePairs->insertR(newNode, keyValuePairs->root)){
-         throw(ElementAlreadyExistsException("Element already exists."));
+
+      if (suggestions) {
+         //like the BST, the index is only copied if a snapshot still shares it
+         unshare(suggestions);
+         suggestions->insert(stored->getKey(), stored->getEnglish());
+      }
+
+      if (filter) {
+         if (filter->getElementCount() >= filter->getCapacity()) {
+            //outgrown: a fuller filter would drift above its false-positive rate
+            rebuildFilter(2 * filter->getCapacity(), filter->getFalsePositiveRate());
+         }
+         else {
+            unshare(filter);
+            filter->insert(stored->getKey());
+         }
       }
-      // to do
    } 
 
    // Description: Gets "newElement" (i.e., the associated value of a given key) 
@@ -89,10 +160,25 @@
      if (keyValuePairs->elementCount == 0)  
         throw EmptyDataCollectionException("Binary search tree is empty.");
 
-      //calls recursive retrieve BST function from Dictionary's BST and saves return to translated
-     WordPair& translated = keyValuePairs->retrieveR(targetElement, keyValuePairs->root);
-	 
-     return translated;
+     if (normalizer.isIdentity() && !countAccesses) {
+        //most absent keys stop at the filter, before the descent
+        if (filter && !filter->mayContain(targetElement.getKey()))
+           throw ElementDoesNotExistException("***Not Found!***");
+        //calls recursive retrieve BST function from Dictionary's BST
+        return keyValuePairs->retrieveR(targetElement, keyValuePairs->root);
+     }
+     //normalize the query once, the descent then only compares keys
+     WordPair query = makeQuery(targetElement);
+     if (filter && !filter->mayContain(query.getKey()))
+        throw ElementDoesNotExistException("***Not Found!***");
+     if (!countAccesses) {
+        return keyValuePairs->retrieveR(query, keyValuePairs->root);
+     }
+     BSTNode * found = keyValuePairs->findNode(query);
+     if (found == nullptr)
+        throw ElementDoesNotExistException("***Not Found!***");
+     found->accessCount.fetch_add(1, std::memory_order_relaxed);
+     return found->element;
    }
    
    // Description: Prints the content of the Dictionary.
@@ -109,20 +195,307 @@
      
      return;
    }
+   // Description: Same as above, for a "visit" that carries state (e.g. a capturing lambda).
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   void Dictionary::displayContent(const std::function<void(WordPair &)> & visit) const {
+     keyValuePairs->traverseInOrder(visit);
+   }
+
+   // Description: Returns the number of elements whose key comes before the key
+   //              of "targetElement".
+   // Time efficiency: O(height)
+   unsigned int Dictionary::rank(const WordPair & targetElement) const {
+      return keyValuePairs->rank(makeQuery(targetElement));
+   }
+
+   // Description: Returns the element at position "position" in key order.
+   // Exception: Throws the exception ElementDoesNotExistException
+   //            if "position" is not less than the number of elements.
+   // Time efficiency: O(height)
+   WordPair & Dictionary::select(unsigned int position) const {
+      return keyValuePairs->select(position);
+   }
+
+   // Description: Returns the number of elements whose key lies between the keys
+   //              of "low" and "high", both included.
+   // Time efficiency: O(height)
+   unsigned int Dictionary::countRange(const WordPair & low, const WordPair & high) const {
+
+      WordPair lowQuery = makeQuery(low);
+      WordPair highQuery = makeQuery(high);
+      if (highQuery < lowQuery) {
+         return 0;
+      }
+      return keyValuePairs->rank(highQuery, true) - keyValuePairs->rank(lowQuery);
+   }
+
+   // Description: Visits every element, on "threads" threads, in no particular order.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Time efficiency: O(n / threads + chunks * log2 n)
+   void Dictionary::displayContentParallel(const std::function<void(WordPair &)> & visit,
+                                           unsigned int threads) const {
+
+      if (keyValuePairs->elementCount == 0)
+         throw EmptyDataCollectionException("Binary search tree is empty.");
+
+      WorkStealingPool pool(threads);
+      std::vector<std::pair<unsigned int, unsigned int> > chunks = makeChunks(pool.getThreadCount());
+      std::vector<std::function<void()> > tasks;
+      for (const auto & chunk : chunks) {
+         tasks.push_back([this, &visit, chunk]() {
+            keyValuePairs->traverseRange(chunk.first, chunk.second, visit);
+         });
+      }
+      pool.run(tasks);
+   }
+
+   // Description: Writes every element to "out", one "english:translation" line each,
+   //              in key order, formatting chunks in parallel.
+   // Time efficiency: O(n / threads + chunks * log2 n), plus the writing itself.
+   void Dictionary::exportContent(std::ostream & out, unsigned int threads) const {
+
+      if (keyValuePairs->elementCount == 0) {
+         return;
+      }
+      WorkStealingPool pool(threads);
+      std::vector<std::pair<unsigned int, unsigned int> > chunks = makeChunks(pool.getThreadCount());
+      //one buffer per chunk, so that workers never share one
+      std::vector<string> buffers(chunks.size());
+      std::vector<std::function<void()> > tasks;
+      for (unsigned int i = 0; i < chunks.size(); i++) {
+         tasks.push_back([this, &chunks, &buffers, i]() {
+            std::ostringstream buffer;
+            keyValuePairs->traverseRange(chunks[i].first, chunks[i].second, [&buffer](WordPair & element) {
+               buffer << element.getEnglish() << ':' << element.getTranslation() << '\n';
+            });
+            buffers[i] = buffer.str();
+         });
+      }
+      pool.run(tasks);
+      for (string & buffer : buffers) {
+         out.write(buffer.data(), buffer.size());
+         string().swap(buffer);
+      }
+   }
+
+   // Description: Splits the positions of the elements into (offset, count) chunks,
+   //              several per thread so that stealing can even out the work.
+   std::vector<std::pair<unsigned int, unsigned int> > Dictionary::makeChunks(unsigned int threads) const {
+
+      const unsigned int MIN_CHUNK = 1024;
+      unsigned int n = keyValuePairs->elementCount;
+      unsigned int chunkCount = threads * 8;
+      if (chunkCount > (n + MIN_CHUNK - 1) / MIN_CHUNK) {
+         chunkCount = (n + MIN_CHUNK - 1) / MIN_CHUNK;
+      }
+      if (chunkCount == 0) {
+         chunkCount = 1;
+      }
+      std::vector<std::pair<unsigned int, unsigned int> > chunks;
+      for (unsigned int c = 0; c < chunkCount; c++) {
+         unsigned int first = (unsigned long long) n * c / chunkCount;
+         unsigned int last = (unsigned long long) n * (c + 1) / chunkCount;
+         chunks.push_back(std::make_pair(first, last - first));
+      }
+      return chunks;
+   }
+
+   // Description: Visits, in key order, the "count" elements starting at position "offset".
+   // Time efficiency: O(height + count)
+   void Dictionary::displayPage(unsigned int offset, unsigned int count,
+                                const std::function<void(WordPair &)> & visit) const {
+      keyValuePairs->traverseRange(offset, count, visit);
+   }
+
+   // Description: Makes every later get() that finds its element count it.
+   void Dictionary::enableAccessCounts() {
+      countAccesses = true;
+   }
+
+   // Description: Stops get() from counting; the counts gathered so far are kept.
+   void Dictionary::disableAccessCounts() {
+      countAccesses = false;
+   }
+
+   // Description: Rebuilds the tree from the counted accesses so that the words
+   //              looked up most often sit nearest the root.
+   // Exception: Throws the exception "UnableToInsertException" if memory ran out.
+   // Time efficiency: O(n log2 n)
+   void Dictionary::rebuildForAccesses() {
+      //the suggestion index and Bloom filter hold keys, not nodes, so they are kept
+      keyValuePairs->rebuildByAccessCounts();
+      if (reverseIndex) {
+         rebuildReverseIndex();
+      }
+   }
 
-   // Description: Helper function to destruct Dictionary.
-   // Precondition: Dictionary keyValuePairs has been initialized.
-   // Time Efficiency: O(n)
-   void Dictionary::deleteDictionary(BSTNode * node){
-      //while there's a node, post-order traverse
-      if(node!=nullptr){
-         //delete left child elements
-         deleteDictionary(node->left);
-         //delete right child elements
-         deleteDictionary(node->right);
-         //delete roots
-         delete node;
-      }
-      //set root to nullptr
-      keyValuePairs->root = nullptr;
-   }
\ No newline at end of file
+   // Description: Returns the average number of key comparisons that the counted
+   //              lookups take in the current tree.
+   // Time efficiency: O(n)
+   double Dictionary::getAverageAccessComparisons() const {
+      return keyValuePairs->getAverageAccessComparisons();
+   }
+
+   // Description: Builds the "did you mean" index over the current keys.
+   // Time efficiency: O(n * depth * |key|^2)
+   void Dictionary::enableSuggestions() {
+
+      std::shared_ptr<SuggestionIndex> index = std::make_shared<SuggestionIndex>();
+      if (keyValuePairs->elementCount != 0) {
+         keyValuePairs->traverseInOrder([&index](WordPair & element) {
+            index->insert(element.getKey(), element.getEnglish());
+         });
+      }
+      suggestions = index;
+   }
+
+   // Description: Returns true if enableSuggestions() was called.
+   bool Dictionary::hasSuggestions() const {
+      return suggestions != nullptr;
+   }
+
+   // Description: Returns the English words of at most "k" elements whose key is
+   //              within edit distance "maxDistance" of the key of "targetElement".
+   std::vector<string> Dictionary::suggest(const WordPair & targetElement, unsigned int k,
+                                           unsigned int maxDistance) const {
+      if (!suggestions) {
+         return std::vector<string>();
+      }
+      return suggestions->suggest(makeQuery(targetElement).getKey(), k, maxDistance);
+   }
+
+   // Description: Builds the translation-to-English index over the current elements.
+   // Time efficiency: O(n)
+   void Dictionary::enableReverseIndex() {
+      rebuildReverseIndex();
+   }
+
+   // Description: Returns true if enableReverseIndex() was called.
+   bool Dictionary::hasReverseIndex() const {
+      return reverseIndex != nullptr;
+   }
+
+   // Description: Returns, in key order, the elements whose translation matches "translation".
+   // Time efficiency: O(1) expected, plus the number of elements found
+   std::vector<WordPair> Dictionary::getByTranslation(const string & translation) const {
+      if (!reverseIndex) {
+         return std::vector<WordPair>();
+      }
+      return reverseIndex->find(translation);
+   }
+
+   // Description: Builds a Bloom filter over the current keys.
+   // Exception: Throws the exception logic_error if "falsePositiveRate" is out of range.
+   // Time efficiency: O(n)
+   void Dictionary::enableBloomFilter(double falsePositiveRate) {
+
+      if (!(falsePositiveRate > 0 && falsePositiveRate < 1))
+         throw std::logic_error("Bloom filter false-positive rate must be between 0 and 1.");
+      //room to grow before the first resize
+      unsigned int capacity = keyValuePairs->elementCount < 512 ? 1024 : 2 * keyValuePairs->elementCount;
+      rebuildFilter(capacity, falsePositiveRate);
+   }
+
+   // Description: Returns the Bloom filter, or nullptr if enableBloomFilter() was not called.
+   const BloomFilter * Dictionary::getBloomFilter() const {
+      return filter.get();
+   }
+
+   // Description: Returns false if "targetElement" is certainly not in the Dictionary.
+   // Time efficiency: O(|key|) with a Bloom filter, O(log2 n) when it cannot decide.
+   bool Dictionary::mayContain(const WordPair & targetElement) const {
+
+      if (keyValuePairs->elementCount == 0) {
+         return false;
+      }
+      if (filter && normalizer.isIdentity()) {
+         return filter->mayContain(targetElement.getKey());
+      }
+      WordPair query = makeQuery(targetElement);
+      if (filter) {
+         return filter->mayContain(query.getKey());
+      }
+      try {
+         keyValuePairs->retrieveR(query, keyValuePairs->root);
+         return true;
+      }
+      catch (ElementDoesNotExistException & anException) {
+         return false;
+      }
+   }
+
+   // Description: Replaces the filter by one sized for "capacity" keys at
+   //              "falsePositiveRate", holding the current keys.
+   // Time efficiency: O(n)
+   void Dictionary::rebuildFilter(unsigned int capacity, double falsePositiveRate) {
+
+      std::shared_ptr<BloomFilter> rebuilt = std::make_shared<BloomFilter>(capacity, falsePositiveRate);
+      if (keyValuePairs->elementCount != 0) {
+         keyValuePairs->traverseInOrder([&rebuilt](WordPair & element) {
+            rebuilt->insert(element.getKey());
+         });
+      }
+      filter = rebuilt;
+   }
+
+   // Description: Points the reverse index at the copies a put made of shared
+   //              nodes, and adds the node it inserted, if not null.
+   // Precondition: "reservation" was made by the reverse index for this put.
+   // Time efficiency: O(number of copies * height)
+   void Dictionary::updateReverseIndex(const std::vector<std::pair<BSTNode *, BSTNode *> > & copies,
+                                       BSTNode * added, const ReverseIndex::Reservation & reservation) noexcept {
+
+      for (const auto & copy : copies) {
+         reverseIndex->replace(copy.first, copy.second, reservation);
+      }
+      if (added != nullptr) {
+         reverseIndex->insert(added, reservation);
+      }
+   }
+
+   // Description: Replaces the reverse index by one built from the current nodes.
+   // Time efficiency: O(n)
+   void Dictionary::rebuildReverseIndex() {
+
+      std::shared_ptr<ReverseIndex> index =
+         std::make_shared<ReverseIndex>(normalizer.getPolicy(), keyValuePairs->elementCount);
+      std::vector<BSTNode *> nodes;
+      nodes.reserve(keyValuePairs->elementCount);
+      BST::collectInOrderR(keyValuePairs->root, nodes);
+      for (BSTNode * node : nodes) {
+         index->insert(node);
+      }
+      reverseIndex = index;
+   }
+
+   // Description: Returns "query" with its key normalized by the Dictionary's policy.
+   WordPair Dictionary::makeQuery(const WordPair & targetElement) const {
+
+      if (normalizer.isIdentity()) {
+         return targetElement;
+      }
+      WordPair query;
+      query.setKey(normalizer.normalize(targetElement.getEnglish()));
+      return query;
+   }
+
+   // Description: Sets the normalization policy (KeyNormalizer flags) of the keys.
+   // Precondition: Dictionary is empty.
+   // Exception: Throws the exception logic_error if the Dictionary is not empty.
+   void Dictionary::setNormalization(unsigned int policy) {
+
+      //existing keys were ordered (and indexed) under the previous policy
+      if (keyValuePairs->elementCount != 0)
+         throw std::logic_error("Normalization can only be set on an empty Dictionary.");
+      //the reverse index normalizes translations by the policy too: the Dictionary
+      //being empty, an empty index under the new policy replaces it
+      if (reverseIndex) {
+         reverseIndex = std::make_shared<ReverseIndex>(policy);
+      }
+      normalizer = KeyNormalizer(policy);
+   }
+
+   // Description: Returns the normalization policy (KeyNormalizer flags) of the keys.
+   unsigned int Dictionary::getNormalization() const {
+      return normalizer.getPolicy();
+   }
@@ -4,6 +4,10 @@
  * Description: Dictonary data collection ADT class.
  *              BST-based implementation.
  *              Duplicated elements not allowed.
+ *              Copies share their content with the original (copy-on-write),
+ *              so taking a snapshot of a Dictionary is O(1).
+ *              An optional normalization policy (case, whitespace, accents)
+ *              makes lookups match regardless of those differences.
  *              
  * Author: Aidan de Vaal
  * Date of last modification: Nov. 3, 2023
@@ -13,7 +17,14 @@
 #define DICTIONARY_H
 
 #include "BST.h"
+#include "BloomFilter.h"
+#include "KeyNormalizer.h"
+#include "ReverseIndex.h"
+#include "SuggestionIndex.h"
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 class Dictionary {
    
@@ -22,8 +33,49 @@ private:
 /* You cannot change the following data member of this class. */
     BST * keyValuePairs = nullptr;                  
 
+    // Applied once to each key on put and to each query on get.
+    KeyNormalizer normalizer;
+
+    // "Did you mean" index, null unless enableSuggestions() was called.
+    // Shared with snapshots and copied before a put modifies it; the copy
+    // shares the nodes in chunks, so it costs O(n / CHUNK_SIZE), not O(n).
+    std::shared_ptr<SuggestionIndex> suggestions;
+
+    // Filter of the keys, null unless enableBloomFilter() was called.
+    // Shared with snapshots and copied before a put modifies it; the copy
+    // shares the bits in chunks, like the suggestion index.
+    std::shared_ptr<BloomFilter> filter;
+
+    // Translation-to-English index, null unless enableReverseIndex() was called.
+    // Its slots point at this Dictionary's nodes; shared with snapshots and
+    // copied before a put modifies it, in chunks like the suggestion index.
+    std::shared_ptr<ReverseIndex> reverseIndex;
+
+    // True once enableAccessCounts() was called: each get() that finds its
+    // element then counts it, for rebuildForAccesses().
+    bool countAccesses = false;
+
+    // Description: Replaces the filter by one sized for "capacity" keys at
+    //              "falsePositiveRate", holding the current keys.
+    void rebuildFilter(unsigned int capacity, double falsePositiveRate);
+
+    // Description: Points the reverse index at the copies a put made of shared
+    //              nodes (node, copy), and adds the node it inserted, if not null.
+    //              Writes only the slots "reservation" readied, so it cannot fail.
+    void updateReverseIndex(const std::vector<std::pair<BSTNode *, BSTNode *> > & copies,
+                            BSTNode * added, const ReverseIndex::Reservation & reservation) noexcept;
+
+    // Description: Replaces the reverse index by one built from the current nodes.
+    void rebuildReverseIndex();
+
+    // Description: Returns "query" with its key normalized by the Dictionary's policy.
+    WordPair makeQuery(const WordPair & targetElement) const;
+
+    // Description: Splits the positions of the elements into (offset, count) chunks
+    //              for a parallel traversal on "threads" threads.
+    std::vector<std::pair<unsigned int, unsigned int> > makeChunks(unsigned int threads) const;
+
 /* Feel free to add private methods to this class. */
-    void deleteDictionary(BSTNode * root);
    
 public:
 
@@ -34,7 +86,12 @@ public:
 
    // Constructors and destructor:
    Dictionary();                             // Default constructor
+   Dictionary(const Dictionary & aDict);     // Copy constructor - O(1) snapshot
    ~Dictionary();                            // Destructor 
+
+   // Description: Makes this Dictionary share the content of "rhs" - O(1) snapshot.
+   //              Later puts into either Dictionary do not affect the other.
+   Dictionary & operator=(const Dictionary & rhs);
    
    // Dictionary operations
    
@@ -48,6 +105,9 @@ public:
    //            when newElement cannot be inserted in the Dictionary.  
    // Exception: Throws the exception "ElementAlreadyExistsException" 
    //            if "newElement" already exists in the Dictionary.  
+   // Time efficiency: O(log2 n) descents; the first put after a snapshot also
+   //                  copies the chunk tables of the indexes it shares with the
+   //                  snapshot, O(n / CHUNK_SIZE), and each chunk it writes to.
    void put(WordPair & newElement);
  
    // Description: Gets "newElement" (i.e., the associated value of a given key) 
@@ -56,12 +116,154 @@ public:
    // Exception: Throws the exception ElementDoesNotExistException
    //            if the key is not found in the Dictionary.
    // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Note: The returned element may be shared with snapshots of this Dictionary,
+   //       so it must not be modified through the returned reference.
+   //       With access counts enabled, the node found is counted, even when a
+   //       snapshot shares it (see enableAccessCounts()).
    WordPair & get(WordPair & targetElement) const;
 
+   // Description: Sets the normalization policy (KeyNormalizer flags) of the keys.
+   //              Each element put is then compared by the normalized form of
+   //              its English word, computed once, and each get normalizes its
+   //              query the same way. Elements keep their original English word.
+   //              A reverse index, if enabled, then matches translations under
+   //              the new policy as well.
+   // Precondition: Dictionary is empty.
+   // Exception: Throws the exception logic_error if the Dictionary is not empty.
+   void setNormalization(unsigned int policy);
+
+   // Description: Returns the normalization policy (KeyNormalizer flags) of the keys.
+   unsigned int getNormalization() const;
+
    // Description: Prints the content of the Dictionary.
    // Precondition: Dictionary is not empty.
    // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
    void displayContent(void visit(WordPair &)) const;
+
+   // Description: Same as above, for a "visit" that carries state (e.g. a capturing lambda).
+   void displayContent(const std::function<void(WordPair &)> & visit) const;
+
+   // Description: Returns the number of elements whose key comes before the key
+   //              of "targetElement", i.e. its position if it is in the Dictionary.
+   //              The tree is not rebalanced on put, so its height is log2 n for
+   //              keys put in random order but up to n for keys put in order.
+   // Time efficiency: O(height)
+   unsigned int rank(const WordPair & targetElement) const;
+
+   // Description: Returns the element at position "position" in key order (0 is the first).
+   // Exception: Throws the exception ElementDoesNotExistException
+   //            if "position" is not less than the number of elements.
+   // Note: As with get, the element must not be modified through the returned reference.
+   // Time efficiency: O(height)
+   WordPair & select(unsigned int position) const;
+
+   // Description: Returns the number of elements whose key lies between the keys
+   //              of "low" and "high", both included. Neither needs to be in the Dictionary.
+   // Time efficiency: O(height)
+   unsigned int countRange(const WordPair & low, const WordPair & high) const;
+
+   // Description: Visits every element, on "threads" threads (0: one per hardware
+   //              thread). The elements are split by position into ordered chunks,
+   //              found through the subtree sizes, which a work-stealing pool runs.
+   //              "visit" is called concurrently and in no particular order.
+   // Precondition: No put into this Dictionary meanwhile - traverse a snapshot otherwise.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Time efficiency: O(n / threads + chunks * log2 n)
+   void displayContentParallel(const std::function<void(WordPair &)> & visit,
+                               unsigned int threads = 0) const;
+
+   // Description: Writes every element to "out", one "english:translation" line each,
+   //              in key order. Chunks are formatted in parallel as above, each
+   //              into its own buffer, and the buffers written in order.
+   // Precondition: No put into this Dictionary meanwhile - export a snapshot otherwise.
+   // Time efficiency: O(n / threads + chunks * log2 n), plus the writing itself.
+   void exportContent(std::ostream & out, unsigned int threads = 0) const;
+
+   // Description: Visits, in key order, the "count" elements starting at position
+   //              "offset" (fewer at the end of the Dictionary) - one page of a browse.
+   // Time efficiency: O(height + count)
+   void displayPage(unsigned int offset, unsigned int count,
+                    const std::function<void(WordPair &)> & visit) const;
+
+   // Description: Makes every later get() that finds its element count it,
+   //              the statistics rebuildForAccesses() shapes the tree from.
+   //              Counting costs one atomic increment per lookup found.
+   //              The counts live in the nodes, so a get() on a snapshot taken
+   //              while counting (which copies the flag) also counts the nodes
+   //              the snapshot still shares with this Dictionary.
+   void enableAccessCounts();
+
+   // Description: Stops get() from counting, once the counts rebuildForAccesses()
+   //              needs are gathered; the counts gathered so far are kept.
+   //              Snapshots taken while counting keep counting.
+   void disableAccessCounts();
+
+   // Description: Rebuilds the tree from the counted accesses so that the words
+   //              looked up most often sit nearest the root (weight-balanced tree).
+   //              Expected comparisons per lookup then track the entropy of the
+   //              queries rather than log2 n. Snapshots keep the previous shape;
+   //              the reverse index is rebuilt for the new nodes, the other
+   //              indexes are by key and stay valid.
+   // Exception: Throws the exception "UnableToInsertException" if memory ran out,
+   //            leaving the Dictionary unchanged.
+   // Time efficiency: O(n log2 n)
+   void rebuildForAccesses();
+
+   // Description: Returns the average number of key comparisons that the counted
+   //              lookups take in the current tree, or 0 if none was counted.
+   // Time efficiency: O(n)
+   double getAverageAccessComparisons() const;
+
+   // Description: Builds the "did you mean" index over the current keys.
+   //              Later puts keep it up to date.
+   // Time efficiency: O(n * depth * |key|^2)
+   void enableSuggestions();
+
+   // Description: Returns true if enableSuggestions() was called.
+   bool hasSuggestions() const;
+
+   // Description: Returns the English words of at most "k" elements whose key is
+   //              within edit distance "maxDistance" of the key of "targetElement",
+   //              closest first. Meant for "targetElement"s that get() did not find.
+   // Precondition: enableSuggestions() was called, otherwise nothing is suggested.
+   // Time efficiency: Far below O(n) for small "maxDistance" - see SuggestionIndex.
+   std::vector<string> suggest(const WordPair & targetElement, unsigned int k = 5,
+                               unsigned int maxDistance = 2) const;
+
+   // Description: Builds the translation-to-English index over the current elements.
+   //              Later puts keep it up to date. It holds no strings, only a hash
+   //              and a pointer to the element's node for each element.
+   // Time efficiency: O(n)
+   void enableReverseIndex();
+
+   // Description: Returns true if enableReverseIndex() was called.
+   bool hasReverseIndex() const;
+
+   // Description: Returns, in key order, the elements whose translation matches
+   //              "translation" (after the normalization policy, if any).
+   // Precondition: enableReverseIndex() was called, otherwise nothing is found.
+   // Time efficiency: O(1) expected, plus the number of elements found
+   std::vector<WordPair> getByTranslation(const string & translation) const;
+
+   // Description: Builds a Bloom filter over the current keys, which get() then
+   //              checks before searching the tree, so that most keys that are
+   //              not in the Dictionary are rejected without a descent.
+   //              Later puts keep it up to date; it is resized whenever the
+   //              Dictionary outgrows it, keeping "falsePositiveRate".
+   // Precondition: 0 < falsePositiveRate < 1.
+   // Exception: Throws the exception logic_error if "falsePositiveRate" is out of range.
+   // Time efficiency: O(n)
+   void enableBloomFilter(double falsePositiveRate = 0.01);
+
+   // Description: Returns the Bloom filter, or nullptr if enableBloomFilter() was not called.
+   //              Meant for reporting its false-positive rate and memory usage.
+   const BloomFilter * getBloomFilter() const;
+
+   // Description: Returns false if "targetElement" is certainly not in the Dictionary.
+   //              With a Bloom filter this costs a hash and no descent, so callers
+   //              expecting many misses can skip get() and its exception.
+   //              Without one, it searches the tree.
+   bool mayContain(const WordPair & targetElement) const;
    
 }; // end Dictionary
 #endif
\ No newline at end of file
@@ -0,0 +1,145 @@
+/*
+ * DictionaryLoader.cpp
+ * 
+ * Description: Loads "english:translation" lines from a data file
+ *              into a Dictionary, or "english:translation1:...:translationN"
+ *              lines into a MultiLanguageDictionary. Several files can be
+ *              loaded in parallel into a ShardedDictionary.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "DictionaryLoader.h"
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+using std::ifstream;
+
+   // Description: Puts every "english:translation" line of "filename" into "target".
+   //              Lines that cannot be put (e.g. duplicates) are reported on "log"
+   //              and skipped.
+   // Postcondition: Returns false if "filename" could not be opened, true otherwise.
+   // Time efficiency: O(n log2 n)
+   bool DictionaryLoader::load(const string & filename, Dictionary & target, ostream & log) {
+
+      string nextLine = "";
+
+      ifstream myfile (filename);
+      if (!myfile.is_open()) {
+         return false;
+      }
+      while (getline(myfile, nextLine)) {
+         WordPair nextWordPair = parse(nextLine);
+         // insert nextWordPair into "target" using a try/catch block
+         try {
+            target.put(nextWordPair);
+         }
+         catch (ElementAlreadyExistsException& anException) {
+            log << "put() unsuccessful because " << anException.what() << endl;
+         }
+         catch (UnableToInsertException& anException) {
+            log << "put() unsuccessful because " << anException.what() << endl;
+         }
+      }
+      myfile.close();
+      return true;
+   }
+
+   // Description: Puts every line of every file of "filenames" into "target",
+   //              one thread per file.
+   // Postcondition: Returns the number of files that could not be opened.
+   unsigned int DictionaryLoader::loadParallel(const vector<string> & filenames, ShardedDictionary & target,
+                                               ostream & log) {
+
+      std::mutex logMutex;
+      std::atomic<unsigned int> failures{0};
+      vector<std::thread> feeds;
+      for (const string & filename : filenames) {
+         feeds.emplace_back([&, filename]() {
+            string nextLine = "";
+            ifstream myfile (filename);
+            if (!myfile.is_open()) {
+               failures++;
+               return;
+            }
+            while (getline(myfile, nextLine)) {
+               WordPair nextWordPair = parse(nextLine);
+               //feeds only contend when their words fall into the same shard
+               try {
+                  target.put(nextWordPair);
+               }
+               catch (std::logic_error& anException) {
+                  std::lock_guard<std::mutex> guard(logMutex);
+                  log << "put() unsuccessful because " << anException.what() << endl;
+               }
+            }
+         });
+      }
+      for (std::thread & feed : feeds) {
+         feed.join();
+      }
+      return failures.load();
+   }
+
+   // Description: Builds a MultiLanguageDictionary from "filename", whose first
+   //              line names the columns.
+   // Postcondition: Returns nullptr if "filename" could not be opened or is empty.
+   // Time efficiency: O(n log2 n)
+   MultiLanguageDictionary * DictionaryLoader::loadMultiLanguage(const string & filename, ostream & log) {
+
+      string nextLine = "";
+
+      ifstream myfile (filename);
+      if (!myfile.is_open() || !getline(myfile, nextLine)) {
+         return nullptr;
+      }
+      //the header names the key column first, then one column per language
+      vector<string> languages = split(nextLine, ':');
+      languages.erase(languages.begin());
+
+      vector< vector<string> > rows;
+      while (getline(myfile, nextLine)) {
+         rows.push_back(split(nextLine, ':'));
+      }
+      myfile.close();
+
+      //one sort for the whole file rather than a shifting insert per row
+      MultiLanguageDictionary * target = new MultiLanguageDictionary(languages);
+      vector<ElementAlreadyExistsException> skipped = target->putAll(std::move(rows));
+      for (const ElementAlreadyExistsException & anException : skipped) {
+         log << "put() unsuccessful because " << anException.what() << endl;
+      }
+      return target;
+   }
+
+   // Description: Splits "line" at every occurrence of "delimiter".
+   // Time efficiency: O(length of line)
+   vector<string> DictionaryLoader::split(const string & line, char delimiter) {
+
+      vector<string> fields;
+      size_t start = 0;
+      size_t pos = line.find(delimiter);
+      while (pos != string::npos) {
+         fields.push_back(line.substr(start, pos - start));
+         start = pos + 1;
+         pos = line.find(delimiter, start);
+      }
+      fields.push_back(line.substr(start));
+      return fields;
+   }
+
+   // Description: Returns the WordPair of an "english:translation" line.
+   WordPair DictionaryLoader::parse(const string & line) {
+
+      //split the line at the first delimiter
+      string delimiter = ":";
+      size_t pos = line.find(delimiter);
+      if (pos == string::npos) {
+         //a line without delimiter is its own translation, as it always was
+         return WordPair(line, line);
+      }
+      return WordPair(line.substr(0, pos), line.substr(pos + delimiter.length()));
+   }
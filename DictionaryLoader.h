@@ -0,0 +1,60 @@
+/*
+ * DictionaryLoader.h
+ * 
+ * Description: Loads "english:translation" lines from a data file
+ *              into a Dictionary, or "english:translation1:...:translationN"
+ *              lines into a MultiLanguageDictionary. Several files can be
+ *              loaded in parallel into a ShardedDictionary.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef DICTIONARY_LOADER_H
+#define DICTIONARY_LOADER_H
+
+#include "Dictionary.h"
+#include "MultiLanguageDictionary.h"
+#include "ShardedDictionary.h"
+#include <ostream>
+#include <string>
+
+using std::string;
+using std::ostream;
+
+class DictionaryLoader {
+
+public:
+
+   // Description: Puts every "english:translation" line of "filename" into "target".
+   //              Lines that cannot be put (e.g. duplicates) are reported on "log"
+   //              and skipped.
+   // Postcondition: Returns false if "filename" could not be opened, true otherwise.
+   // Time efficiency: O(n log2 n)
+   static bool load(const string & filename, Dictionary & target, ostream & log);
+
+   // Description: Puts every line of every file of "filenames" into "target",
+   //              one thread per file. Lines that cannot be put are reported
+   //              on "log" and skipped.
+   // Postcondition: Returns the number of files that could not be opened.
+   // Time efficiency: O(n log2 n) total, spread over the files' threads.
+   static unsigned int loadParallel(const vector<string> & filenames, ShardedDictionary & target,
+                                    ostream & log);
+
+   // Description: Builds a MultiLanguageDictionary from "filename". Its first line
+   //              names the columns ("english:french:spanish:..."), every other
+   //              line holds a key and its translations in that column order.
+   //              Duplicated keys are reported on "log" and skipped.
+   // Postcondition: Returns nullptr if "filename" could not be opened or is empty,
+   //                otherwise a new MultiLanguageDictionary owned by the caller.
+   // Time efficiency: O(n log2 n)
+   static MultiLanguageDictionary * loadMultiLanguage(const string & filename, ostream & log);
+
+   // Description: Splits "line" at every occurrence of "delimiter".
+   static vector<string> split(const string & line, char delimiter);
+
+   // Description: Returns the WordPair of an "english:translation" line.
+   static WordPair parse(const string & line);
+
+}; // end DictionaryLoader
+#endif
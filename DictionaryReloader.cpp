@@ -0,0 +1,173 @@
+/*
+ * DictionaryReloader.cpp
+ * 
+ * Description: Keeps a Dictionary loaded from a data file up to date while
+ *              it is being queried. When the file's modification time changes,
+ *              or when SIGHUP is received, a new Dictionary is built on a
+ *              background thread and atomically swapped in.
+ *              Readers hold a shared_ptr to the Dictionary they are using,
+ *              so an old Dictionary lives on until its last reader is done;
+ *              the watcher thread keeps it until then and destroys it itself,
+ *              so that no reader pays for tearing down a whole Dictionary.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "DictionaryReloader.h"
+#include "DictionaryLoader.h"
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <sys/stat.h>
+
+using std::cerr;
+
+std::atomic<unsigned int> DictionaryReloader::hangupCount{0};
+
+/* Constructors and destructor */
+
+   DictionaryReloader::DictionaryReloader(const string & filename, unsigned int normalization,
+                                          unsigned int pollIntervalMs)
+      : filename(filename), normalization(normalization), pollIntervalMs(pollIntervalMs),
+        current(std::make_shared<const Dictionary>()) { }
+
+   // Destructor
+   DictionaryReloader::~DictionaryReloader() {
+      {
+         std::lock_guard<std::mutex> lock(watcherMutex);
+         stopRequested = true;
+      }
+      watcherWakeUp.notify_one();
+      if (watcher.joinable()) {
+         watcher.join();
+      }
+   }
+
+
+/* Reloader operations */
+
+   // Description: Loads the data file and starts watching it.
+   // Postcondition: Returns false, without starting the watcher,
+   //                if the data file cannot be opened.
+   bool DictionaryReloader::start() {
+
+      hangupsSeen = hangupCount.load();
+      if (!reload()) {
+         return false;
+      }
+      watcher = std::thread(&DictionaryReloader::watch, this);
+      return true;
+   }
+
+   // Description: Returns the Dictionary to use for the next queries.
+   // Time efficiency: O(1)
+   std::shared_ptr<const Dictionary> DictionaryReloader::acquire() const {
+      return std::atomic_load(&current);
+   }
+
+   // Description: Asks the watcher thread to reload the data file now.
+   void DictionaryReloader::requestReload() {
+      {
+         std::lock_guard<std::mutex> lock(watcherMutex);
+         reloadRequested = true;
+      }
+      watcherWakeUp.notify_one();
+   }
+
+   // Description: Returns the number of Dictionaries swapped in, including the initial load.
+   unsigned int DictionaryReloader::getReloadCount() const {
+      return reloadCount.load();
+   }
+
+   // Description: Makes SIGHUP request a reload of every started DictionaryReloader.
+   void DictionaryReloader::installSignalHandler() {
+      std::signal(SIGHUP, onHangup);
+   }
+
+   // Description: SIGHUP handler, only counts the signal on a lock-free atomic.
+   void DictionaryReloader::onHangup(int signalNumber) {
+      hangupCount.fetch_add(1);
+   }
+
+   // Description: Body of the watcher thread.
+   void DictionaryReloader::watch() {
+
+      std::unique_lock<std::mutex> lock(watcherMutex);
+      while (!stopRequested) {
+         watcherWakeUp.wait_for(lock, std::chrono::milliseconds(pollIntervalMs));
+         if (stopRequested) {
+            break;
+         }
+         unsigned int hangups = hangupCount.load();
+         bool requested = reloadRequested || hangups != hangupsSeen;
+         reloadRequested = false;
+         hangupsSeen = hangups;
+
+         //build outside the lock so requestReload() and the destructor never wait on a load
+         lock.unlock();
+         if (requested || fileChanged()) {
+            if (reload()) {
+               cerr << "Reloaded " << filename << " (" << acquire()->getElementCount()
+                    << " words)." << endl;
+            }
+         }
+         releaseRetired();
+         lock.lock();
+      }
+   }
+
+   // Description: Destroys the retired Dictionaries that no reader holds anymore.
+   // Time efficiency: O(n) for each Dictionary destroyed
+   void DictionaryReloader::releaseRetired() {
+
+      //a retired Dictionary cannot be acquired again, so once only "retired" holds
+      //it, it stays that way
+      for (size_t i = 0; i < retired.size(); ) {
+         if (retired[i].use_count() == 1) {
+            retired[i] = retired.back();
+            retired.pop_back();
+         }
+         else {
+            i++;
+         }
+      }
+   }
+
+   // Description: Returns true when the data file differs from the loaded one.
+   bool DictionaryReloader::fileChanged() const {
+
+      struct stat status;
+      if (stat(filename.c_str(), &status) != 0) {
+         return false;
+      }
+      return status.st_mtim.tv_sec != loadedModificationTime.tv_sec
+          || status.st_mtim.tv_nsec != loadedModificationTime.tv_nsec
+          || status.st_size != loadedSize;
+   }
+
+   // Description: Builds a new Dictionary from the data file and swaps it in.
+   // Postcondition: Returns true if a new Dictionary was swapped in.
+   bool DictionaryReloader::reload() {
+
+      //record the file state first so a write during the load triggers another reload
+      struct stat status;
+      if (stat(filename.c_str(), &status) != 0) {
+         return false;
+      }
+      std::shared_ptr<Dictionary> fresh = std::make_shared<Dictionary>();
+      fresh->setNormalization(normalization);
+      //every reload would list the same skipped lines again: a stream with no buffer drops them
+      std::ostream discard(nullptr);
+      if (!DictionaryLoader::load(filename, *fresh, discard)) {
+         return false;
+      }
+      loadedModificationTime = status.st_mtim;
+      loadedSize = status.st_size;
+
+      //readers still holding the previous Dictionary keep it alive until they release it;
+      //it is retired here rather than dropped, so the last of them does not destroy it
+      retired.push_back(std::atomic_exchange(&current, std::shared_ptr<const Dictionary>(std::move(fresh))));
+      reloadCount++;
+      return true;
+   }
@@ -0,0 +1,108 @@
+/*
+ * DictionaryReloader.h
+ * 
+ * Description: Keeps a Dictionary loaded from a data file up to date while
+ *              it is being queried. When the file's modification time changes,
+ *              or when SIGHUP is received, a new Dictionary is built on a
+ *              background thread and atomically swapped in.
+ *              Readers hold a shared_ptr to the Dictionary they are using,
+ *              so an old Dictionary lives on until its last reader is done;
+ *              the watcher thread keeps it until then and destroys it itself,
+ *              so that no reader pays for tearing down a whole Dictionary.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef DICTIONARY_RELOADER_H
+#define DICTIONARY_RELOADER_H
+
+#include "Dictionary.h"
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using std::string;
+
+class DictionaryReloader {
+
+private:
+
+   string filename;
+   unsigned int normalization;
+   unsigned int pollIntervalMs;
+
+   // Dictionary currently served to readers - only accessed with std::atomic_load/store.
+   std::shared_ptr<const Dictionary> current;
+
+   // Modification time and size of the data file when "current" was loaded.
+   struct timespec loadedModificationTime = {0, 0};
+   off_t loadedSize = -1;
+
+   // Dictionaries swapped out but maybe still in use - only accessed by the watcher thread.
+   std::vector< std::shared_ptr<const Dictionary> > retired;
+
+   std::atomic<unsigned int> reloadCount{0};
+   std::thread watcher;
+   std::mutex watcherMutex;
+   std::condition_variable watcherWakeUp;
+   bool stopRequested = false;
+   bool reloadRequested = false;
+
+   // Number of SIGHUPs received, counted by the handler. Each watcher thread
+   // reloads when it differs from the count it last saw, so every reloader
+   // sees every SIGHUP.
+   static std::atomic<unsigned int> hangupCount;
+   unsigned int hangupsSeen = 0;
+   static void onHangup(int signalNumber);
+
+   // Description: Body of the watcher thread. Polls the data file every
+   //              "pollIntervalMs" milliseconds and reloads it when needed.
+   void watch();
+
+   // Description: Destroys the retired Dictionaries that no reader holds anymore.
+   void releaseRetired();
+
+   // Description: Returns true when the data file differs from the loaded one.
+   bool fileChanged() const;
+
+   // Description: Builds a new Dictionary from the data file and swaps it in.
+   //              The served Dictionary is left untouched if the file cannot be read.
+   // Postcondition: Returns true if a new Dictionary was swapped in.
+   bool reload();
+
+public:
+
+   // Constructor and destructor
+   // Every Dictionary loaded uses the "normalization" policy (KeyNormalizer flags).
+   DictionaryReloader(const string & filename, unsigned int normalization = KeyNormalizer::NONE,
+                      unsigned int pollIntervalMs = 500);
+   ~DictionaryReloader();                    // Stops the watcher thread
+
+   // Description: Loads the data file and starts watching it.
+   // Postcondition: Returns false, without starting the watcher,
+   //                if the data file cannot be opened.
+   bool start();
+
+   // Description: Returns the Dictionary to use for the next queries.
+   //              It stays valid for as long as the caller holds it,
+   //              even if a reload swaps in a newer one meanwhile.
+   // Time efficiency: O(1)
+   std::shared_ptr<const Dictionary> acquire() const;
+
+   // Description: Asks the watcher thread to reload the data file now.
+   void requestReload();
+
+   // Description: Returns the number of Dictionaries swapped in, including the initial load.
+   unsigned int getReloadCount() const;
+
+   // Description: Makes SIGHUP request a reload of every started DictionaryReloader.
+   static void installSignalHandler();
+
+}; // end DictionaryReloader
+#endif
@@ -0,0 +1,118 @@
+/*
+ * DictionaryReloaderTestDriver.cpp
+ *
+ * Description: Drives the testing of the DictionaryReloader class. Rewrites
+ *              the data file of a started reloader and sends it SIGHUP,
+ *              checking that each brings in a new Dictionary while readers
+ *              keep the one they acquired before.
+ *              Prints one line per check and returns the number of failures.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include "DictionaryReloader.h"
+#include "TestReport.h"
+#include "WordPair.h"
+#include "ElementDoesNotExistException.h"
+#include "EmptyDataCollectionException.h"
+
+// File written by the tests, removed at the end.
+static const string DATA_FILE = "reloaderTestDriver.txt";
+
+// Short, so that the tests do not wait long for the watcher.
+static const unsigned int POLL_INTERVAL_MS = 20;
+
+static TestReport report;
+
+// Description: Writes "lines" to the data file, replacing what it held.
+void writeDataFile(const string & lines) {
+
+  std::ofstream data(DATA_FILE, std::ios::trunc);
+  data << lines;
+}
+
+// Description: Returns the translation of "english" in "myWords", or "" if it is not there.
+string translationOf(const Dictionary & myWords, const string & english) {
+
+  WordPair query(english);
+  try {
+     return myWords.get(query).getTranslation();
+  }
+  catch (ElementDoesNotExistException& anException) {
+     return "";
+  }
+  catch (EmptyDataCollectionException& anException) {
+     return "";
+  }
+}
+
+// Description: Returns true once "reloader" has swapped in "count" Dictionaries,
+//              false if it has not within a few seconds.
+bool waitForReloads(const DictionaryReloader & reloader, unsigned int count) {
+
+  for (int attempt = 0; attempt < 200; attempt++) {
+     if (reloader.getReloadCount() >= count) {
+        return true;
+     }
+     std::this_thread::sleep_for(std::chrono::milliseconds(POLL_INTERVAL_MS));
+  }
+  return false;
+}
+
+// Description: Checks that start() fails on a data file that does not exist.
+void testMissingFile() {
+
+  DictionaryReloader reloader("reloaderTestDriver.missing", KeyNormalizer::NONE, POLL_INTERVAL_MS);
+  report.check("start on a missing data file", !reloader.start() && reloader.getReloadCount() == 0);
+}
+
+// Description: Rewrites the data file, then sends SIGHUP with the file unchanged,
+//              and checks that each swaps in a Dictionary of the file's content
+//              while a Dictionary acquired before keeps its own.
+void testFileChangeAndHangup() {
+
+  writeDataFile("food:nourriture\nwater:eau\nfood:aliment\n");
+  DictionaryReloader reloader(DATA_FILE, KeyNormalizer::NONE, POLL_INTERVAL_MS);
+  DictionaryReloader::installSignalHandler();
+  bool passed = reloader.start() && reloader.getReloadCount() == 1;
+  std::shared_ptr<const Dictionary> first = reloader.acquire();
+  passed = passed && first->getElementCount() == 2 && translationOf(*first, "food") == "nourriture";
+  report.check("initial load keeps the first of duplicate lines", passed);
+
+  //a different size, so that the change shows even within one tick of the clock
+  writeDataFile("food:aliment\nwater:eau\nbread:pain\n");
+  passed = waitForReloads(reloader, 2);
+  std::shared_ptr<const Dictionary> second = reloader.acquire();
+  passed = passed && second->getElementCount() == 3 && translationOf(*second, "food") == "aliment"
+           && translationOf(*second, "bread") == "pain";
+  passed = passed && first->getElementCount() == 2 && translationOf(*first, "food") == "nourriture"
+           && translationOf(*first, "bread") == "";
+  report.check("a rewritten data file is reloaded, readers keep theirs", passed);
+
+  std::raise(SIGHUP);
+  passed = waitForReloads(reloader, 3);
+  std::shared_ptr<const Dictionary> third = reloader.acquire();
+  passed = passed && third != second && third->getElementCount() == 3
+           && translationOf(*third, "bread") == "pain";
+  report.check("SIGHUP reloads an unchanged data file", passed);
+}
+
+int main() {
+
+  //the watcher reports each reload on cerr, between the checks' lines: drop it
+  std::cerr.rdbuf(nullptr);
+  testMissingFile();
+  testFileChangeAndHangup();
+
+  std::remove(DATA_FILE.c_str());
+  return report.summarize();
+}
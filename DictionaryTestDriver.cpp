@@ -0,0 +1,281 @@
+/*
+ * DictionaryTestDriver.cpp
+ *
+ * Description: Drives the testing of Dictionary snapshots. A snapshot, taken
+ *              by copying a Dictionary, shares its tree and indexes until a
+ *              put copies what it writes to; these tests put into both sides
+ *              of snapshots and check that neither sees the other's puts,
+ *              through get, the in order traversal and the reverse index.
+ *              Prints one line per check and returns the number of failures.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "Dictionary.h"
+#include "TestReport.h"
+#include "WordPair.h"
+#include "ElementAlreadyExistsException.h"
+#include "ElementDoesNotExistException.h"
+#include "EmptyDataCollectionException.h"
+
+using std::vector;
+
+// More words than a chunk of the indexes holds, so that puts after a
+// snapshot copy some chunks and keep sharing others.
+static const unsigned int WORD_COUNT = 3000;
+
+// Translations are shared by groups of words, so that the reverse index
+// holds several elements for each.
+static const unsigned int TRANSLATION_COUNT = 50;
+
+static TestReport report;
+
+// Description: Returns the "count" words of the tests, shuffled, so that the
+//              tree they are put into is not a list.
+vector<WordPair> makeWords(unsigned int count) {
+
+  vector<WordPair> words;
+  for (unsigned int i = 0; i < count; i++) {
+     words.push_back(WordPair("word" + std::to_string(i),
+                              "translation" + std::to_string(i % TRANSLATION_COUNT)));
+  }
+  std::mt19937 generator(2023);
+  std::shuffle(words.begin(), words.end(), generator);
+  return words;
+}
+
+// Description: Returns true if "myWords" holds "aWord", with its translation.
+bool holds(const Dictionary & myWords, const WordPair & aWord) {
+
+  WordPair query(aWord.getEnglish());
+  try {
+     return myWords.get(query).getTranslation() == aWord.getTranslation();
+  }
+  catch (ElementDoesNotExistException& anException) {
+     return false;
+  }
+  catch (EmptyDataCollectionException& anException) {
+     return false;
+  }
+}
+
+// Description: Returns true if "myWords" holds exactly "expected", in key order.
+bool holdsExactly(const Dictionary & myWords, vector<WordPair> expected) {
+
+  std::sort(expected.begin(), expected.end());
+  if (myWords.getElementCount() != expected.size()) {
+     return false;
+  }
+  if (expected.empty()) {
+     return true;
+  }
+  vector<WordPair> visited;
+  myWords.displayContent([&visited](WordPair & anElement) {
+     visited.push_back(anElement);
+  });
+  if (visited.size() != expected.size()) {
+     return false;
+  }
+  for (unsigned int i = 0; i < visited.size(); i++) {
+     if (!(visited[i] == expected[i]) || visited[i].getTranslation() != expected[i].getTranslation()) {
+        return false;
+     }
+  }
+  for (const WordPair & aWord : expected) {
+     if (!holds(myWords, aWord)) {
+        return false;
+     }
+  }
+  return true;
+}
+
+// Description: Returns true if the reverse index of "myWords" finds, for every
+//              translation, exactly the elements of "expected" that have it.
+bool reverseIndexMatches(const Dictionary & myWords, const vector<WordPair> & expected) {
+
+  for (unsigned int t = 0; t < TRANSLATION_COUNT; t++) {
+     string translation = "translation" + std::to_string(t);
+     vector<string> wanted;
+     for (const WordPair & aWord : expected) {
+        if (aWord.getTranslation() == translation) {
+           wanted.push_back(aWord.getEnglish());
+        }
+     }
+     std::sort(wanted.begin(), wanted.end());
+     vector<WordPair> found = myWords.getByTranslation(translation);
+     if (found.size() != wanted.size()) {
+        return false;
+     }
+     for (unsigned int i = 0; i < found.size(); i++) {
+        if (found[i].getEnglish() != wanted[i] || found[i].getTranslation() != translation) {
+           return false;
+        }
+     }
+  }
+  return true;
+}
+
+// Description: Puts the first half of the words, takes a snapshot, puts the
+//              second half into the original and checks both.
+void testSnapshotIgnoresLaterPuts(const vector<WordPair> & words) {
+
+  Dictionary original;
+  vector<WordPair> before(words.begin(), words.begin() + words.size() / 2);
+  vector<WordPair> after(words.begin() + words.size() / 2, words.end());
+  for (WordPair aWord : before) {
+     original.put(aWord);
+  }
+  Dictionary snapshot(original);
+  for (WordPair aWord : after) {
+     original.put(aWord);
+  }
+  bool passed = holdsExactly(snapshot, before) && holdsExactly(original, words);
+  for (unsigned int i = 0; passed && i < after.size(); i++) {
+     passed = !holds(snapshot, after[i]);
+  }
+  report.check("snapshot does not see the puts into the original", passed);
+}
+
+// Description: Puts into a snapshot taken by assignment, and checks that the
+//              original does not see those puts, nor a put of the same key.
+void testPutsIntoSnapshot(const vector<WordPair> & words) {
+
+  Dictionary original;
+  vector<WordPair> shared(words.begin(), words.begin() + words.size() / 3);
+  for (WordPair aWord : shared) {
+     original.put(aWord);
+  }
+  Dictionary snapshot;
+  snapshot = original;
+
+  //each side gets its own third of the words, then the other's first one
+  vector<WordPair> mine(shared);
+  vector<WordPair> theirs(shared);
+  for (unsigned int i = words.size() / 3; i < 2 * words.size() / 3; i++) {
+     WordPair aWord = words[i];
+     snapshot.put(aWord);
+     theirs.push_back(words[i]);
+  }
+  for (unsigned int i = 2 * words.size() / 3; i < words.size(); i++) {
+     WordPair aWord = words[i];
+     original.put(aWord);
+     mine.push_back(words[i]);
+  }
+  bool passed = holdsExactly(original, mine) && holdsExactly(snapshot, theirs);
+
+  //a key already put on one side only is still new to the other
+  WordPair theirFirst = words[words.size() / 3];
+  try {
+     original.put(theirFirst);
+     mine.push_back(theirFirst);
+  }
+  catch (ElementAlreadyExistsException& anException) {
+     passed = false;
+  }
+  try {
+     snapshot.put(theirFirst);
+     passed = false;
+  }
+  catch (ElementAlreadyExistsException& anException) { }
+  passed = passed && holdsExactly(original, mine) && holdsExactly(snapshot, theirs);
+  report.check("puts into a snapshot do not reach the original", passed);
+}
+
+// Description: Takes a snapshot after each batch of puts and checks, at the end,
+//              that every snapshot still holds its own batches only.
+void testSnapshotGenerations(const vector<WordPair> & words) {
+
+  const unsigned int batches = 6;
+  Dictionary current;
+  vector<Dictionary> snapshots;
+  vector<unsigned int> sizes;
+  unsigned int put = 0;
+  for (unsigned int batch = 1; batch <= batches; batch++) {
+     for (; put < words.size() * batch / batches; put++) {
+        WordPair aWord = words[put];
+        current.put(aWord);
+     }
+     snapshots.push_back(current);
+     sizes.push_back(put);
+  }
+  bool passed = true;
+  for (unsigned int i = 0; passed && i < snapshots.size(); i++) {
+     passed = holdsExactly(snapshots[i], vector<WordPair>(words.begin(), words.begin() + sizes[i]));
+  }
+  report.check("each snapshot of a series keeps its own content", passed);
+}
+
+// Description: Checks that the reverse index of a snapshot and of its original
+//              each find their own elements, as puts repoint the index of
+//              one side only at the nodes they copy.
+void testReverseIndexAcrossSnapshots(const vector<WordPair> & words) {
+
+  Dictionary original;
+  original.enableReverseIndex();
+  vector<WordPair> before(words.begin(), words.begin() + words.size() / 2);
+  for (WordPair aWord : before) {
+     original.put(aWord);
+  }
+  bool passed = reverseIndexMatches(original, before);
+
+  Dictionary snapshot(original);
+  vector<WordPair> mine(before);
+  vector<WordPair> theirs(before);
+  for (unsigned int i = words.size() / 2; i < words.size(); i++) {
+     WordPair aWord = words[i];
+     if (i % 2 == 0) {
+        original.put(aWord);
+        mine.push_back(words[i]);
+     }
+     else {
+        snapshot.put(aWord);
+        theirs.push_back(words[i]);
+     }
+  }
+  passed = passed && reverseIndexMatches(original, mine) && reverseIndexMatches(snapshot, theirs);
+
+  //the snapshot is dropped: the original's index must not point into its nodes
+  snapshot = Dictionary();
+  passed = passed && reverseIndexMatches(original, mine) && holdsExactly(original, mine);
+  report.check("reverse index of a snapshot and of its original stay apart", passed);
+}
+
+// Description: Checks that enabling the reverse index on a snapshot indexes
+//              its content only, and leaves the original without one.
+void testReverseIndexEnabledOnSnapshot(const vector<WordPair> & words) {
+
+  Dictionary original;
+  vector<WordPair> before(words.begin(), words.begin() + words.size() / 2);
+  for (WordPair aWord : before) {
+     original.put(aWord);
+  }
+  Dictionary snapshot(original);
+  snapshot.enableReverseIndex();
+  for (unsigned int i = words.size() / 2; i < words.size(); i++) {
+     WordPair aWord = words[i];
+     original.put(aWord);
+  }
+  bool passed = snapshot.hasReverseIndex() && !original.hasReverseIndex()
+                && reverseIndexMatches(snapshot, before)
+                && original.getByTranslation("translation0").empty();
+  report.check("reverse index enabled on a snapshot covers the snapshot only", passed);
+}
+
+int main() {
+
+  vector<WordPair> words = makeWords(WORD_COUNT);
+
+  testSnapshotIgnoresLaterPuts(words);
+  testPutsIntoSnapshot(words);
+  testSnapshotGenerations(words);
+  testReverseIndexAcrossSnapshots(words);
+  testReverseIndexEnabledOnSnapshot(words);
+
+  return report.summarize();
+}
@@ -0,0 +1,315 @@
+/*
+ * DiskDictionary.cpp
+ *
+ * Description: Read-only Dictonary data collection ADT class kept on disk,
+ *              for dictionaries larger than memory. The elements are stored
+ *              in key order in the leaf pages of a B+-tree file written by
+ *              DiskDictionaryBuilder; inner pages hold, for each child, the
+ *              shortest key that separates it from the previous child.
+ *              Pages are read through a PageCache of a fixed number of pages,
+ *              except the top inner levels of the tree, which are read once
+ *              when the file is opened and kept in memory ("pinned").
+ *              Duplicated elements not allowed.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "DiskDictionary.h"
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+
+const char DiskDictionary::MAGIC[8] = { 'W', 'P', 'D', 'I', 'S', 'K', '0', '1' };
+
+// Description: Returns the uint16_t at "data".
+static inline uint16_t read16(const char * data) {
+   uint16_t value;
+   memcpy(&value, data, sizeof(value));
+   return value;
+}
+
+// Description: Returns the uint32_t at "data".
+static inline uint32_t read32(const char * data) {
+   uint32_t value;
+   memcpy(&value, data, sizeof(value));
+   return value;
+}
+
+// Description: Compares the "length" bytes at "stored" with "key" as strings do.
+static inline int compareKey(const char * stored, size_t length, const string & key) {
+   int comparison = memcmp(stored, key.data(), length < key.size() ? length : key.size());
+   if (comparison != 0) return comparison;
+   return (length < key.size()) ? -1 : (length > key.size() ? 1 : 0);
+}
+
+/* Constructor and destructor */
+
+   // Exception: Throws the exception logic_error if the file cannot be opened
+   //            or is not a dictionary file.
+   DiskDictionary::DiskDictionary(const string & fileName, unsigned int cachePages,
+                                  PageCache::Policy policy, unsigned int pinnedLevels) {
+
+      fd = open(fileName.c_str(), O_RDONLY);
+      if (fd < 0) {
+         throw std::logic_error("Unable to open file " + fileName + ".");
+      }
+      if (pread(fd, &header, sizeof(header), 0) != (ssize_t) sizeof(header)
+          || memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.pageSize != PAGE_SIZE) {
+         close(fd);
+         throw std::logic_error(fileName + " is not a dictionary page file.");
+      }
+      normalizer = KeyNormalizer(header.normalization);
+      cache.reset(new PageCache(fd, PAGE_SIZE, cachePages, policy));
+      try {
+         //leaves are never pinned: there are too many of them to gain from it
+         unsigned int innerLevels = (header.height > 0) ? header.height - 1 : 0;
+         pinTopLevels(pinnedLevels < innerLevels ? pinnedLevels : innerLevels);
+      }
+      catch (std::logic_error & anException) {
+         close(fd);
+         throw;
+      }
+   }
+
+   DiskDictionary::~DiskDictionary() {
+      close(fd);
+   }
+
+
+/* Getters */
+
+   unsigned int DiskDictionary::getElementCount() const {
+      return header.elementCount;
+   }
+
+   unsigned int DiskDictionary::getHeight() const {
+      return header.height;
+   }
+
+   unsigned int DiskDictionary::getNormalization() const {
+      return header.normalization;
+   }
+
+   unsigned int DiskDictionary::getPinnedPageCount() const {
+      return pinnedPages.size();
+   }
+
+   const PageCache & DiskDictionary::getCache() const {
+      return *cache;
+   }
+
+   // Description: Returns the number of bytes of memory used by the Dictionary.
+   size_t DiskDictionary::getMemoryUsage() const {
+      return sizeof(*this) + cache->getMemoryUsage()
+           + pinnedPages.size() * (PAGE_SIZE + sizeof(std::vector<char>) + sizeof(uint32_t) + 2 * sizeof(void *))
+           + pinnedPages.bucket_count() * sizeof(void *);
+   }
+
+
+/* Dictionary operations */
+
+   // Description: Gets the element whose key matches "targetElement".
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Exception: Throws the exception ElementDoesNotExistException
+   //            if the key is not found in the Dictionary.
+   // Exception: Throws the exception logic_error if a page cannot be read.
+   // Time efficiency: O(log n), with at most height - pinned levels page reads
+   WordPair DiskDictionary::get(const WordPair & targetElement) const {
+
+      if (header.elementCount == 0)
+         throw EmptyDataCollectionException("Dictionary is empty.");
+
+      WordPair query = makeQuery(targetElement);
+      const string & key = query.getKey();
+      uint32_t page = header.rootPage;
+      unsigned int frame;
+      for (unsigned int level = header.height; level > 1; level--) {
+         const char * data = fetch(page, INNER_PAGE, frame);
+         page = findChild(data, key);
+         release(frame);
+      }
+
+      const char * data = fetch(page, LEAF_PAGE, frame);
+      unsigned int low = 0;
+      unsigned int high = read16(data);
+      while (low < high) {
+         unsigned int middle = low + (high - low) / 2;
+         const char * entry = data + read16(data + PAGE_HEADER_SIZE + 2 * middle);
+         int comparison = compareKey(entry + 2, read16(entry), key);
+         if (comparison == 0) {
+            WordPair found = decodeEntry(data, middle);
+            release(frame);
+            return found;
+         }
+         if (comparison < 0) {
+            low = middle + 1;
+         }
+         else {
+            high = middle;
+         }
+      }
+      release(frame);
+      throw ElementDoesNotExistException("***Not Found!***");
+   }
+
+   // Description: Returns true if the key of "targetElement" is in the Dictionary.
+   // Time efficiency: O(log n)
+   bool DiskDictionary::contains(const WordPair & targetElement) const {
+
+      try {
+         get(targetElement);
+         return true;
+      }
+      catch (ElementDoesNotExistException & anException) {
+         return false;
+      }
+      catch (EmptyDataCollectionException & anException) {
+         return false;
+      }
+   }
+
+   // Description: Visits the content of the Dictionary in key order.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   void DiskDictionary::displayContent(void visit(WordPair &)) const {
+      displayContent(std::function<void(WordPair &)>(visit));
+   }
+
+   // Description: Visits the content of the Dictionary in key order, reading
+   //              each leaf page once.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Time efficiency: O(n)
+   void DiskDictionary::displayContent(const std::function<void(WordPair &)> & visit) const {
+
+      if (header.elementCount == 0)
+         throw EmptyDataCollectionException("Dictionary is empty.");
+
+      std::vector<WordPair> elements;
+      uint32_t page = header.firstLeaf;
+      while (page != 0) {
+         //the page is released before visiting, so "visit" may throw or take its time
+         unsigned int frame;
+         const char * data = fetch(page, LEAF_PAGE, frame);
+         unsigned int count = read16(data);
+         elements.clear();
+         for (unsigned int i = 0; i < count; i++) {
+            elements.push_back(decodeEntry(data, i));
+         }
+         page = read32(data + 4);
+         release(frame);
+         for (WordPair & element : elements) {
+            visit(element);
+         }
+      }
+   }
+
+
+/* Utility methods */
+
+   // Description: Returns the data of page "page", and sets "frame" to the cache
+   //              frame to release() once done with it (NO_FRAME if the page is pinned).
+   // Exception: Throws the exception logic_error if the page cannot be read or is not of kind "kind".
+   const char * DiskDictionary::fetch(uint32_t page, unsigned int kind, unsigned int & frame) const {
+
+      const char * data;
+      auto pinned = pinnedPages.find(page);
+      if (pinned != pinnedPages.end()) {
+         frame = NO_FRAME;
+         data = pinned->second.data();
+      }
+      else {
+         frame = cache->pin(page);
+         data = cache->getData(frame);
+      }
+      if ((unsigned char) data[2] != kind) {
+         release(frame);
+         throw std::logic_error("Page " + std::to_string(page) + " is corrupt.");
+      }
+      return data;
+   }
+
+   // Description: Releases the cache frame of a page returned by fetch().
+   void DiskDictionary::release(unsigned int frame) const {
+      if (frame != NO_FRAME) {
+         cache->unpin(frame);
+      }
+   }
+
+   // Description: Reads the pages of the top "levels" inner levels into pinnedPages,
+   //              a level at a time.
+   void DiskDictionary::pinTopLevels(unsigned int levels) {
+
+      std::vector<uint32_t> level(1, header.rootPage);
+      for (unsigned int depth = 0; depth < levels; depth++) {
+         std::vector<uint32_t> children;
+         for (uint32_t page : level) {
+            std::vector<char> & data = pinnedPages[page];
+            data.resize(PAGE_SIZE);
+            if (pread(fd, data.data(), PAGE_SIZE, (off_t) page * PAGE_SIZE) != (ssize_t) PAGE_SIZE
+                || data[2] != (char) INNER_PAGE) {
+               throw std::logic_error("Page " + std::to_string(page) + " is corrupt.");
+            }
+            unsigned int count = read16(data.data());
+            children.push_back(read32(data.data() + 4));
+            for (unsigned int i = 0; i < count; i++) {
+               children.push_back(read32(data.data() + read16(data.data() + PAGE_HEADER_SIZE + 2 * i)));
+            }
+         }
+         level.swap(children);
+      }
+   }
+
+   // Description: Returns the child of inner page "data" whose keys would include "key":
+   //              the child of the last entry whose key is not greater than "key",
+   //              or child 0 if there is none.
+   // Time efficiency: O(log2 count)
+   uint32_t DiskDictionary::findChild(const char * data, const string & key) {
+
+      unsigned int low = 0;
+      unsigned int high = read16(data);
+      //invariant: every entry before "low" has a key <= "key", none from "high" does
+      while (low < high) {
+         unsigned int middle = low + (high - low) / 2;
+         const char * entry = data + read16(data + PAGE_HEADER_SIZE + 2 * middle);
+         if (compareKey(entry + 6, read16(entry + 4), key) <= 0) {
+            low = middle + 1;
+         }
+         else {
+            high = middle;
+         }
+      }
+      if (low == 0) {
+         return read32(data + 4);
+      }
+      return read32(data + read16(data + PAGE_HEADER_SIZE + 2 * (low - 1)));
+   }
+
+   // Description: Decodes leaf entry "index" of leaf page "data" into an element.
+   WordPair DiskDictionary::decodeEntry(const char * data, unsigned int index) {
+
+      const char * entry = data + read16(data + PAGE_HEADER_SIZE + 2 * index);
+      string key(entry + 2, read16(entry));
+      entry += 2 + key.size();
+      unsigned int englishLength = read16(entry);
+      entry += 2;
+      string english = key;
+      if (englishLength > 0) {
+         english.assign(entry, englishLength - 1);
+         entry += englishLength - 1;
+      }
+      WordPair element(english, string(entry + 2, read16(entry)));
+      element.setKey(key);
+      return element;
+   }
+
+   // Description: Returns "targetElement" with its key normalized by the policy.
+   WordPair DiskDictionary::makeQuery(const WordPair & targetElement) const {
+
+      if (normalizer.isIdentity()) {
+         return targetElement;
+      }
+      WordPair query;
+      query.setKey(normalizer.normalize(targetElement.getEnglish()));
+      return query;
+   }
@@ -0,0 +1,151 @@
+/*
+ * DiskDictionary.h
+ *
+ * Description: Read-only Dictonary data collection ADT class kept on disk,
+ *              for dictionaries larger than memory. The elements are stored
+ *              in key order in the leaf pages of a B+-tree file written by
+ *              DiskDictionaryBuilder; inner pages hold, for each child, the
+ *              shortest key that separates it from the previous child.
+ *              Pages are read through a PageCache of a fixed number of pages,
+ *              except the top inner levels of the tree, which are read once
+ *              when the file is opened and kept in memory ("pinned"). With
+ *              4 KB pages an inner page has a hundred children or more, so
+ *              pinning two levels leaves one or two page reads per lookup
+ *              for up to hundreds of millions of elements, and memory use is
+ *              bounded by the cache size plus the pinned pages.
+ *
+ *              File layout (integers in host byte order):
+ *              page 0:      header: magic, page size, normalization policy,
+ *                           element count, height, root page, first leaf page
+ *              other pages: uint16 count, uint8 kind (leaf or inner), uint8 unused,
+ *                           uint32 link (leaf: next leaf, 0 after the last;
+ *                           inner: child 0), uint16 offsets of "count" entries, entries.
+ *              leaf entry:  uint16 key length, key, uint16 English length
+ *                           (0 when the English word is the key, else length + 1),
+ *                           English word, uint16 translation length, translation.
+ *              inner entry: uint32 child, uint16 key length, key; the child holds
+ *                           the keys not less than this key and less than the next.
+ *              Duplicated elements not allowed.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef DISK_DICTIONARY_H
+#define DISK_DICTIONARY_H
+
+#include "KeyNormalizer.h"
+#include "PageCache.h"
+#include "WordPair.h"
+#include "ElementDoesNotExistException.h"
+#include "EmptyDataCollectionException.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class DiskDictionary {
+
+   friend class DiskDictionaryBuilder;
+
+private:
+
+   // File format.
+   static const unsigned int PAGE_SIZE = 4096;
+   static const unsigned int PAGE_HEADER_SIZE = 8;
+   static const unsigned int LEAF_PAGE = 0;
+   static const unsigned int INNER_PAGE = 1;
+   static const char MAGIC[8];
+
+   // Longest key that can be stored, so that an inner page always holds several keys.
+   static const unsigned int MAX_KEY_LENGTH = 1024;
+
+   // Frame of a pinned page, which is not in the cache.
+   static const unsigned int NO_FRAME = 0xFFFFFFFF;
+
+   // Header fields, as in page 0.
+   struct Header {
+      char magic[8];
+      uint32_t pageSize;
+      uint32_t normalization;
+      uint32_t elementCount;
+      uint32_t height;                          // levels of pages, 0 when empty
+      uint32_t rootPage;
+      uint32_t firstLeaf;
+   };
+
+   int fd = -1;
+   Header header;
+   KeyNormalizer normalizer;
+   std::unique_ptr<PageCache> cache;
+   std::unordered_map< uint32_t, std::vector<char> > pinnedPages;
+
+   // Description: Returns the data of page "page", and sets "frame" to the cache
+   //              frame to release() once done with it (NO_FRAME if the page is pinned).
+   // Exception: Throws the exception logic_error if the page cannot be read or is not of kind "kind".
+   const char * fetch(uint32_t page, unsigned int kind, unsigned int & frame) const;
+
+   // Description: Releases the cache frame of a page returned by fetch().
+   void release(unsigned int frame) const;
+
+   // Description: Reads the pages of the top "levels" inner levels into pinnedPages.
+   void pinTopLevels(unsigned int levels);
+
+   // Description: Returns the child of inner page "data" whose keys would include "key".
+   // Time efficiency: O(log2 count)
+   static uint32_t findChild(const char * data, const string & key);
+
+   // Description: Decodes leaf entry "index" of leaf page "data" into an element.
+   static WordPair decodeEntry(const char * data, unsigned int index);
+
+   // Description: Returns "targetElement" with its key normalized by the policy.
+   WordPair makeQuery(const WordPair & targetElement) const;
+
+   // Not copyable.
+   DiskDictionary(const DiskDictionary &) = delete;
+   DiskDictionary & operator=(const DiskDictionary &) = delete;
+
+public:
+
+   // Constructor and destructor
+   // Description: Opens the dictionary file "fileName" with a cache of "cachePages" pages
+   //              evicted by "policy", pinning the top "pinnedLevels" inner levels.
+   // Exception: Throws the exception logic_error if the file cannot be opened
+   //            or is not a dictionary file.
+   DiskDictionary(const string & fileName, unsigned int cachePages = 256,
+                  PageCache::Policy policy = PageCache::LRU, unsigned int pinnedLevels = 2);
+   ~DiskDictionary();
+
+   // Getters
+   unsigned int getElementCount() const;
+   unsigned int getHeight() const;
+   unsigned int getNormalization() const;
+   unsigned int getPinnedPageCount() const;
+   const PageCache & getCache() const;
+
+   // Description: Returns the number of bytes of memory used by the Dictionary.
+   size_t getMemoryUsage() const;
+
+   // Description: Gets the element whose key matches "targetElement".
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Exception: Throws the exception ElementDoesNotExistException
+   //            if the key is not found in the Dictionary.
+   // Exception: Throws the exception logic_error if a page cannot be read.
+   // Time efficiency: O(log n), with at most height - pinned levels page reads
+   WordPair get(const WordPair & targetElement) const;
+
+   // Description: Returns true if the key of "targetElement" is in the Dictionary.
+   // Time efficiency: O(log n)
+   bool contains(const WordPair & targetElement) const;
+
+   // Description: Visits the content of the Dictionary in key order, reading
+   //              each leaf page once.
+   // Precondition: Dictionary is not empty.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Time efficiency: O(n)
+   void displayContent(void visit(WordPair &)) const;
+   void displayContent(const std::function<void(WordPair &)> & visit) const;
+
+}; // end DiskDictionary
+#endif
@@ -0,0 +1,397 @@
+/*
+ * DiskDictionaryBuilder.cpp
+ *
+ * Description: Writes a DiskDictionary file from elements given in key order.
+ *              The tree is built bottom up in one pass: leaf pages are filled
+ *              and written in turn, and each page written adds an entry to
+ *              the inner page being filled on the level above, which is
+ *              written in turn when full. Only one page per level is kept in
+ *              memory, so files much larger than memory can be built from a
+ *              sorted stream of elements; buildFromFile() makes that stream
+ *              from an unsorted data file by an external merge sort.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "DiskDictionaryBuilder.h"
+#include "DictionaryLoader.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+
+// A temporary file, deleted once closed.
+typedef std::unique_ptr<FILE, int (*)(FILE *)> TemporaryFile;
+
+// Description: Appends the 2 bytes of "value" to "data".
+static void append16(std::vector<char> & data, uint16_t value) {
+   char bytes[sizeof(value)];
+   memcpy(bytes, &value, sizeof(value));
+   data.insert(data.end(), bytes, bytes + sizeof(value));
+}
+
+// Description: Appends the 4 bytes of "value" to "data".
+static void append32(std::vector<char> & data, uint32_t value) {
+   char bytes[sizeof(value)];
+   memcpy(bytes, &value, sizeof(value));
+   data.insert(data.end(), bytes, bytes + sizeof(value));
+}
+
+// Description: Writes "value" to "run": its length, then its bytes.
+static void writeString(FILE * run, const string & value) {
+   uint32_t length = value.size();
+   fwrite(&length, sizeof(length), 1, run);
+   fwrite(value.data(), 1, length, run);
+}
+
+// Description: Reads a string written by writeString() from "run" into "value".
+//              Returns false at the end of "run".
+static bool readString(FILE * run, string & value) {
+   uint32_t length;
+   if (fread(&length, sizeof(length), 1, run) != 1) {
+      return false;
+   }
+   value.resize(length);
+   return length == 0 || fread(&value[0], 1, length, run) == length;
+}
+
+// Description: Writes the elements of "run" to a new temporary file, rewound for reading.
+// Exception: Throws the exception logic_error if the file cannot be written.
+static TemporaryFile writeRun(const std::vector<WordPair> & run) {
+
+   TemporaryFile file(std::tmpfile(), fclose);
+   if (file == nullptr)
+      throw std::logic_error("Unable to create a temporary file.");
+   for (const WordPair & element : run) {
+      writeString(file.get(), element.getEnglish());
+      writeString(file.get(), element.getKey());
+      writeString(file.get(), element.getTranslation());
+   }
+   if (fflush(file.get()) != 0 || ferror(file.get()))
+      throw std::logic_error("Unable to write a temporary file.");
+   rewind(file.get());
+   return file;
+}
+
+// Description: Reads the next element written by writeRun() from "run" into "element".
+//              Returns false at the end of "run".
+static bool readElement(FILE * run, WordPair & element) {
+
+   string english, key, translation;
+   if (!readString(run, english) || !readString(run, key) || !readString(run, translation)) {
+      return false;
+   }
+   element = WordPair(english, translation);
+   element.setKey(key);
+   return true;
+}
+
+/* Constructor */
+
+   // Exception: Throws the exception logic_error if the file cannot be created.
+   DiskDictionaryBuilder::DiskDictionaryBuilder(const string & fileName, unsigned int normalization)
+      : file(fileName, std::ios::out | std::ios::binary | std::ios::trunc),
+        fileName(fileName), normalization(normalization) {
+
+      if (!file) {
+         throw std::logic_error("Unable to create file " + fileName + ".");
+      }
+      //the header is written by finish(): until then the file is not a valid dictionary
+      char header[DiskDictionary::PAGE_SIZE] = { };
+      file.write(header, sizeof(header));
+   }
+
+
+/* Getter */
+
+   unsigned int DiskDictionaryBuilder::getElementCount() const {
+      return elementCount;
+   }
+
+
+/* Builder operations */
+
+   // Description: Adds "newElement" after every element already appended.
+   // Exception: Throws the exception logic_error if keys are not appended in increasing order,
+   //            if the key or the element is too long for a page, or after finish().
+   // Time efficiency: O(length of newElement), amortized
+   void DiskDictionaryBuilder::append(const WordPair & newElement) {
+
+      if (finished)
+         throw std::logic_error("The dictionary file is already finished.");
+      const string & key = newElement.getKey();
+      if (elementCount != 0 && !(lastKey < key))
+         throw std::logic_error("Keys must be appended in increasing order.");
+      if (key.size() > DiskDictionary::MAX_KEY_LENGTH)
+         throw std::logic_error("Key too long for a dictionary page: " + key.substr(0, 32) + "...");
+
+      //the English word is only stored when normalization changed it (0 = same as key)
+      const string & english = newElement.getEnglish();
+      const string & translation = newElement.getTranslation();
+      bool sameEnglish = (english == key);
+      size_t length = 6 + key.size() + (sameEnglish ? 0 : english.size()) + translation.size();
+      if (DiskDictionary::PAGE_HEADER_SIZE + 2 + length > DiskDictionary::PAGE_SIZE)
+         throw std::logic_error("Element too long for a dictionary page: " + key.substr(0, 32) + "...");
+
+      if (!leaf.empty && sizeWith(leaf, length) > DiskDictionary::PAGE_SIZE) {
+         flushLeaf();
+      }
+      if (leaf.empty) {
+         //the shortest prefix of "key" greater than the last key of the previous
+         //leaf separates the two leaves, and keeps inner pages short
+         size_t shared = 0;
+         while (shared < key.size() && shared < lastKey.size() && key[shared] == lastKey[shared]) {
+            shared++;
+         }
+         leaf.firstKey = (elementCount == 0) ? string() : key.substr(0, shared + 1);
+         leaf.empty = false;
+      }
+
+      std::vector<char> & entries = leaf.entries;
+      leaf.offsets.push_back(entries.size());
+      append16(entries, key.size());
+      entries.insert(entries.end(), key.begin(), key.end());
+      if (sameEnglish) {
+         append16(entries, 0);
+      }
+      else {
+         append16(entries, english.size() + 1);
+         entries.insert(entries.end(), english.begin(), english.end());
+      }
+      append16(entries, translation.size());
+      entries.insert(entries.end(), translation.begin(), translation.end());
+
+      lastKey = key;
+      elementCount++;
+   }
+
+   // Description: Writes the pages still being filled and the header, and closes the file.
+   // Exception: Throws the exception logic_error if the file cannot be written.
+   void DiskDictionaryBuilder::finish() {
+
+      if (finished) {
+         return;
+      }
+      finished = true;
+      DiskDictionary::Header header;
+      memset(&header, 0, sizeof(header));
+      if (!leaf.empty) {
+         flushLeaf();
+      }
+      //each level is written in turn until one holds a single page: the root
+      for (unsigned int level = 0; level < levels.size(); level++) {
+         if (level == levels.size() - 1 && levels[level].offsets.empty()) {
+            header.rootPage = levels[level].firstChild;
+            header.height = level + 1;
+            break;
+         }
+         flushLevel(level);
+      }
+
+      memcpy(header.magic, DiskDictionary::MAGIC, sizeof(header.magic));
+      header.pageSize = DiskDictionary::PAGE_SIZE;
+      header.normalization = normalization;
+      header.elementCount = elementCount;
+      header.firstLeaf = firstLeaf;
+      file.seekp(0);
+      file.write((const char *) &header, sizeof(header));
+      file.close();
+      if (!file) {
+         throw std::logic_error("Unable to write file " + fileName + ".");
+      }
+   }
+
+   // Description: Writes the content of "source" as the dictionary file "fileName".
+   // Exception: Throws the exception logic_error if the file cannot be written
+   //            or an element is too long for a page.
+   // Time efficiency: O(n)
+   void DiskDictionaryBuilder::build(const Dictionary & source, const string & fileName) {
+
+      DiskDictionaryBuilder builder(fileName, source.getNormalization());
+      if (source.getElementCount() != 0) {
+         //the source is visited in key order, as append() requires
+         source.displayContent([&builder](WordPair & element) {
+            builder.append(element);
+         });
+      }
+      builder.finish();
+   }
+
+
+   // Description: Writes the "english:translation" lines of "dataFileName" as the
+   //              dictionary file "fileName", sorting them by external merge sort.
+   // Exception: Throws the exception logic_error if a file cannot be opened or written,
+   //            or if an element is too long for a page.
+   // Time efficiency: O(n log2 n), with RUN_ELEMENTS elements in memory at most
+   unsigned int DiskDictionaryBuilder::buildFromFile(const string & dataFileName, const string & fileName,
+                                                     unsigned int normalization, std::ostream & log) {
+
+      std::ifstream data(dataFileName);
+      if (!data.is_open())
+         throw std::logic_error("Unable to open file " + dataFileName + ".");
+      DiskDictionaryBuilder builder(fileName, normalization);
+      KeyNormalizer normalizer(normalization);
+      auto byKey = [](const WordPair & left, const WordPair & right) {
+         return left.getKey() < right.getKey();
+      };
+
+      //sorted runs of the data file; the last one stays in memory, the others wait on disk
+      std::vector<TemporaryFile> runs;
+      std::vector<WordPair> run;
+      string nextLine;
+      bool more = true;
+      while (more) {
+         run.clear();
+         while (run.size() < RUN_ELEMENTS && (more = (bool) getline(data, nextLine))) {
+            WordPair element = DictionaryLoader::parse(nextLine);
+            if (!normalizer.isIdentity()) {
+               element.setKey(normalizer.normalize(element.getEnglish()));
+            }
+            run.push_back(element);
+         }
+         //stable, so that of equal keys the first in the data file comes first
+         std::stable_sort(run.begin(), run.end(), byKey);
+         if (more) {
+            runs.push_back(writeRun(run));
+         }
+      }
+
+      //merge the runs; of equal keys, the earlier run (part of the data file) comes first
+      struct Head {
+         WordPair element;
+         size_t run;
+      };
+      auto after = [](const Head & left, const Head & right) {
+         return left.element.getKey() != right.element.getKey()
+              ? left.element.getKey() > right.element.getKey() : left.run > right.run;
+      };
+      std::priority_queue<Head, std::vector<Head>, decltype(after)> heads(after);
+      size_t nextInMemory = 0;
+      auto advance = [&](size_t index) {
+         Head head;
+         head.run = index;
+         if (index < runs.size()) {
+            if (readElement(runs[index].get(), head.element)) {
+               heads.push(head);
+            }
+         }
+         else if (nextInMemory < run.size()) {
+            head.element = run[nextInMemory++];
+            heads.push(head);
+         }
+      };
+      for (size_t index = 0; index <= runs.size(); index++) {
+         advance(index);
+      }
+      while (!heads.empty()) {
+         Head head = heads.top();
+         heads.pop();
+         advance(head.run);
+         if (builder.elementCount != 0 && head.element.getKey() == builder.lastKey) {
+            log << "Skipped " << head.element.getEnglish() << " because its key already exists." << std::endl;
+            continue;
+         }
+         builder.append(head.element);
+      }
+      for (const TemporaryFile & file : runs) {
+         if (ferror(file.get()))
+            throw std::logic_error("Unable to read a temporary file.");
+      }
+      builder.finish();
+      return builder.getElementCount();
+   }
+
+
+/* Utility methods */
+
+   // Description: Returns the number of bytes "buffer" would take as a page with
+   //              one more entry of "entryLength" bytes.
+   size_t DiskDictionaryBuilder::sizeWith(const PageBuffer & buffer, size_t entryLength) {
+      return DiskDictionary::PAGE_HEADER_SIZE + 2 * (buffer.offsets.size() + 1)
+           + buffer.entries.size() + entryLength;
+   }
+
+   // Description: Writes "buffer" as the next page of the file, of kind "kind",
+   //              linked to "link", and returns its page number.
+   // Exception: Throws the exception logic_error if the file cannot be written.
+   uint32_t DiskDictionaryBuilder::writePage(const PageBuffer & buffer, unsigned int kind, uint32_t link) {
+
+      char page[DiskDictionary::PAGE_SIZE] = { };
+      uint16_t count = buffer.offsets.size();
+      memcpy(page, &count, sizeof(count));
+      page[2] = (char) kind;
+      memcpy(page + 4, &link, sizeof(link));
+      unsigned int start = DiskDictionary::PAGE_HEADER_SIZE + 2 * count;
+      for (unsigned int i = 0; i < count; i++) {
+         uint16_t offset = start + buffer.offsets[i];
+         memcpy(page + DiskDictionary::PAGE_HEADER_SIZE + 2 * i, &offset, sizeof(offset));
+      }
+      if (!buffer.entries.empty()) {
+         memcpy(page + start, buffer.entries.data(), buffer.entries.size());
+      }
+      file.write(page, sizeof(page));
+      if (!file) {
+         throw std::logic_error("Unable to write file " + fileName + ".");
+      }
+      return pageCount++;
+   }
+
+   // Description: Writes the leaf being filled and adds it to the level above.
+   void DiskDictionaryBuilder::flushLeaf() {
+
+      uint32_t page = writePage(leaf, DiskDictionary::LEAF_PAGE, 0);
+      if (firstLeaf == 0) {
+         firstLeaf = page;
+      }
+      else {
+         //inner pages may have been written since the previous leaf, so its
+         //link to this one is only known now
+         file.seekp((std::streamoff) previousLeaf * DiskDictionary::PAGE_SIZE + 4);
+         file.write((const char *) &page, sizeof(page));
+         file.seekp(0, std::ios::end);
+      }
+      previousLeaf = page;
+      string separator;
+      separator.swap(leaf.firstKey);
+      leaf = PageBuffer();
+      addChild(0, separator, page);
+   }
+
+   // Description: Adds child page "page", whose keys start at "separator", to
+   //              the inner page being filled on level "level", writing that
+   //              page first if it is full.
+   void DiskDictionaryBuilder::addChild(unsigned int level, const string & separator, uint32_t page) {
+
+      if (levels.size() == level) {
+         levels.emplace_back();
+      }
+      if (!levels[level].empty && sizeWith(levels[level], 6 + separator.size()) > DiskDictionary::PAGE_SIZE) {
+         flushLevel(level);
+      }
+      //"levels" may have grown, so the buffer is only looked up now
+      PageBuffer & buffer = levels[level];
+      if (buffer.empty) {
+         //the first child's separator is not stored here but in the level above
+         buffer.firstChild = page;
+         buffer.firstKey = separator;
+         buffer.empty = false;
+         return;
+      }
+      buffer.offsets.push_back(buffer.entries.size());
+      append32(buffer.entries, page);
+      append16(buffer.entries, separator.size());
+      buffer.entries.insert(buffer.entries.end(), separator.begin(), separator.end());
+   }
+
+   // Description: Writes the inner page being filled on level "level" and adds it to the level above.
+   void DiskDictionaryBuilder::flushLevel(unsigned int level) {
+
+      uint32_t page = writePage(levels[level], DiskDictionary::INNER_PAGE, levels[level].firstChild);
+      string separator;
+      separator.swap(levels[level].firstKey);
+      levels[level] = PageBuffer();
+      addChild(level + 1, separator, page);
+   }
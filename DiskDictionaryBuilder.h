@@ -0,0 +1,124 @@
+/*
+ * DiskDictionaryBuilder.h
+ *
+ * Description: Writes a DiskDictionary file from elements given in key order.
+ *              The tree is built bottom up in one pass: leaf pages are filled
+ *              and written in turn, and each page written adds an entry to
+ *              the inner page being filled on the level above, which is
+ *              written in turn when full. Only one page per level is kept in
+ *              memory, so files much larger than memory can be built from a
+ *              sorted stream of elements; buildFromFile() makes that stream
+ *              from an unsorted data file by an external merge sort.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef DISK_DICTIONARY_BUILDER_H
+#define DISK_DICTIONARY_BUILDER_H
+
+#include "Dictionary.h"
+#include "DiskDictionary.h"
+#include "WordPair.h"
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <vector>
+
+class DiskDictionaryBuilder {
+
+public:
+
+   // Elements that buildFromFile() sorts in memory at a time.
+   static const size_t RUN_ELEMENTS = 1 << 18;
+
+private:
+
+   // The page being filled on one level of the tree.
+   struct PageBuffer {
+      std::vector<char> entries;
+      std::vector<uint16_t> offsets;            // of the entries, relative to "entries"
+      uint32_t firstChild = 0;                  // inner pages: child 0
+      string firstKey;                          // separator of the page's first child or element
+      bool empty = true;
+   };
+
+   std::ofstream file;
+   string fileName;
+   unsigned int normalization;
+   unsigned int elementCount = 0;
+   uint32_t pageCount = 1;                      // page 0 is the header
+   uint32_t firstLeaf = 0;
+   uint32_t previousLeaf = 0;                   // last leaf written, to link it to the next
+   PageBuffer leaf;
+   std::vector<PageBuffer> levels;              // inner pages, level above the leaves first
+   string lastKey;                              // last key appended
+   bool finished = false;
+
+   // Description: Returns the number of bytes "buffer" would take as a page with
+   //              one more entry of "entryLength" bytes.
+   static size_t sizeWith(const PageBuffer & buffer, size_t entryLength);
+
+   // Description: Writes "buffer" as the next page of the file, of kind "kind",
+   //              linked to "link", and returns its page number.
+   uint32_t writePage(const PageBuffer & buffer, unsigned int kind, uint32_t link);
+
+   // Description: Writes the leaf being filled and adds it to the level above.
+   void flushLeaf();
+
+   // Description: Adds child page "page", whose keys start at "separator", to
+   //              the inner page being filled on level "level", writing that
+   //              page first if it is full.
+   void addChild(unsigned int level, const string & separator, uint32_t page);
+
+   // Description: Writes the inner page being filled on level "level" and adds it to the level above.
+   void flushLevel(unsigned int level);
+
+   // Not copyable.
+   DiskDictionaryBuilder(const DiskDictionaryBuilder &) = delete;
+   DiskDictionaryBuilder & operator=(const DiskDictionaryBuilder &) = delete;
+
+public:
+
+   // Constructor
+   // Description: Starts the file "fileName" for keys that follow the
+   //              "normalization" policy (KeyNormalizer flags).
+   // Exception: Throws the exception logic_error if the file cannot be created.
+   DiskDictionaryBuilder(const string & fileName, unsigned int normalization = KeyNormalizer::NONE);
+
+   // Description: Returns the number of elements appended so far.
+   unsigned int getElementCount() const;
+
+   // Description: Adds "newElement" after every element already appended.
+   //              Its key must already follow the normalization policy.
+   // Precondition: The key of "newElement" is greater than every key appended so far.
+   // Exception: Throws the exception logic_error if keys are not appended in increasing order,
+   //            if the key or the element is too long for a page, or after finish().
+   // Time efficiency: O(length of newElement), amortized
+   void append(const WordPair & newElement);
+
+   // Description: Writes the pages still being filled and the header, and closes the file.
+   // Exception: Throws the exception logic_error if the file cannot be written.
+   void finish();
+
+   // Description: Writes the content of "source" as the dictionary file "fileName".
+   // Exception: Throws the exception logic_error if the file cannot be written
+   //            or an element is too long for a page.
+   // Time efficiency: O(n)
+   static void build(const Dictionary & source, const string & fileName);
+
+   // Description: Writes the "english:translation" lines of "dataFileName" as the
+   //              dictionary file "fileName", with keys following the "normalization"
+   //              policy, without loading the data file into a Dictionary: its lines
+   //              are sorted in runs of RUN_ELEMENTS, kept in temporary files, whose
+   //              merge is appended. Of the lines with the same key, the first in the
+   //              data file is kept and the others are reported on "log".
+   //              Returns the number of elements written.
+   // Exception: Throws the exception logic_error if a file cannot be opened or written,
+   //            or if an element is too long for a page.
+   // Time efficiency: O(n log2 n), with RUN_ELEMENTS elements in memory at most
+   static unsigned int buildFromFile(const string & dataFileName, const string & fileName,
+                                     unsigned int normalization, std::ostream & log);
+
+}; // end DiskDictionaryBuilder
+#endif
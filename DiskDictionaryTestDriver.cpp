@@ -0,0 +1,197 @@
+/*
+ * DiskDictionaryTestDriver.cpp
+ *
+ * Description: Drives the testing of the DiskDictionary ADT class. Dictionary
+ *              files are written from an in-memory Dictionary and, by external
+ *              merge sort, straight from a data file; lookups and traversals of
+ *              the B+ tree on disk, through a cache of a few pages, are checked
+ *              against the Dictionary holding the same words.
+ *              Prints one line per check and returns the number of failures.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Dictionary.h"
+#include "DictionaryLoader.h"
+#include "DiskDictionary.h"
+#include "DiskDictionaryBuilder.h"
+#include "KeyNormalizer.h"
+#include "TestReport.h"
+#include "WordPair.h"
+#include "ElementDoesNotExistException.h"
+#include "EmptyDataCollectionException.h"
+
+using std::vector;
+
+// Files written by the tests, removed at the end.
+static const string DATA_FILE = "diskTestDriver.txt";
+static const string DISK_FILE = "diskTestDriver.pages";
+static const string SECOND_DISK_FILE = "diskTestDriver2.pages";
+
+// Few pages, so that most lookups read theirs from the file.
+static const unsigned int CACHE_PAGES = 8;
+
+static TestReport report;
+
+// Description: Returns the elements of "myWords" in key order.
+vector<WordPair> contentOf(const Dictionary & myWords) {
+
+  vector<WordPair> content;
+  if (myWords.getElementCount() != 0) {
+     myWords.displayContent([&content](WordPair & anElement) {
+        content.push_back(anElement);
+     });
+  }
+  return content;
+}
+
+// Description: Returns true if "onDisk" holds exactly "expected", the content of
+//              a Dictionary in key order, found by get and by the traversal.
+//              Every "step"th element is looked up, and as many absent keys.
+bool matches(const DiskDictionary & onDisk, const vector<WordPair> & expected, unsigned int step) {
+
+  if (onDisk.getElementCount() != expected.size()) {
+     return false;
+  }
+  unsigned int visited = 0;
+  bool passed = true;
+  onDisk.displayContent([&](WordPair & anElement) {
+     if (visited >= expected.size() || anElement.getEnglish() != expected[visited].getEnglish()
+         || anElement.getTranslation() != expected[visited].getTranslation()) {
+        passed = false;
+     }
+     visited++;
+  });
+  passed = passed && visited == expected.size();
+  for (unsigned int i = 0; passed && i < expected.size(); i += step) {
+     try {
+        WordPair found = onDisk.get(WordPair(expected[i].getEnglish()));
+        passed = found.getEnglish() == expected[i].getEnglish()
+                 && found.getTranslation() == expected[i].getTranslation();
+     }
+     catch (ElementDoesNotExistException& anException) {
+        passed = false;
+     }
+     //a key just past this one, and one past every key
+     passed = passed && !onDisk.contains(WordPair(expected[i].getEnglish() + "~"))
+              && !onDisk.contains(WordPair("~" + expected[i].getEnglish()));
+  }
+  return passed;
+}
+
+// Description: Writes a Dictionary of words whose translations vary in length,
+//              so that pages hold few or many entries, and checks its file
+//              under both eviction policies, with and without pinned levels.
+void testBuildFromDictionary() {
+
+  Dictionary myWords;
+  vector<unsigned int> order(30000);
+  for (unsigned int i = 0; i < order.size(); i++) {
+     order[i] = i;
+  }
+  std::mt19937 generator(2023);
+  std::shuffle(order.begin(), order.end(), generator);
+  for (unsigned int i : order) {
+     WordPair aWord("word" + std::to_string(i), string(1 + generator() % 200, 'a' + i % 26));
+     myWords.put(aWord);
+  }
+  DiskDictionaryBuilder::build(myWords, DISK_FILE);
+  vector<WordPair> expected = contentOf(myWords);
+
+  bool passed = true;
+  PageCache::Policy policies[] = { PageCache::LRU, PageCache::CLOCK };
+  for (PageCache::Policy policy : policies) {
+     for (unsigned int pinnedLevels = 0; pinnedLevels <= 2; pinnedLevels += 2) {
+        DiskDictionary onDisk(DISK_FILE, CACHE_PAGES, policy, pinnedLevels);
+        passed = passed && onDisk.getHeight() > 1 && matches(onDisk, expected, 1);
+        passed = passed && onDisk.getCache().getReadCount() > onDisk.getCache().getCapacity();
+     }
+  }
+  report.check("lookups in a file built from a Dictionary", passed);
+}
+
+// Description: Checks that a file built from an empty Dictionary opens, and
+//              that a get on it throws EmptyDataCollectionException.
+void testEmpty() {
+
+  Dictionary myWords;
+  DiskDictionaryBuilder::build(myWords, DISK_FILE);
+  DiskDictionary onDisk(DISK_FILE, CACHE_PAGES);
+  bool passed = (onDisk.getElementCount() == 0) && !onDisk.contains(WordPair("food"));
+  try {
+     onDisk.get(WordPair("food"));
+     passed = false;
+  }
+  catch (EmptyDataCollectionException& anException) { }
+  report.check("an empty dictionary file", passed);
+}
+
+// Description: Writes a data file of more lines than a sorted run holds, with
+//              keys differing in case only and repeated keys, builds it without
+//              loading it, and checks it against a Dictionary loaded from the
+//              same file under the same normalization: the same words must be
+//              kept, and the two files must be the same byte for byte.
+void testBuildFromFile() {
+
+  const unsigned int lineCount = 300000;
+  std::mt19937 generator(2023);
+  std::ofstream data(DATA_FILE);
+  unsigned int duplicates = 0;
+  for (unsigned int i = 0; i < lineCount; i++) {
+     unsigned int word = generator() % (lineCount - lineCount / 20);
+     string english = "Word" + std::to_string(word);
+     if (i % 3 == 0) {
+        std::transform(english.begin(), english.end(), english.begin(), ::toupper);
+     }
+     data << english << ":translation" << i << "\n";
+  }
+  data.close();
+
+  Dictionary myWords;
+  myWords.setNormalization(KeyNormalizer::ALL);
+  std::ostringstream loadLog;
+  DictionaryLoader::load(DATA_FILE, myWords, loadLog);
+  std::ostringstream buildLog;
+  unsigned int written = DiskDictionaryBuilder::buildFromFile(DATA_FILE, DISK_FILE, KeyNormalizer::ALL, buildLog);
+  for (char c : buildLog.str()) {
+     if (c == '\n') duplicates++;
+  }
+  DiskDictionaryBuilder::build(myWords, SECOND_DISK_FILE);
+
+  bool passed = (written == myWords.getElementCount()) && (written + duplicates == lineCount);
+  {
+     DiskDictionary onDisk(DISK_FILE, CACHE_PAGES);
+     passed = passed && onDisk.getNormalization() == KeyNormalizer::ALL
+              && matches(onDisk, contentOf(myWords), 7)
+              && onDisk.contains(WordPair("word3")) == onDisk.contains(WordPair("WORD3"));
+  }
+  std::ifstream fromFile(DISK_FILE, std::ios::binary);
+  std::ifstream fromDictionary(SECOND_DISK_FILE, std::ios::binary);
+  std::ostringstream first, second;
+  first << fromFile.rdbuf();
+  second << fromDictionary.rdbuf();
+  passed = passed && first.str() == second.str();
+  report.check("a file sorted from a data file matches a Dictionary's", passed);
+}
+
+int main() {
+
+  testBuildFromDictionary();
+  testEmpty();
+  testBuildFromFile();
+
+  std::remove(DATA_FILE.c_str());
+  std::remove(DISK_FILE.c_str());
+  std::remove(SECOND_DISK_FILE.c_str());
+  return report.summarize();
+}
@@ -0,0 +1,339 @@
+/*
+ * FrontCodedDictionary.cpp
+ * 
+ * Description: Read-only, compact Dictonary data collection ADT class.
+ *              Keys are kept in sorted blocks of BLOCK_SIZE keys. The first
+ *              key of a block is stored whole; each other key is stored as
+ *              the length of the prefix it shares with the previous key plus
+ *              the remaining suffix (front coding). Lengths are varints.
+ *              Translations are packed back to back in a single byte array.
+ *              A lookup binary searches the block heads, then decodes at
+ *              most one block.
+ *              Duplicated elements not allowed.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "FrontCodedDictionary.h"
+#include <stdexcept>
+
+// Description: Appends "value" to "data" as a varint (7 bits per byte, low bits first).
+static void writeVarint(std::vector<char> & data, size_t value) {
+   while (value >= 0x80) {
+      data.push_back((char) (0x80 | (value & 0x7F)));
+      value >>= 7;
+   }
+   data.push_back((char) value);
+}
+
+// Description: Reads the varint at "position" of "data" and moves "position" past it.
+static size_t readVarint(const std::vector<char> & data, size_t & position) {
+   size_t value = 0;
+   int shift = 0;
+   unsigned char byte;
+   do {
+      byte = data[position++];
+      value |= (size_t) (byte & 0x7F) << shift;
+      shift += 7;
+   } while (byte & 0x80);
+   return value;
+}
+
+// Description: Appends "text" to "data" preceded by its length.
+static void writeString(std::vector<char> & data, const string & text) {
+   writeVarint(data, text.size());
+   data.insert(data.end(), text.begin(), text.end());
+}
+
+/* Constructors */
+
+   FrontCodedDictionary::FrontCodedDictionary(unsigned int normalization) : normalizer(normalization) { }
+
+   // Time efficiency: O(n)
+   FrontCodedDictionary::FrontCodedDictionary(const Dictionary & source)
+      : normalizer(source.getNormalization()) {
+
+      if (source.getElementCount() != 0) {
+         //the source is visited in key order, as append() requires
+         source.displayContent([this](WordPair & element) {
+            append(element);
+         });
+      }
+      shrinkToFit();
+   }
+
+   // Time efficiency: O(n + m) for a "delta" of m elements
+   FrontCodedDictionary::FrontCodedDictionary(const FrontCodedDictionary & base, const Dictionary & delta)
+      : normalizer(base.normalizer) {
+
+      //the delta is small: it is taken out first, then slotted in while the base streams by
+      std::vector<WordPair> added;
+      added.reserve(delta.getElementCount());
+      if (delta.getElementCount() != 0) {
+         delta.displayContent([&added](WordPair & element) {
+            added.push_back(element);
+         });
+      }
+      keyData.reserve(base.keyData.size());
+      valueData.reserve(base.valueData.size());
+      size_t next = 0;
+      string key;
+      size_t keyPosition = 0;
+      size_t valuePosition = 0;
+      for (unsigned int i = 0; i < base.elementCount; i++) {
+         size_t shared = (i % BLOCK_SIZE == 0) ? 0 : readVarint(base.keyData, keyPosition);
+         size_t suffix = readVarint(base.keyData, keyPosition);
+         key.resize(shared);
+         key.append(base.keyData.data() + keyPosition, suffix);
+         keyPosition += suffix;
+         while (next < added.size() && added[next].getKey() < key) {
+            append(added[next++]);
+         }
+
+         //only the keys are coded against their neighbours: the values of the
+         //base are copied as they are, without decoding them into elements
+         size_t valueStart = valuePosition;
+         size_t englishLength = readVarint(base.valueData, valuePosition);
+         if (englishLength > 0) {
+            valuePosition += englishLength - 1;
+         }
+         size_t translationLength = readVarint(base.valueData, valuePosition);
+         valuePosition += translationLength;
+         appendKey(key);
+         valueData.insert(valueData.end(), base.valueData.begin() + valueStart,
+                          base.valueData.begin() + valuePosition);
+      }
+      while (next < added.size()) {
+         append(added[next++]);
+      }
+      shrinkToFit();
+   }
+
+
+/* Getters */
+
+   // Description: Returns the number of elements stored in the Dictionary.
+   // Time efficiency: O(1)
+   unsigned int FrontCodedDictionary::getElementCount() const {
+      return elementCount;
+   }
+
+   // Description: Returns the number of bytes used by the Dictionary's data.
+   // Time efficiency: O(1)
+   size_t FrontCodedDictionary::getMemoryUsage() const {
+      return sizeof(*this) + keyData.capacity() + valueData.capacity()
+           + (keyBlockOffsets.capacity() + valueBlockOffsets.capacity()) * sizeof(size_t)
+           + lastKey.capacity();
+   }
+
+
+/* Dictionary operations */
+
+   // Description: Adds "newElement" after every element already appended.
+   // Exception: Throws the exception logic_error if keys are not appended in increasing order.
+   // Time efficiency: O(length of newElement)
+   void FrontCodedDictionary::append(const WordPair & newElement) {
+
+      const string & key = newElement.getKey();
+      appendKey(key);
+
+      //the English word is only stored when normalization changed it (0 = same as key)
+      const string & english = newElement.getEnglish();
+      if (english == key) {
+         writeVarint(valueData, 0);
+      }
+      else {
+         writeVarint(valueData, english.size() + 1);
+         valueData.insert(valueData.end(), english.begin(), english.end());
+      }
+      writeString(valueData, newElement.getTranslation());
+   }
+
+   // Description: Gets the element whose key matches "targetElement".
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Exception: Throws the exception ElementDoesNotExistException
+   //            if the key is not found in the Dictionary.
+   // Time efficiency: O(log2 n + BLOCK_SIZE)
+   WordPair FrontCodedDictionary::get(const WordPair & targetElement) const {
+
+      if (elementCount == 0)
+         throw EmptyDataCollectionException("Dictionary is empty.");
+
+      WordPair found;
+      if (!findKey(makeQuery(targetElement).getKey(), found))
+         throw ElementDoesNotExistException("***Not Found!***");
+      return found;
+   }
+
+   // Description: Returns true if the key of "targetElement" is in the Dictionary.
+   // Time efficiency: O(log2 n + BLOCK_SIZE)
+   bool FrontCodedDictionary::contains(const WordPair & targetElement) const {
+
+      //a miss is the common case of a put into a TieredDictionary, so it throws nothing
+      WordPair found;
+      return elementCount != 0 && findKey(makeQuery(targetElement).getKey(), found);
+   }
+
+   // Description: Visits the content of the Dictionary in key order.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   void FrontCodedDictionary::displayContent(void visit(WordPair &)) const {
+      displayContent(std::function<void(WordPair &)>(visit));
+   }
+
+   // Description: Visits the content of the Dictionary in key order.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Time efficiency: O(n)
+   void FrontCodedDictionary::displayContent(const std::function<void(WordPair &)> & visit) const {
+
+      if (elementCount == 0)
+         throw EmptyDataCollectionException("Dictionary is empty.");
+
+      for (unsigned int block = 0; block < keyBlockOffsets.size(); block++) {
+         decodeBlock(block, [&visit](WordPair & element) {
+            visit(element);
+            return true;
+         });
+      }
+   }
+
+
+/* Utility methods */
+
+   // Description: Returns the block that would hold "key": the last block whose
+   //              first key is not greater than "key" (block 0 if there is none).
+   // Time efficiency: O(log2 (n / BLOCK_SIZE))
+   unsigned int FrontCodedDictionary::findBlock(const string & key) const {
+
+      unsigned int low = 0;
+      unsigned int high = keyBlockOffsets.size();
+      //invariant: every block before "low" starts with a key <= "key", none from "high" does
+      while (low < high) {
+         unsigned int middle = low + (high - low) / 2;
+         size_t position = keyBlockOffsets[middle];
+         size_t length = readVarint(keyData, position);
+         if (key.compare(0, key.size(), keyData.data() + position, length) >= 0) {
+            low = middle + 1;
+         }
+         else {
+            high = middle;
+         }
+      }
+      return (low == 0) ? 0 : low - 1;
+   }
+
+   // Description: Returns true, with its element in "found", if "key" is in the Dictionary.
+   // Precondition: Dictionary is not empty and "key" follows the normalization policy.
+   // Time efficiency: O(log2 n + BLOCK_SIZE)
+   bool FrontCodedDictionary::findKey(const string & key, WordPair & found) const {
+
+      unsigned int block = findBlock(key);
+
+      //decode keys only; values are skipped until the key is found
+      size_t keyPosition = keyBlockOffsets[block];
+      size_t valuePosition = valueBlockOffsets[block];
+      unsigned int last = (block + 1) * BLOCK_SIZE < elementCount ? BLOCK_SIZE : elementCount - block * BLOCK_SIZE;
+      string current;
+      for (unsigned int i = 0; i < last; i++) {
+         size_t shared = (i == 0) ? 0 : readVarint(keyData, keyPosition);
+         size_t suffix = readVarint(keyData, keyPosition);
+         current.resize(shared);
+         current.append(keyData.data() + keyPosition, suffix);
+         keyPosition += suffix;
+
+         int comparison = current.compare(key);
+         if (comparison > 0) {
+            return false;
+         }
+         size_t englishLength = readVarint(valueData, valuePosition);
+         size_t englishPosition = valuePosition;
+         if (englishLength > 0) {
+            valuePosition += englishLength - 1;
+         }
+         size_t translationLength = readVarint(valueData, valuePosition);
+         if (comparison == 0) {
+            found = WordPair(englishLength == 0 ? current : string(valueData.data() + englishPosition, englishLength - 1),
+                             string(valueData.data() + valuePosition, translationLength));
+            found.setKey(current);
+            return true;
+         }
+         valuePosition += translationLength;
+      }
+      return false;
+   }
+
+   // Description: Decodes every element of block "block", calling "visit" on each,
+   //              until "visit" returns false.
+   void FrontCodedDictionary::decodeBlock(unsigned int block, const std::function<bool(WordPair &)> & visit) const {
+
+      size_t keyPosition = keyBlockOffsets[block];
+      size_t valuePosition = valueBlockOffsets[block];
+      unsigned int last = (block + 1) * BLOCK_SIZE < elementCount ? BLOCK_SIZE : elementCount - block * BLOCK_SIZE;
+      string current;
+      for (unsigned int i = 0; i < last; i++) {
+         size_t shared = (i == 0) ? 0 : readVarint(keyData, keyPosition);
+         size_t suffix = readVarint(keyData, keyPosition);
+         current.resize(shared);
+         current.append(keyData.data() + keyPosition, suffix);
+         keyPosition += suffix;
+
+         size_t englishLength = readVarint(valueData, valuePosition);
+         string english = (englishLength == 0) ? current : string(valueData.data() + valuePosition, englishLength - 1);
+         if (englishLength > 0) {
+            valuePosition += englishLength - 1;
+         }
+         size_t translationLength = readVarint(valueData, valuePosition);
+         WordPair element(english, string(valueData.data() + valuePosition, translationLength));
+         valuePosition += translationLength;
+         element.setKey(current);
+         if (!visit(element)) {
+            return;
+         }
+      }
+   }
+
+   // Description: Adds "key" after every key already appended, and starts a block
+   //              if it is the first of one. Its value must be appended next.
+   // Exception: Throws the exception logic_error if keys are not appended in increasing order.
+   void FrontCodedDictionary::appendKey(const string & key) {
+
+      if (elementCount != 0 && !(lastKey < key))
+         throw std::logic_error("Keys must be appended in increasing order.");
+
+      if (elementCount % BLOCK_SIZE == 0) {
+         //a block starts with a whole key, so that it can be searched on its own
+         keyBlockOffsets.push_back(keyData.size());
+         valueBlockOffsets.push_back(valueData.size());
+         writeString(keyData, key);
+      }
+      else {
+         size_t shared = 0;
+         while (shared < key.size() && shared < lastKey.size() && key[shared] == lastKey[shared]) {
+            shared++;
+         }
+         writeVarint(keyData, shared);
+         writeVarint(keyData, key.size() - shared);
+         keyData.insert(keyData.end(), key.begin() + shared, key.end());
+      }
+      lastKey = key;
+      elementCount++;
+   }
+
+   // Description: Releases the room left at the end of the arrays by append().
+   void FrontCodedDictionary::shrinkToFit() {
+      keyData.shrink_to_fit();
+      valueData.shrink_to_fit();
+      keyBlockOffsets.shrink_to_fit();
+      valueBlockOffsets.shrink_to_fit();
+   }
+
+   // Description: Returns "targetElement" with its key normalized by the policy.
+   WordPair FrontCodedDictionary::makeQuery(const WordPair & targetElement) const {
+
+      if (normalizer.isIdentity()) {
+         return targetElement;
+      }
+      WordPair query;
+      query.setKey(normalizer.normalize(targetElement.getEnglish()));
+      return query;
+   }
@@ -0,0 +1,117 @@
+/*
+ * FrontCodedDictionary.h
+ * 
+ * Description: Read-only, compact Dictonary data collection ADT class.
+ *              Keys are kept in sorted blocks of BLOCK_SIZE keys. The first
+ *              key of a block is stored whole; each other key is stored as
+ *              the length of the prefix it shares with the previous key plus
+ *              the remaining suffix (front coding). Lengths are varints.
+ *              Translations are packed back to back in a single byte array.
+ *              A lookup binary searches the block heads, then decodes at
+ *              most one block.
+ *              Duplicated elements not allowed.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef FRONT_CODED_DICTIONARY_H
+#define FRONT_CODED_DICTIONARY_H
+
+#include "Dictionary.h"
+#include "KeyNormalizer.h"
+#include "WordPair.h"
+#include <functional>
+#include <vector>
+
+class FrontCodedDictionary {
+
+private:
+
+   // Keys per block: larger blocks compress better but take longer to decode.
+   static const unsigned int BLOCK_SIZE = 16;
+
+   std::vector<char> keyData;               // front-coded keys, block after block
+   std::vector<char> valueData;             // English word (if it differs from the key) and translation
+   std::vector<size_t> keyBlockOffsets;     // where each block starts in keyData
+   std::vector<size_t> valueBlockOffsets;   // where each block starts in valueData
+   unsigned int elementCount = 0;
+   string lastKey;                          // last key appended, to front code the next one
+   KeyNormalizer normalizer;
+
+   // Description: Returns the block that would hold "key": the last block whose
+   //              first key is not greater than "key".
+   // Time efficiency: O(log2 (n / BLOCK_SIZE))
+   unsigned int findBlock(const string & key) const;
+
+   // Description: Returns true, with its element in "found", if "key" is in the Dictionary.
+   // Precondition: Dictionary is not empty and "key" follows the normalization policy.
+   // Time efficiency: O(log2 n + BLOCK_SIZE)
+   bool findKey(const string & key, WordPair & found) const;
+
+   // Description: Decodes every element of block "block", calling "visit" on each,
+   //              until "visit" returns false.
+   void decodeBlock(unsigned int block, const std::function<bool(WordPair &)> & visit) const;
+
+   // Description: Adds "key" after every key already appended, and starts a block
+   //              if it is the first of one. Its value must be appended next.
+   // Exception: Throws the exception logic_error if keys are not appended in increasing order.
+   void appendKey(const string & key);
+
+   // Description: Releases the room left at the end of the arrays by append().
+   void shrinkToFit();
+
+   // Description: Returns "targetElement" with its key normalized by the policy.
+   WordPair makeQuery(const WordPair & targetElement) const;
+
+public:
+
+   // Constructors
+   // An empty Dictionary whose keys follow the "normalization" policy (KeyNormalizer flags),
+   // to be filled with append().
+   FrontCodedDictionary(unsigned int normalization = KeyNormalizer::NONE);
+
+   // A compact copy of "source", with the same normalization policy.
+   // Time efficiency: O(n)
+   FrontCodedDictionary(const Dictionary & source);
+
+   // A compact copy of the elements of "base" and of "delta" together, in one
+   // pass over "base" - how a TieredDictionary folds its delta into its base.
+   // Precondition: "delta" has the normalization policy of "base" and no key of "base".
+   // Exception: Throws the exception logic_error if a key is in both.
+   // Time efficiency: O(n + m) for a "delta" of m elements
+   FrontCodedDictionary(const FrontCodedDictionary & base, const Dictionary & delta);
+
+   // Description: Returns the number of elements stored in the Dictionary.
+   unsigned int getElementCount() const;
+
+   // Description: Returns the number of bytes used by the Dictionary's data.
+   size_t getMemoryUsage() const;
+
+   // Description: Adds "newElement" after every element already appended.
+   //              Its key must already follow the normalization policy.
+   // Precondition: The key of "newElement" is greater than every key appended so far.
+   // Exception: Throws the exception logic_error if keys are not appended in increasing order.
+   // Time efficiency: O(length of newElement)
+   void append(const WordPair & newElement);
+
+   // Description: Gets the element whose key matches "targetElement".
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Exception: Throws the exception ElementDoesNotExistException
+   //            if the key is not found in the Dictionary.
+   // Time efficiency: O(log2 n + BLOCK_SIZE)
+   WordPair get(const WordPair & targetElement) const;
+
+   // Description: Returns true if the key of "targetElement" is in the Dictionary.
+   // Time efficiency: O(log2 n + BLOCK_SIZE)
+   bool contains(const WordPair & targetElement) const;
+
+   // Description: Visits the content of the Dictionary in key order.
+   // Precondition: Dictionary is not empty.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Time efficiency: O(n)
+   void displayContent(void visit(WordPair &)) const;
+   void displayContent(const std::function<void(WordPair &)> & visit) const;
+
+}; // end FrontCodedDictionary
+#endif
@@ -0,0 +1,187 @@
+/*
+ * FrontCodedDictionaryTestDriver.cpp
+ *
+ * Description: Drives the testing of the FrontCodedDictionary ADT class.
+ *              Compact copies of Dictionaries, and merges of one with a
+ *              delta, are checked against a std::map holding what they
+ *              should. Keys share long prefixes and some keys and
+ *              translations are longer than a one byte length, so that
+ *              every block decodes prefixes and varints of both sizes.
+ *              Prints one line per check and returns the number of failures.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include "FrontCodedDictionary.h"
+#include "Dictionary.h"
+#include "KeyNormalizer.h"
+#include "TestReport.h"
+#include "WordPair.h"
+#include "ElementDoesNotExistException.h"
+#include "EmptyDataCollectionException.h"
+
+static TestReport report;
+
+// Description: Returns a random key, most of which share a long prefix with others.
+string randomKey(std::mt19937 & generator) {
+
+  const string stems[] = { "", "inter", "international", string(150, 'x') };
+  string key = stems[generator() % 4];
+  unsigned int tail = 1 + generator() % 5;
+  for (unsigned int i = 0; i < tail; i++) {
+     key += (char) ('a' + generator() % 26);
+  }
+  return key;
+}
+
+// Description: Puts up to "count" random words into "myWords" and "model",
+//              skipping keys already in "model".
+void putRandomWords(Dictionary & myWords, std::map<string, string> & model, unsigned int count,
+                    std::mt19937 & generator) {
+
+  for (unsigned int i = 0; i < count; i++) {
+     string english = randomKey(generator);
+     if (model.find(english) != model.end()) {
+        continue;
+     }
+     string translation = string(generator() % 3 == 0 ? 200 : 1, 't') + std::to_string(i);
+     WordPair aWord(english, translation);
+     myWords.put(aWord);
+     model[english] = translation;
+  }
+}
+
+// Description: Returns true if "compact" holds exactly the content of "model", in
+//              key order, found by get(); keys next to each key must be absent.
+bool holdsExactly(const FrontCodedDictionary & compact, const std::map<string, string> & model) {
+
+  if (compact.getElementCount() != model.size()) {
+     return false;
+  }
+  bool passed = true;
+  auto next = model.begin();
+  compact.displayContent([&passed, &next, &model](WordPair & anElement) {
+     if (next == model.end() || anElement.getEnglish() != next->first
+         || anElement.getTranslation() != next->second) {
+        passed = false;
+     }
+     else {
+        next++;
+     }
+  });
+  passed = passed && next == model.end();
+  for (auto entry = model.begin(); passed && entry != model.end(); entry++) {
+     try {
+        WordPair found = compact.get(WordPair(entry->first));
+        passed = found.getEnglish() == entry->first && found.getTranslation() == entry->second;
+     }
+     catch (ElementDoesNotExistException& anException) {
+        passed = false;
+     }
+     //a key just before this one, and one just after
+     string before = entry->first.substr(0, entry->first.size() - 1);
+     passed = passed && (model.count(before) == 1 || !compact.contains(WordPair(before)))
+              && !compact.contains(WordPair(entry->first + "\x01"));
+  }
+  return passed;
+}
+
+// Description: Checks a compact copy of an empty Dictionary and of a random one.
+void testCopy() {
+
+  Dictionary empty;
+  FrontCodedDictionary emptyCompact(empty);
+  bool passed = (emptyCompact.getElementCount() == 0);
+  try {
+     emptyCompact.get(WordPair("food"));
+     passed = false;
+  }
+  catch (EmptyDataCollectionException& anException) { }
+
+  Dictionary myWords;
+  std::map<string, string> model;
+  std::mt19937 generator(2023);
+  putRandomWords(myWords, model, 20000, generator);
+  FrontCodedDictionary compact(myWords);
+  passed = passed && holdsExactly(compact, model) && !compact.contains(WordPair(""))
+           && !compact.contains(WordPair("~"));
+  report.check("a compact copy agrees with a model", passed);
+}
+
+// Description: Merges a compact base with deltas before, among and after its
+//              keys, and checks that a delta holding a key of the base is refused.
+void testMerge() {
+
+  Dictionary base;
+  std::map<string, string> model;
+  std::mt19937 generator(2023);
+  putRandomWords(base, model, 5000, generator);
+  FrontCodedDictionary compact(base);
+
+  Dictionary delta;
+  std::map<string, string> deltaModel(model);
+  putRandomWords(delta, deltaModel, 5000, generator);
+  WordPair first("\x01" "first", "before every key");
+  WordPair last("~last", "after every key");
+  delta.put(first);
+  delta.put(last);
+  deltaModel[first.getEnglish()] = first.getTranslation();
+  deltaModel[last.getEnglish()] = last.getTranslation();
+  FrontCodedDictionary merged(compact, delta);
+  bool passed = holdsExactly(merged, deltaModel) && holdsExactly(compact, model);
+
+  Dictionary overlapping;
+  WordPair again(model.begin()->first, "again");
+  overlapping.put(again);
+  try {
+     FrontCodedDictionary refused(compact, overlapping);
+     passed = false;
+  }
+  catch (std::logic_error& anException) { }
+  report.check("a base merged with a delta agrees with a model", passed);
+}
+
+// Description: Checks that append() refuses keys out of order, and that keys
+//              follow the normalization policy while English words are kept.
+void testAppendAndNormalization() {
+
+  FrontCodedDictionary appended;
+  appended.append(WordPair("bread", "pain"));
+  appended.append(WordPair("food", "nourriture"));
+  bool passed = true;
+  try {
+     appended.append(WordPair("cake", "g\xC3\xA2teau"));
+     passed = false;
+  }
+  catch (std::logic_error& anException) { }
+  try {
+     appended.append(WordPair("food", "aliment"));
+     passed = false;
+  }
+  catch (std::logic_error& anException) { }
+  passed = passed && appended.getElementCount() == 2 && appended.contains(WordPair("bread"));
+
+  Dictionary myWords;
+  myWords.setNormalization(KeyNormalizer::ALL);
+  WordPair cafe("Café", "kahvila");
+  myWords.put(cafe);
+  FrontCodedDictionary compact(myWords);
+  WordPair found = compact.get(WordPair("  CAFE "));
+  passed = passed && found.getEnglish() == "Café" && found.getTranslation() == "kahvila";
+  report.check("appends out of order and normalized keys", passed);
+}
+
+int main() {
+
+  testCopy();
+  testMerge();
+  testAppendAndNormalization();
+
+  return report.summarize();
+}
@@ -0,0 +1,249 @@
+/*
+ * KeyNormalizer.cpp
+ * 
+ * Description: Turns an English word into the key it is compared by, according
+ *              to a normalization policy: letter case folding, whitespace
+ *              trimming/collapsing and accent folding may each be enabled.
+ *              Pure ASCII words take a fast table-driven path; other words
+ *              are decoded as UTF-8 and folded code point by code point
+ *              (Latin-1, Latin Extended-A, Greek and Cyrillic letters).
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "KeyNormalizer.h"
+#include <cstdint>
+#include <cstring>
+
+// Base letter of each lower case code point U+00E0..U+00FF ('*': none, keep as is).
+static const char LATIN1_BASE[] = "aaaaaa*ceeeeiiiidnooooo*ouuuuy*y";
+
+// Base letter of each code point U+0100..U+017F ('*': none, keep as is).
+static const char LATIN_EXTENDED_A_BASE[] =
+   "aaaaaaccccccccddddeeeeeeeeeegggg"
+   "gggghhhhiiiiiiiiii**jjkkklllllll"
+   "lllnnnnnnnnnoooooo**rrrrrrssssss"
+   "ssttttttuuuuuuuuuuuuwwyyyzzzzzzs";
+
+// Description: Returns true for the ASCII whitespace bytes.
+static inline bool isSpace(unsigned char c) {
+   return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Description: Returns the lower case of "codePoint" for the scripts we fold.
+static unsigned int toLower(unsigned int codePoint) {
+
+   if (codePoint >= 'A' && codePoint <= 'Z') return codePoint + 32;
+   if (codePoint < 0xC0) return codePoint;
+   if (codePoint <= 0xDE) return (codePoint == 0xD7) ? codePoint : codePoint + 32;
+   if (codePoint == 0x130) return 'i';     // İ: the pairing below would give dotless ı
+   if (codePoint >= 0x100 && codePoint <= 0x137) return codePoint | 1;
+   if (codePoint >= 0x139 && codePoint <= 0x148) return (codePoint & 1) ? codePoint + 1 : codePoint;
+   if (codePoint >= 0x14A && codePoint <= 0x177) return codePoint | 1;
+   if (codePoint == 0x178) return 0xFF;
+   if (codePoint >= 0x179 && codePoint <= 0x17E) return (codePoint & 1) ? codePoint + 1 : codePoint;
+   if (codePoint >= 0x391 && codePoint <= 0x3A9 && codePoint != 0x3A2) return codePoint + 32;
+   if (codePoint >= 0x410 && codePoint <= 0x42F) return codePoint + 32;
+   if (codePoint >= 0x400 && codePoint <= 0x40F) return codePoint + 80;
+   return codePoint;
+}
+
+// Description: Appends "codePoint" to "key" encoded as UTF-8.
+static void appendUtf8(unsigned int codePoint, string & key) {
+
+   if (codePoint < 0x80) {
+      key += (char) codePoint;
+   }
+   else if (codePoint < 0x800) {
+      key += (char) (0xC0 | (codePoint >> 6));
+      key += (char) (0x80 | (codePoint & 0x3F));
+   }
+   else if (codePoint < 0x10000) {
+      key += (char) (0xE0 | (codePoint >> 12));
+      key += (char) (0x80 | ((codePoint >> 6) & 0x3F));
+      key += (char) (0x80 | (codePoint & 0x3F));
+   }
+   else {
+      key += (char) (0xF0 | (codePoint >> 18));
+      key += (char) (0x80 | ((codePoint >> 12) & 0x3F));
+      key += (char) (0x80 | ((codePoint >> 6) & 0x3F));
+      key += (char) (0x80 | (codePoint & 0x3F));
+   }
+}
+
+/* Constructor and getters */
+
+   KeyNormalizer::KeyNormalizer(unsigned int policy) : policy(policy) { }
+
+   unsigned int KeyNormalizer::getPolicy() const {
+      return policy;
+   }
+
+   // Description: Returns true when the policy leaves every word unchanged.
+   bool KeyNormalizer::isIdentity() const {
+      return policy == NONE;
+   }
+
+
+/* Normalization */
+
+   // Description: Returns the key of "word".
+   // Time efficiency: O(length of word)
+   string KeyNormalizer::normalize(const string & word) const {
+      string key;
+      normalizeInto(word, key);
+      return key;
+   }
+
+   // Description: Stores the key of "word" into "key", reusing its storage.
+   // Time efficiency: O(length of word)
+   void KeyNormalizer::normalizeInto(const string & word, string & key) const {
+
+      if (policy == NONE) {
+         key = word;
+      }
+      else if (isAscii(word)) {
+         normalizeAscii(word, key);
+      }
+      else {
+         normalizeUtf8(word, key);
+      }
+   }
+
+   // Description: Returns true if every byte of "word" is ASCII (checks 8 bytes at a time).
+   bool KeyNormalizer::isAscii(const string & word) {
+
+      const char * bytes = word.data();
+      size_t length = word.size();
+      size_t i = 0;
+      uint64_t highBits = 0;
+      for (; i + 8 <= length; i += 8) {
+         uint64_t chunk;
+         memcpy(&chunk, bytes + i, 8);
+         highBits |= chunk;
+      }
+      for (; i < length; i++) {
+         highBits |= (unsigned char) bytes[i];
+      }
+      return (highBits & 0x8080808080808080ULL) == 0;
+   }
+
+   // Description: ASCII-only normalization of "word" into "key".
+   void KeyNormalizer::normalizeAscii(const string & word, string & key) const {
+
+      key.clear();
+      key.reserve(word.size());
+      bool foldCase = policy & FOLD_CASE;
+      bool trim = policy & TRIM_WHITESPACE;
+      bool pendingSpace = false;
+      for (unsigned char c : word) {
+         if (trim && isSpace(c)) {
+            //a run of whitespace becomes one space, and only between words
+            pendingSpace = !key.empty();
+            continue;
+         }
+         if (pendingSpace) {
+            key += ' ';
+            pendingSpace = false;
+         }
+         key += (foldCase && c >= 'A' && c <= 'Z') ? (char) (c + 32) : (char) c;
+      }
+   }
+
+   // Description: UTF-8 normalization of "word" into "key".
+   //              Invalid bytes are copied unchanged.
+   void KeyNormalizer::normalizeUtf8(const string & word, string & key) const {
+
+      key.clear();
+      key.reserve(word.size());
+      bool trim = policy & TRIM_WHITESPACE;
+      bool pendingSpace = false;
+      size_t i = 0;
+      while (i < word.size()) {
+         unsigned char c = word[i];
+         unsigned int codePoint = c;
+         size_t length = 1;
+         if (c >= 0xC2 && c <= 0xDF) length = 2;
+         else if (c >= 0xE0 && c <= 0xEF) length = 3;
+         else if (c >= 0xF0 && c <= 0xF4) length = 4;
+
+         if (length > 1) {
+            bool valid = i + length <= word.size();
+            codePoint = c & (0x7F >> length);
+            for (size_t j = 1; valid && j < length; j++) {
+               unsigned char next = word[i + j];
+               valid = (next & 0xC0) == 0x80;
+               codePoint = (codePoint << 6) | (next & 0x3F);
+            }
+            if (!valid) {
+               //not UTF-8: keep the byte itself
+               codePoint = c;
+               length = 1;
+            }
+         }
+         i += length;
+
+         if (trim && (codePoint == 0xA0 || (codePoint < 0x80 && isSpace(codePoint)))) {
+            pendingSpace = !key.empty();
+            continue;
+         }
+         if (pendingSpace) {
+            key += ' ';
+            pendingSpace = false;
+         }
+         if (length == 1 && codePoint >= 0x80) {
+            key += (char) codePoint;
+         }
+         else {
+            appendFolded(codePoint, key);
+         }
+      }
+   }
+
+   // Description: Appends code point "codePoint" to "key", folded according to the policy.
+   void KeyNormalizer::appendFolded(unsigned int codePoint, string & key) const {
+
+      unsigned int lower = toLower(codePoint);
+      bool upper = lower != codePoint;
+      if (policy & FOLD_CASE) {
+         //dotless ı folds to i too, so that Turkish words match whichever i they were typed with
+         codePoint = (lower == 0x131) ? 'i' : lower;
+      }
+      if (!(policy & FOLD_ACCENTS)) {
+         appendUtf8(codePoint, key);
+         return;
+      }
+
+      //letters that fold to more than one letter
+      const char * base = nullptr;
+      if (lower == 'i') {
+         //İ, whose lower case is ASCII: only its dot is left to fold
+         base = "i";
+      }
+      switch (lower) {
+         case 0xDF:  base = "ss"; break;
+         case 0xE6:  base = "ae"; break;
+         case 0xFE:  base = "th"; break;
+         case 0x133: base = "ij"; break;
+         case 0x153: base = "oe"; break;
+      }
+      char single[2] = {0, 0};
+      if (base == nullptr && lower >= 0xE0 && lower <= 0xFF && LATIN1_BASE[lower - 0xE0] != '*') {
+         single[0] = LATIN1_BASE[lower - 0xE0];
+         base = single;
+      }
+      else if (base == nullptr && lower >= 0x100 && lower <= 0x17F && LATIN_EXTENDED_A_BASE[lower - 0x100] != '*') {
+         single[0] = LATIN_EXTENDED_A_BASE[lower - 0x100];
+         base = single;
+      }
+      if (base == nullptr) {
+         appendUtf8(codePoint, key);
+         return;
+      }
+      //keep the letter case unless case is folded too
+      bool keepUpper = upper && !(policy & FOLD_CASE);
+      for (const char * letter = base; *letter != 0; letter++) {
+         key += keepUpper ? (char) (*letter - 32) : *letter;
+      }
+   }
@@ -0,0 +1,68 @@
+/*
+ * KeyNormalizer.h
+ * 
+ * Description: Turns an English word into the key it is compared by, according
+ *              to a normalization policy: letter case folding, whitespace
+ *              trimming/collapsing and accent folding may each be enabled.
+ *              Pure ASCII words take a fast table-driven path; other words
+ *              are decoded as UTF-8 and folded code point by code point
+ *              (Latin-1, Latin Extended-A, Greek and Cyrillic letters).
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef KEY_NORMALIZER_H
+#define KEY_NORMALIZER_H
+
+#include <string>
+
+using std::string;
+
+class KeyNormalizer {
+
+private:
+
+   unsigned int policy = 0;
+
+   // Description: Returns true if every byte of "word" is ASCII (checks 8 bytes at a time).
+   static bool isAscii(const string & word);
+
+   // Description: ASCII-only normalization of "word" into "key".
+   void normalizeAscii(const string & word, string & key) const;
+
+   // Description: UTF-8 normalization of "word" into "key".
+   //              Invalid bytes are copied unchanged.
+   void normalizeUtf8(const string & word, string & key) const;
+
+   // Description: Appends code point "codePoint" to "key", folded according to the policy.
+   void appendFolded(unsigned int codePoint, string & key) const;
+
+public:
+
+   // Policy flags, combine with |.
+   static const unsigned int NONE = 0;
+   static const unsigned int FOLD_CASE = 1;        // "Food" -> "food", Turkish "İ" and "ı" -> "i"
+   static const unsigned int TRIM_WHITESPACE = 2;  // " ice  cream\r" -> "ice cream"
+   static const unsigned int FOLD_ACCENTS = 4;     // "café" -> "cafe"
+   static const unsigned int ALL = FOLD_CASE | TRIM_WHITESPACE | FOLD_ACCENTS;
+
+   // Constructor
+   KeyNormalizer(unsigned int policy = NONE);
+
+   // Getter
+   unsigned int getPolicy() const;
+
+   // Description: Returns true when the policy leaves every word unchanged.
+   bool isIdentity() const;
+
+   // Description: Returns the key of "word".
+   // Time efficiency: O(length of word)
+   string normalize(const string & word) const;
+
+   // Description: Stores the key of "word" into "key", reusing its storage.
+   // Time efficiency: O(length of word)
+   void normalizeInto(const string & word, string & key) const;
+
+}; // end KeyNormalizer
+#endif
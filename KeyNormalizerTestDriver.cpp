@@ -0,0 +1,155 @@
+/*
+ * KeyNormalizerTestDriver.cpp
+ *
+ * Description: Drives the testing of the KeyNormalizer class. Each row of the
+ *              tables below is a word, a policy and the key expected, covering
+ *              the ASCII fast path, the Latin-1 and Latin Extended-A case
+ *              pairs and accents, whitespace collapsing, Greek and Cyrillic
+ *              capitals and bytes that are not UTF-8.
+ *              Prints one line per table and returns the number of failures.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <string>
+#include "KeyNormalizer.h"
+#include "TestReport.h"
+
+using std::cout;
+using std::endl;
+
+static TestReport report;
+
+// One case of a table: "word" normalized under "policy" must give "key".
+struct Case {
+  unsigned int policy;
+  const char * word;
+  const char * key;
+};
+
+static const unsigned int CASE = KeyNormalizer::FOLD_CASE;
+static const unsigned int TRIM = KeyNormalizer::TRIM_WHITESPACE;
+static const unsigned int ACCENTS = KeyNormalizer::FOLD_ACCENTS;
+static const unsigned int ALL = KeyNormalizer::ALL;
+
+static const Case ASCII_CASES[] = {
+  { KeyNormalizer::NONE, " Food\t", " Food\t" },
+  { CASE, "Food", "food" },
+  { CASE, "ICE CREAM", "ice cream" },
+  { CASE, "a1-B2_c3@[Z]", "a1-b2_c3@[z]" },
+  { CASE, "Ice  Cream ", "ice  cream " },
+  { ACCENTS, "Cafe", "Cafe" },
+  { ALL, "", "" }
+};
+
+static const Case WHITESPACE_CASES[] = {
+  { TRIM, " ice  cream\r", "ice cream" },
+  { TRIM, "\t a \n\v b \f", "a b" },
+  { TRIM, "   ", "" },
+  { TRIM, "Ice Cream", "Ice Cream" },
+  { TRIM, "a\xC2\xA0\xC2\xA0" "b", "a b" },              // no-break spaces
+  { TRIM, " caf\xC3\xA9  au  lait ", "caf\xC3\xA9 au lait" },
+  { ALL, "  CR\xC3\x88ME   Br\xC3\xBBl\xC3\xA9" "e \n", "creme brulee" }
+};
+
+static const Case LATIN1_CASES[] = {
+  { CASE, "CAF\xC3\x89", "caf\xC3\xA9" },                 // CAFÉ -> café
+  { CASE, "\xC3\x80\xC3\x89\xC3\x8E\xC3\x95\xC3\x9C",       // ÀÉÎÕÜ -> àéîõü
+          "\xC3\xA0\xC3\xA9\xC3\xAE\xC3\xB5\xC3\xBC" },
+  { CASE, "\xC3\x97", "\xC3\x97" },                       // × is not a letter
+  { CASE, "\xC3\x9F", "\xC3\x9F" },                       // ß has no capital here
+  { ACCENTS, "caf\xC3\xA9", "cafe" },
+  { ACCENTS, "\xC3\x91" "and\xC3\xBA", "Nandu" },         // Ñandú
+  { ACCENTS, "Stra\xC3\x9F" "e", "Strasse" },
+  { ACCENTS, "\xC3\x86sir", "AEsir" },                    // Æsir
+  { ACCENTS, "\xC3\xBEorn", "thorn" },                    // þorn
+  { ACCENTS, "\xC3\xB7", "\xC3\xB7" },                    // ÷ has no base letter
+  { ALL, "\xC3\x86SIR", "aesir" }
+};
+
+static const Case LATIN_EXTENDED_A_CASES[] = {
+  { CASE, "\xC4\x80\xC4\x82\xC4\x84\xC4\x86\xC4\x8C\xC4\x8E",  // ĀĂĄĆČĎ
+          "\xC4\x81\xC4\x83\xC4\x85\xC4\x87\xC4\x8D\xC4\x8F" },
+  { CASE, "\xC4\x92\xC4\x98\xC4\x9A\xC4\x9E",                  // ĒĘĚĞ
+          "\xC4\x93\xC4\x99\xC4\x9B\xC4\x9F" },
+  { CASE, "\xC5\x81\xC5\x83\xC5\x87",                          // ŁŃŇ
+          "\xC5\x82\xC5\x84\xC5\x88" },
+  { CASE, "\xC5\xA0\xC5\xBD\xC5\xB8",                          // ŠŽŸ
+          "\xC5\xA1\xC5\xBE\xC3\xBF" },
+  { CASE, "\xC5\x81\xC3\xB3\x64\xC5\xBA", "\xC5\x82\xC3\xB3\x64\xC5\xBA" },  // Łódź
+  { ACCENTS, "\xC5\x81\xC3\xB3\x64\xC5\xBA", "Lodz" },
+  { ACCENTS, "\xC5\x92uvre", "OEuvre" },                        // Œuvre
+  { ACCENTS, "\xC4\xB3", "ij" },                                // ĳ
+  { ACCENTS, "\xC4\xB2", "IJ" },                                // Ĳ
+  { ALL, "\xC5\xA0\xC4\x8C\xC4\x98", "sce" }
+};
+
+static const Case TURKISH_CASES[] = {
+  { CASE, "\xC4\xB0STANBUL", "istanbul" },                      // İSTANBUL
+  { CASE, "\xC4\xB0stanbul", "istanbul" },
+  { CASE, "\xC4\xB1spanak", "ispanak" },                        // ıspanak
+  { CASE, "ISPANAK", "ispanak" },
+  { ACCENTS, "\xC4\xB0", "I" },
+  { ACCENTS, "\xC4\xB1", "i" },
+  { ALL, "\xC4\xB0zm\xC4\xB1r", "izmir" }                       // İzmır
+};
+
+static const Case GREEK_AND_CYRILLIC_CASES[] = {
+  { CASE, "\xCE\x91\xCE\x92\xCE\x93", "\xCE\xB1\xCE\xB2\xCE\xB3" },        // ΑΒΓ
+  { CASE, "\xCE\xA3\xCE\xA9", "\xCF\x83\xCF\x89" },                         // ΣΩ
+  { CASE, "\xD0\x9C\xD0\x9E\xD0\xA1\xD0\x9A\xD0\x92\xD0\x90",              // МОСКВА
+          "\xD0\xBC\xD0\xBE\xD1\x81\xD0\xBA\xD0\xB2\xD0\xB0" },
+  { CASE, "\xD0\x81\xD0\xB6", "\xD1\x91\xD0\xB6" }                          // Ёж
+};
+
+static const Case INVALID_UTF8_CASES[] = {
+  { CASE, "\xFF" "AB", "\xFF" "ab" },
+  { CASE, "CAF\xC3", "caf\xC3" },                                           // truncated
+  { ALL, "\xC3(Z", "\xC3(z" }                                              // bad continuation
+};
+
+// Description: Checks every row of "cases", printing those that fail.
+template <size_t N>
+void checkTable(const string & name, const Case (&cases)[N]) {
+
+  bool passed = true;
+  for (const Case & aCase : cases) {
+     string key = KeyNormalizer(aCase.policy).normalize(aCase.word);
+     if (key != aCase.key) {
+        cout << "   \"" << aCase.word << "\" under policy " << aCase.policy << " gave \""
+             << key << "\", not \"" << aCase.key << "\"" << endl;
+        passed = false;
+     }
+  }
+  report.check(name, passed);
+}
+
+// Description: Checks that ASCII words fold the same on the fast path and on
+//              the UTF-8 path, which a non-ASCII letter sends them down.
+void checkPathsAgree() {
+
+  const char * words[] = { "Food", "ICE", "MiXeD", "a1-B2_c3@[Z]", "zZ" };
+  KeyNormalizer normalizer(KeyNormalizer::FOLD_CASE);
+  bool passed = true;
+  for (const char * word : words) {
+     passed = passed && normalizer.normalize(string(word) + "\xC3\xA9")
+                        == normalizer.normalize(word) + "\xC3\xA9";
+  }
+  report.check("ASCII fast path agrees with the UTF-8 path", passed);
+}
+
+int main() {
+
+  checkTable("ASCII words", ASCII_CASES);
+  checkTable("whitespace trimming and collapsing", WHITESPACE_CASES);
+  checkTable("Latin-1 case pairs and accents", LATIN1_CASES);
+  checkTable("Latin Extended-A case pairs and accents", LATIN_EXTENDED_A_CASES);
+  checkTable("Turkish dotted and dotless i", TURKISH_CASES);
+  checkTable("Greek and Cyrillic capitals", GREEK_AND_CYRILLIC_CASES);
+  checkTable("bytes that are not UTF-8", INVALID_UTF8_CASES);
+  checkPathsAgree();
+
+  return report.summarize();
+}
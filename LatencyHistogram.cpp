@@ -0,0 +1,108 @@
+/*
+ * LatencyHistogram.cpp
+ * 
+ * Description: HDR-style histogram of latencies in nanoseconds.
+ *              Values below 128 are counted exactly; above that, each power
+ *              of two is split into 64 equal buckets, so every recorded value
+ *              is known within 1.6% while the histogram stays a fixed,
+ *              small array however large the values get.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "LatencyHistogram.h"
+
+/* Constructor */
+
+   LatencyHistogram::LatencyHistogram() : counts(bucketOf(UINT64_MAX) + 1, 0) { }
+
+
+/* Histogram operations */
+
+   // Description: Counts one occurrence of "nanoseconds".
+   // Time efficiency: O(1)
+   void LatencyHistogram::record(uint64_t nanoseconds) {
+      counts[bucketOf(nanoseconds)]++;
+      totalCount++;
+      sum += nanoseconds;
+      if (nanoseconds < minimum) minimum = nanoseconds;
+      if (nanoseconds > maximum) maximum = nanoseconds;
+   }
+
+   // Description: Adds every count of "other" to this histogram.
+   // Time efficiency: O(number of buckets)
+   void LatencyHistogram::merge(const LatencyHistogram & other) {
+      for (unsigned int bucket = 0; bucket < counts.size(); bucket++) {
+         counts[bucket] += other.counts[bucket];
+      }
+      totalCount += other.totalCount;
+      sum += other.sum;
+      if (other.minimum < minimum) minimum = other.minimum;
+      if (other.maximum > maximum) maximum = other.maximum;
+   }
+
+   // Description: Returns the value at or below which "percent" percent of the
+   //              recorded values fall (within the bucket precision).
+   // Time efficiency: O(number of buckets)
+   uint64_t LatencyHistogram::getPercentile(double percent) const {
+
+      if (totalCount == 0) {
+         return 0;
+      }
+      //rank of the wanted value, 1-based, rounded up
+      uint64_t rank = (uint64_t) (percent / 100.0 * totalCount + 0.999999);
+      if (rank == 0) rank = 1;
+      uint64_t seen = 0;
+      for (unsigned int bucket = 0; bucket < counts.size(); bucket++) {
+         seen += counts[bucket];
+         if (seen >= rank) {
+            //report the top of the bucket, never above the largest value seen
+            uint64_t top = (bucket + 1 < counts.size()) ? lowestValueOf(bucket + 1) - 1 : maximum;
+            return top < maximum ? top : maximum;
+         }
+      }
+      return maximum;
+   }
+
+   uint64_t LatencyHistogram::getCount() const {
+      return totalCount;
+   }
+
+   uint64_t LatencyHistogram::getMinimum() const {
+      return totalCount == 0 ? 0 : minimum;
+   }
+
+   uint64_t LatencyHistogram::getMaximum() const {
+      return maximum;
+   }
+
+   double LatencyHistogram::getMean() const {
+      return totalCount == 0 ? 0.0 : (double) (sum / totalCount);
+   }
+
+
+/* Utility methods */
+
+   // Description: Returns the bucket of "value".
+   unsigned int LatencyHistogram::bucketOf(uint64_t value) {
+
+      if (value < EXACT_LIMIT) {
+         return value;
+      }
+      //keep the 7 highest bits: a shift per power of two, 64 buckets each
+      int magnitude = 63 - __builtin_clzll(value);
+      int shift = magnitude - 6;
+      return shift * SUB_BUCKETS + (unsigned int) (value >> shift);
+   }
+
+   // Description: Returns the smallest value counted in "bucket".
+   uint64_t LatencyHistogram::lowestValueOf(unsigned int bucket) {
+
+      if (bucket < (unsigned int) EXACT_LIMIT) {
+         return bucket;
+      }
+      int shift = bucket / SUB_BUCKETS - 1;
+      uint64_t mantissa = bucket - shift * SUB_BUCKETS;
+      return mantissa << shift;
+   }
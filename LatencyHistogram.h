@@ -0,0 +1,62 @@
+/*
+ * LatencyHistogram.h
+ * 
+ * Description: HDR-style histogram of latencies in nanoseconds.
+ *              Values below 128 are counted exactly; above that, each power
+ *              of two is split into 64 equal buckets, so every recorded value
+ *              is known within 1.6% while the histogram stays a fixed,
+ *              small array however large the values get.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <cstdint>
+#include <vector>
+
+class LatencyHistogram {
+
+private:
+
+   static const int SUB_BUCKETS = 64;       // buckets per power of two
+   static const int EXACT_LIMIT = 128;      // values below are counted exactly
+
+   std::vector<uint64_t> counts;
+   uint64_t totalCount = 0;
+   uint64_t minimum = UINT64_MAX;
+   uint64_t maximum = 0;
+   long double sum = 0;
+
+   // Description: Returns the bucket of "value".
+   static unsigned int bucketOf(uint64_t value);
+
+   // Description: Returns the smallest value counted in "bucket".
+   static uint64_t lowestValueOf(unsigned int bucket);
+
+public:
+
+   // Constructor
+   LatencyHistogram();
+
+   // Description: Counts one occurrence of "nanoseconds".
+   // Time efficiency: O(1)
+   void record(uint64_t nanoseconds);
+
+   // Description: Adds every count of "other" to this histogram.
+   void merge(const LatencyHistogram & other);
+
+   // Description: Returns the value at or below which "percent" percent of the
+   //              recorded values fall (within the bucket precision).
+   // Precondition: 0 <= percent <= 100.
+   uint64_t getPercentile(double percent) const;
+
+   uint64_t getCount() const;
+   uint64_t getMinimum() const;             // 0 when nothing was recorded
+   uint64_t getMaximum() const;
+   double getMean() const;
+
+}; // end LatencyHistogram
+#endif
@@ -0,0 +1,181 @@
+/*
+ * MultiLanguageDictionary.cpp
+ * 
+ * Description: Dictionary data collection ADT class whose elements associate
+ *              one English key with a translation in each of N languages.
+ *              Keys are stored once, in sorted order; translations are stored
+ *              column by column (one column per language), so a single key
+ *              search gives the row of every translation.
+ *              Duplicated keys not allowed.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "MultiLanguageDictionary.h"
+#include <algorithm>
+
+/* Constructor */
+
+   MultiLanguageDictionary::MultiLanguageDictionary(const vector<string> & languages)
+      : languages(languages), columns(languages.size()) { }
+
+
+/* Getters */
+
+   // Description: Returns the number of English keys in the Dictionary.
+   // Time efficiency: O(1)
+   unsigned int MultiLanguageDictionary::getElementCount() const {
+      return keys.size();
+   }
+
+   // Description: Returns the number of translation columns.
+   // Time efficiency: O(1)
+   unsigned int MultiLanguageDictionary::getLanguageCount() const {
+      return languages.size();
+   }
+
+   // Description: Returns the name of column "language".
+   string MultiLanguageDictionary::getLanguage(unsigned int language) const {
+      return languages[language];
+   }
+
+   // Description: Returns the column index of the language named "name".
+   // Exception: Throws the exception ElementDoesNotExistException if there is no such column.
+   // Time efficiency: O(N)
+   unsigned int MultiLanguageDictionary::getLanguageIndex(const string & name) const {
+      for (unsigned int language = 0; language < languages.size(); language++) {
+         if (languages[language] == name) {
+            return language;
+         }
+      }
+      throw ElementDoesNotExistException("No " + name + " column.");
+   }
+
+
+/* Dictionary operations */
+
+   // Description: Puts "english" and its "translations" into the Dictionary.
+   // Exception: Throws the exception ElementAlreadyExistsException
+   //            if "english" already exists in the Dictionary.
+   // Time efficiency: O(n)
+   void MultiLanguageDictionary::put(const string & english, const vector<string> & translations) {
+
+      unsigned int row = lowerBound(english);
+      if (row < keys.size() && keys[row] == english) {
+         throw ElementAlreadyExistsException("Element already exists.");
+      }
+      keys.insert(keys.begin() + row, english);
+      for (unsigned int language = 0; language < columns.size(); language++) {
+         string translation = (language < translations.size()) ? translations[language] : "";
+         columns[language].insert(columns[language].begin() + row, translation);
+      }
+   }
+
+   // Description: Puts every row of "rows" into the Dictionary, in one sort, moving its strings.
+   //              Rows whose key is already present are skipped, and their exceptions returned.
+   // Time efficiency: O((n + m) log2 (n + m))
+   vector<ElementAlreadyExistsException> MultiLanguageDictionary::putAll(vector< vector<string> > && rows) {
+
+      vector<ElementAlreadyExistsException> skipped;
+      unsigned int existing = keys.size();
+
+      //order rows by key; existing rows come first among equal keys so they win
+      vector<unsigned int> order(existing + rows.size());
+      for (unsigned int i = 0; i < order.size(); i++) {
+         order[i] = i;
+      }
+      auto keyOf = [&](unsigned int i) -> const string & {
+         return (i < existing) ? keys[i] : rows[i - existing][0];
+      };
+      std::stable_sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) {
+         return keyOf(a) < keyOf(b);
+      });
+
+      vector<string> newKeys;
+      vector< vector<string> > newColumns(columns.size());
+      newKeys.reserve(order.size());
+      for (unsigned int language = 0; language < columns.size(); language++) {
+         newColumns[language].reserve(order.size());
+      }
+      for (unsigned int i : order) {
+         if (!newKeys.empty() && newKeys.back() == keyOf(i)) {
+            skipped.push_back(ElementAlreadyExistsException("Element already exists: " + keyOf(i)));
+            continue;
+         }
+         if (i < existing) {
+            newKeys.push_back(std::move(keys[i]));
+            for (unsigned int language = 0; language < columns.size(); language++) {
+               newColumns[language].push_back(std::move(columns[language][i]));
+            }
+         }
+         else {
+            vector<string> & row = rows[i - existing];
+            newKeys.push_back(std::move(row[0]));
+            for (unsigned int language = 0; language < columns.size(); language++) {
+               newColumns[language].push_back(language + 1 < row.size() ? std::move(row[language + 1]) : "");
+            }
+         }
+      }
+      keys.swap(newKeys);
+      columns.swap(newColumns);
+      return skipped;
+   }
+
+   // Description: Gets the translation of "targetElement" in column "language".
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Exception: Throws the exception ElementDoesNotExistException
+   //            if the key is not found in the Dictionary.
+   // Time efficiency: O(log2 n)
+   WordPair MultiLanguageDictionary::get(const WordPair & targetElement, unsigned int language) const {
+
+      unsigned int row = findRow(targetElement.getEnglish());
+      return WordPair(keys[row], columns[language][row]);
+   }
+
+   // Description: Gets the translations of "english" in every column.
+   // Time efficiency: O(log2 n + N)
+   vector<string> MultiLanguageDictionary::getAll(const string & english) const {
+
+      unsigned int row = findRow(english);
+      vector<string> translations;
+      translations.reserve(columns.size());
+      for (unsigned int language = 0; language < columns.size(); language++) {
+         translations.push_back(columns[language][row]);
+      }
+      return translations;
+   }
+
+   // Description: Visits every (English key, translation in column "language") in key order.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Time efficiency: O(n)
+   void MultiLanguageDictionary::displayContent(void visit(WordPair &), unsigned int language) const {
+
+      if (keys.empty())
+         throw EmptyDataCollectionException("Dictionary is empty.");
+
+      for (unsigned int row = 0; row < keys.size(); row++) {
+         WordPair element(keys[row], columns[language][row]);
+         visit(element);
+      }
+   }
+
+   // Description: Returns the row of "english" or, if absent, the row where it would go.
+   // Time efficiency: O(log2 n)
+   unsigned int MultiLanguageDictionary::lowerBound(const string & english) const {
+      return std::lower_bound(keys.begin(), keys.end(), english) - keys.begin();
+   }
+
+   // Description: Returns the row of "english".
+   // Time efficiency: O(log2 n)
+   unsigned int MultiLanguageDictionary::findRow(const string & english) const {
+
+      if (keys.empty())
+         throw EmptyDataCollectionException("Dictionary is empty.");
+
+      unsigned int row = lowerBound(english);
+      if (row == keys.size() || keys[row] != english) {
+         throw ElementDoesNotExistException("***Not Found!***");
+      }
+      return row;
+   }
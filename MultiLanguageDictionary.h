@@ -0,0 +1,100 @@
+/*
+ * MultiLanguageDictionary.h
+ * 
+ * Description: Dictionary data collection ADT class whose elements associate
+ *              one English key with a translation in each of N languages.
+ *              Keys are stored once, in sorted order; translations are stored
+ *              column by column (one column per language), so a single key
+ *              search gives the row of every translation.
+ *              Duplicated keys not allowed.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef MULTI_LANGUAGE_DICTIONARY_H
+#define MULTI_LANGUAGE_DICTIONARY_H
+
+#include "WordPair.h"
+#include "ElementAlreadyExistsException.h"
+#include "ElementDoesNotExistException.h"
+#include "EmptyDataCollectionException.h"
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+class MultiLanguageDictionary {
+
+private:
+
+   vector<string> languages;           // name of each column
+   vector<string> keys;                // sorted English keys, one per row
+   vector< vector<string> > columns;   // columns[language][row]
+
+   // Description: Returns the row of "english" or, if absent, the row where it would go.
+   // Time efficiency: O(log2 n)
+   unsigned int lowerBound(const string & english) const;
+
+   // Description: Returns the row of "english".
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Exception: Throws the exception ElementDoesNotExistException if "english" is not found.
+   // Time efficiency: O(log2 n)
+   unsigned int findRow(const string & english) const;
+
+public:
+
+   // Constructor
+   MultiLanguageDictionary(const vector<string> & languages);
+
+   // Description: Returns the number of English keys in the Dictionary.
+   unsigned int getElementCount() const;
+
+   // Description: Returns the number of translation columns.
+   unsigned int getLanguageCount() const;
+
+   // Description: Returns the name of column "language".
+   // Precondition: language < getLanguageCount().
+   string getLanguage(unsigned int language) const;
+
+   // Description: Returns the column index of the language named "name".
+   // Exception: Throws the exception ElementDoesNotExistException if there is no such column.
+   unsigned int getLanguageIndex(const string & name) const;
+
+   // Description: Puts "english" and its "translations" (one per column, missing
+   //              columns are left empty) into the Dictionary.
+   // Exception: Throws the exception ElementAlreadyExistsException
+   //            if "english" already exists in the Dictionary.
+   // Time efficiency: O(n) - rows after the new one are shifted.
+   //                  Use putAll() to load many rows.
+   void put(const string & english, const vector<string> & translations);
+
+   // Description: Puts every row of "rows" (English key followed by its translations)
+   //              into the Dictionary. The strings of "rows" are moved, not copied,
+   //              which is why it is taken as an rvalue. Rows whose key is already
+   //              present, in the Dictionary or earlier in "rows", are skipped:
+   //              the exception put() would have thrown for each is returned.
+   // Time efficiency: O((n + m) log2 (n + m)) for m new rows.
+   vector<ElementAlreadyExistsException> putAll(vector< vector<string> > && rows);
+
+   // Description: Gets the translation of "targetElement" in column "language".
+   // Precondition: language < getLanguageCount().
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Exception: Throws the exception ElementDoesNotExistException
+   //            if the key is not found in the Dictionary.
+   // Time efficiency: O(log2 n)
+   WordPair get(const WordPair & targetElement, unsigned int language) const;
+
+   // Description: Gets the translations of "english" in every column.
+   // Exception: Same as get().
+   // Time efficiency: O(log2 n + N)
+   vector<string> getAll(const string & english) const;
+
+   // Description: Visits every (English key, translation in column "language") in key order.
+   // Precondition: Dictionary is not empty.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   void displayContent(void visit(WordPair &), unsigned int language) const;
+
+}; // end MultiLanguageDictionary
+#endif
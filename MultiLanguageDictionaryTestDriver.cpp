@@ -0,0 +1,211 @@
+/*
+ * MultiLanguageDictionaryTestDriver.cpp
+ *
+ * Description: Drives the testing of the MultiLanguageDictionary ADT class.
+ *              Rows put one by one and all at once, some with keys already
+ *              put and some short of a translation, are checked column by
+ *              column against a std::map holding what the Dictionary should,
+ *              and a file of several languages is loaded and checked.
+ *              Prints one line per check and returns the number of failures.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "MultiLanguageDictionary.h"
+#include "DictionaryLoader.h"
+#include "TestReport.h"
+#include "WordPair.h"
+#include "ElementAlreadyExistsException.h"
+#include "ElementDoesNotExistException.h"
+#include "EmptyDataCollectionException.h"
+
+// File written by the tests, removed at the end.
+static const string DATA_FILE = "multiLanguageTestDriver.txt";
+
+static TestReport report;
+
+// Elements visited by displayContent(), which takes a plain function.
+static vector<WordPair> visited;
+
+void collect(WordPair & anElement) {
+  visited.push_back(anElement);
+}
+
+// Description: Returns the translations of a row of "languageCount" columns,
+//              of which the last is left out for every third key.
+vector<string> makeTranslations(unsigned int key, unsigned int languageCount, unsigned int version) {
+
+  vector<string> translations;
+  unsigned int given = (key % 3 == 0) ? languageCount - 1 : languageCount;
+  for (unsigned int language = 0; language < given; language++) {
+     translations.push_back("t" + std::to_string(language) + "-" + std::to_string(key)
+                            + "-" + std::to_string(version));
+  }
+  return translations;
+}
+
+// Description: Returns true if "myWords" holds exactly "model", through getAll(),
+//              get() and displayContent() in every column. A translation left
+//              out of the model's row must read as empty.
+bool holdsExactly(const MultiLanguageDictionary & myWords,
+                  const std::map< string, vector<string> > & model) {
+
+  if (myWords.getElementCount() != model.size()) {
+     return false;
+  }
+  unsigned int languageCount = myWords.getLanguageCount();
+  for (const auto & row : model) {
+     vector<string> expected(row.second);
+     expected.resize(languageCount);
+     if (myWords.getAll(row.first) != expected) {
+        return false;
+     }
+     for (unsigned int language = 0; language < languageCount; language++) {
+        WordPair found = myWords.get(WordPair(row.first), language);
+        if (found.getEnglish() != row.first || found.getTranslation() != expected[language]) {
+           return false;
+        }
+     }
+  }
+  for (unsigned int language = 0; language < languageCount; language++) {
+     visited.clear();
+     myWords.displayContent(collect, language);
+     if (visited.size() != model.size()) {
+        return false;
+     }
+     auto next = model.begin();
+     for (const WordPair & anElement : visited) {
+        string expected = (language < next->second.size()) ? next->second[language] : "";
+        if (anElement.getEnglish() != next->first || anElement.getTranslation() != expected) {
+           return false;
+        }
+        next++;
+     }
+  }
+  return true;
+}
+
+// Description: Checks the column names, and that an empty Dictionary and an
+//              unknown key or language throw.
+void testColumnsAndEmpty() {
+
+  MultiLanguageDictionary myWords({ "french", "spanish", "german" });
+  bool passed = myWords.getLanguageCount() == 3 && myWords.getLanguage(1) == "spanish"
+                && myWords.getLanguageIndex("german") == 2;
+  try {
+     myWords.getLanguageIndex("italian");
+     passed = false;
+  }
+  catch (ElementDoesNotExistException& anException) { }
+  try {
+     myWords.getAll("food");
+     passed = false;
+  }
+  catch (EmptyDataCollectionException& anException) { }
+  myWords.put("food", { "nourriture", "comida", "Essen" });
+  try {
+     myWords.getAll("water");
+     passed = false;
+  }
+  catch (ElementDoesNotExistException& anException) { }
+  report.check("column names, an empty Dictionary and absent keys", passed);
+}
+
+// Description: Puts random rows one by one, then many at once, some of keys
+//              already put in either way, and checks every column against "model".
+void testAgainstModel() {
+
+  const unsigned int languageCount = 4;
+  MultiLanguageDictionary myWords({ "french", "spanish", "german", "italian" });
+  std::map< string, vector<string> > model;
+  std::mt19937 generator(2023);
+  std::uniform_int_distribution<unsigned int> keys(0, 2999);
+  bool passed = true;
+
+  for (unsigned int step = 0; passed && step < 1000; step++) {
+     unsigned int key = keys(generator);
+     string english = "word" + std::to_string(key);
+     vector<string> translations = makeTranslations(key, languageCount, step);
+     bool expected = (model.find(english) == model.end());
+     try {
+        myWords.put(english, translations);
+        passed = expected;
+        model[english] = translations;
+     }
+     catch (ElementAlreadyExistsException& anException) {
+        passed = !expected;
+     }
+  }
+  passed = passed && holdsExactly(myWords, model);
+
+  //the first of the rows with a key wins, whether put before or earlier in the batch
+  vector< vector<string> > rows;
+  unsigned int duplicates = 0;
+  for (unsigned int step = 0; step < 4000; step++) {
+     unsigned int key = keys(generator);
+     string english = "word" + std::to_string(key);
+     vector<string> translations = makeTranslations(key, languageCount, 1000 + step);
+     if (model.find(english) != model.end()) {
+        duplicates++;
+     }
+     else {
+        model[english] = translations;
+     }
+     vector<string> row(1, english);
+     row.insert(row.end(), translations.begin(), translations.end());
+     rows.push_back(row);
+  }
+  vector<ElementAlreadyExistsException> skipped = myWords.putAll(std::move(rows));
+  passed = passed && skipped.size() == duplicates && holdsExactly(myWords, model);
+  report.check("rows put one by one and all at once agree with a model", passed);
+}
+
+// Description: Loads a file of three languages with a duplicate key and a
+//              short line, and checks its columns and the duplicate reported.
+void testLoad() {
+
+  std::ofstream data(DATA_FILE);
+  data << "english:french:spanish:german\n"
+       << "water:eau:agua:Wasser\n"
+       << "food:nourriture:comida:Essen\n"
+       << "bread:pain\n"
+       << "water:onde:ola:Welle\n";
+  data.close();
+
+  std::ostringstream log;
+  MultiLanguageDictionary * myWords = DictionaryLoader::loadMultiLanguage(DATA_FILE, log);
+  bool passed = (myWords != nullptr);
+  if (passed) {
+     std::map< string, vector<string> > model;
+     model["water"] = { "eau", "agua", "Wasser" };
+     model["food"] = { "nourriture", "comida", "Essen" };
+     model["bread"] = { "pain" };
+     string logged = log.str();
+     passed = myWords->getLanguageCount() == 3 && myWords->getLanguageIndex("spanish") == 1
+              && holdsExactly(*myWords, model)
+              && std::count(logged.begin(), logged.end(), '\n') == 1 && logged.find("water") != string::npos;
+     delete myWords;
+  }
+  passed = passed && DictionaryLoader::loadMultiLanguage("multiLanguageTestDriver.missing", log) == nullptr;
+  report.check("a file of three languages", passed);
+}
+
+int main() {
+
+  testColumnsAndEmpty();
+  testAgainstModel();
+  testLoad();
+
+  std::remove(DATA_FILE.c_str());
+  return report.summarize();
+}
@@ -0,0 +1,138 @@
+/*
+ * OrderStatisticsTestDriver.cpp
+ *
+ * Description: Drives the testing of the order statistics of the Dictionary:
+ *              rank(), select() and countRange() are checked against positions
+ *              in a sorted list of the same keys, for keys present and absent,
+ *              in a tree of random shape, in one put in order, and in a snapshot
+ *              whose original is put into after it was taken.
+ *              Prints one line per check and returns the number of failures.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include "Dictionary.h"
+#include "TestReport.h"
+#include "WordPair.h"
+#include "ElementDoesNotExistException.h"
+
+using std::vector;
+
+static TestReport report;
+
+// Description: Returns the number of keys of "sorted" less than "key".
+unsigned int lowerBound(const vector<string> & sorted, const string & key) {
+  return std::lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin();
+}
+
+// Description: Returns the number of keys of "sorted" not greater than "key".
+unsigned int upperBound(const vector<string> & sorted, const string & key) {
+  return std::upper_bound(sorted.begin(), sorted.end(), key) - sorted.begin();
+}
+
+// Description: Returns true if rank(), select() and countRange() of "myWords"
+//              agree with "sorted", its keys in order, for each key, for keys
+//              between them and for random ranges.
+bool agreesWith(const Dictionary & myWords, const vector<string> & sorted, std::mt19937 & generator) {
+
+  if (myWords.getElementCount() != sorted.size()) {
+     return false;
+  }
+  bool passed = true;
+  for (unsigned int i = 0; passed && i < sorted.size(); i++) {
+     passed = myWords.rank(WordPair(sorted[i])) == i && myWords.select(i).getEnglish() == sorted[i];
+     //a key just after this one, absent unless it is the next key
+     string after = sorted[i] + "0";
+     passed = passed && myWords.rank(WordPair(after)) == lowerBound(sorted, after);
+  }
+  passed = passed && myWords.rank(WordPair("")) == 0 && myWords.rank(WordPair("~")) == sorted.size();
+  try {
+     myWords.select(sorted.size());
+     passed = false;
+  }
+  catch (ElementDoesNotExistException& anException) { }
+
+  std::uniform_int_distribution<unsigned int> keys(0, 2 * sorted.size());
+  for (unsigned int i = 0; passed && i < 2000; i++) {
+     string low = "word" + std::to_string(keys(generator));
+     string high = "word" + std::to_string(keys(generator));
+     unsigned int expected = (high < low) ? 0 : upperBound(sorted, high) - lowerBound(sorted, low);
+     passed = myWords.countRange(WordPair(low), WordPair(high)) == expected;
+  }
+  return passed;
+}
+
+// Description: Checks a tree of random shape and one put in increasing order.
+void testAgainstSortedList() {
+
+  const unsigned int wordCount = 4000;
+  std::mt19937 generator(2023);
+  vector<string> sorted;
+  Dictionary shuffled;
+  Dictionary inOrder;
+  bool passed = (shuffled.rank(WordPair("food")) == 0) && shuffled.countRange(WordPair("a"), WordPair("z")) == 0;
+  vector<unsigned int> numbers(wordCount);
+  for (unsigned int i = 0; i < wordCount; i++) {
+     //every other number, so that absent keys fall between present ones
+     numbers[i] = 2 * i;
+     sorted.push_back("word" + std::to_string(2 * i));
+  }
+  std::sort(sorted.begin(), sorted.end());
+  for (const string & english : sorted) {
+     WordPair aWord(english, "translation");
+     inOrder.put(aWord);
+  }
+  std::shuffle(numbers.begin(), numbers.end(), generator);
+  for (unsigned int number : numbers) {
+     WordPair aWord("word" + std::to_string(number), "translation");
+     shuffled.put(aWord);
+  }
+  passed = passed && agreesWith(shuffled, sorted, generator) && agreesWith(inOrder, sorted, generator);
+  report.check("rank, select and countRange agree with a sorted list", passed);
+}
+
+// Description: Checks that a snapshot keeps its own order statistics while its
+//              original is put into, and that the original's count them all.
+void testSnapshot() {
+
+  const unsigned int wordCount = 3000;
+  std::mt19937 generator(2023);
+  vector<unsigned int> numbers(2 * wordCount);
+  for (unsigned int i = 0; i < numbers.size(); i++) {
+     numbers[i] = i;
+  }
+  std::shuffle(numbers.begin(), numbers.end(), generator);
+
+  Dictionary original;
+  vector<string> before;
+  for (unsigned int i = 0; i < wordCount; i++) {
+     WordPair aWord("word" + std::to_string(numbers[i]), "translation");
+     original.put(aWord);
+     before.push_back(aWord.getEnglish());
+  }
+  Dictionary snapshot(original);
+  vector<string> after(before);
+  for (unsigned int i = wordCount; i < numbers.size(); i++) {
+     WordPair aWord("word" + std::to_string(numbers[i]), "translation");
+     original.put(aWord);
+     after.push_back(aWord.getEnglish());
+  }
+  std::sort(before.begin(), before.end());
+  std::sort(after.begin(), after.end());
+  report.check("order statistics of a snapshot and of its original",
+               agreesWith(snapshot, before, generator) && agreesWith(original, after, generator));
+}
+
+int main() {
+
+  testAgainstSortedList();
+  testSnapshot();
+
+  return report.summarize();
+}
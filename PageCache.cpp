@@ -0,0 +1,230 @@
+/*
+ * PageCache.cpp
+ *
+ * Description: Fixed-size buffer pool over the pages of a read-only file.
+ *              A page is read into one of "capacity" frames the first time
+ *              it is pinned, and stays there until its frame is needed for
+ *              another page. The frame given up is chosen by the eviction
+ *              policy: LRU takes the least recently used page, CLOCK sweeps
+ *              the frames and takes the first one not used since the last
+ *              sweep, which costs less bookkeeping per hit. A pinned page is
+ *              never evicted, so its data stays valid until it is unpinned;
+ *              a thread that finds every frame pinned waits for one to be
+ *              unpinned. Pages are read outside the pool's lock: other threads
+ *              carry on meanwhile, and only those pinning the page being read
+ *              wait, for that read alone. Thread safe.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "PageCache.h"
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+/* Constructor */
+
+   PageCache::PageCache(int fd, unsigned int pageSize, unsigned int capacity, Policy policy)
+      : fd(fd), pageSize(pageSize), policy(policy),
+        frames(capacity > 0 ? capacity : 1),
+        data(new char[(size_t) frames.size() * pageSize]) {
+      pageFrames.reserve(frames.size());
+      for (unsigned int frame = frames.size(); frame > 0; frame--) {
+         freeFrames.push_back(frame - 1);
+      }
+   }
+
+
+/* Getters */
+
+   unsigned int PageCache::getCapacity() const {
+      return frames.size();
+   }
+
+   PageCache::Policy PageCache::getPolicy() const {
+      return policy;
+   }
+
+   unsigned long PageCache::getHitCount() const {
+      std::lock_guard<std::mutex> guard(lock);
+      return hitCount;
+   }
+
+   unsigned long PageCache::getReadCount() const {
+      std::lock_guard<std::mutex> guard(lock);
+      return readCount;
+   }
+
+   // Description: Returns the number of bytes used by the pool.
+   size_t PageCache::getMemoryUsage() const {
+      return sizeof(*this) + frames.size() * (sizeof(Frame) + pageSize)
+           + pageFrames.bucket_count() * sizeof(void *)
+           + pageFrames.size() * (sizeof(std::pair<uint32_t, unsigned int>) + 2 * sizeof(void *));
+   }
+
+
+/* Pool operations */
+
+   // Description: Pins page "page", reading it from the file if it is not in a frame.
+   //              Waits if every frame is pinned.
+   // Exception: Throws the exception logic_error if the page cannot be read.
+   // Time efficiency: O(1) on a hit, O(capacity) at worst with CLOCK
+   unsigned int PageCache::pin(uint32_t page) {
+
+      std::unique_lock<std::mutex> guard(lock);
+      unsigned int victim;
+      //the page is looked up again after a wait, as another thread may have read it meanwhile
+      while (true) {
+         auto found = pageFrames.find(page);
+         if (found != pageFrames.end()) {
+            unsigned int index = found->second;
+            Frame & frame = frames[index];
+            frame.pinCount++;
+            frame.referenced = true;
+            if (policy == LRU) touch(index);
+            if (frame.loading) {
+               //pinned, the frame is kept for this page: only its read is waited for
+               loaded.wait(guard, [&frame]() { return !frame.loading; });
+               if (!frame.used || frame.page != page) {
+                  //the read failed: try it again, as this thread's own read
+                  dropFailedPin(index);
+                  continue;
+               }
+            }
+            hitCount++;
+            return index;
+         }
+         victim = findVictim();
+         if (victim != NO_FRAME) {
+            break;
+         }
+         unpinned.wait(guard);
+      }
+
+      //the frame is given to the page before the read, so that other threads
+      //pinning it wait for this read rather than reading it too
+      Frame & frame = frames[victim];
+      if (frame.used) {
+         pageFrames.erase(frame.page);
+      }
+      frame.page = page;
+      frame.used = true;
+      frame.loading = true;
+      frame.referenced = true;
+      frame.pinCount = 1;
+      pageFrames[page] = victim;
+      if (policy == LRU) touch(victim);
+
+      //no other thread writes the frame while it is pinned and loading
+      guard.unlock();
+      char * buffer = &data[(size_t) victim * pageSize];
+      size_t done = 0;
+      while (done < pageSize) {
+         ssize_t bytes = pread(fd, buffer + done, pageSize - done, (off_t) page * pageSize + done);
+         if (bytes <= 0) {
+            break;
+         }
+         done += bytes;
+      }
+      guard.lock();
+
+      frame.loading = false;
+      loaded.notify_all();
+      if (done < pageSize) {
+         pageFrames.erase(page);
+         frame.used = false;
+         if (policy == LRU) unlink(victim);
+         dropFailedPin(victim);
+         throw std::logic_error("Unable to read page " + std::to_string(page) + ".");
+      }
+      readCount++;
+      return victim;
+   }
+
+   // Description: Returns the data of pinned frame "frame".
+   const char * PageCache::getData(unsigned int frame) const {
+      return &data[(size_t) frame * pageSize];
+   }
+
+   // Description: Unpins frame "frame", pinned once more than unpinned.
+   void PageCache::unpin(unsigned int frame) {
+      std::lock_guard<std::mutex> guard(lock);
+      if (--frames[frame].pinCount == 0) {
+         unpinned.notify_all();
+      }
+   }
+
+
+/* Utility methods */
+
+   // Description: Returns a frame that can take a new page, or NO_FRAME if every frame is pinned.
+   unsigned int PageCache::findVictim() {
+
+      if (!freeFrames.empty()) {
+         unsigned int frame = freeFrames.back();
+         freeFrames.pop_back();
+         return frame;
+      }
+      if (policy == LRU) {
+         for (unsigned int frame = oldest; frame != NO_FRAME; frame = frames[frame].newer) {
+            if (frames[frame].pinCount == 0) {
+               return frame;
+            }
+         }
+      }
+      else {
+         //two sweeps: the first may only clear reference bits
+         for (size_t step = 0; step < 2 * frames.size(); step++) {
+            unsigned int frame = hand;
+            hand = (hand + 1) % frames.size();
+            if (frames[frame].pinCount > 0) {
+               continue;
+            }
+            if (!frames[frame].referenced) {
+               return frame;
+            }
+            frames[frame].referenced = false;
+         }
+      }
+      return NO_FRAME;
+   }
+
+   // Description: Drops a pin of "frame", whose page could not be read, and
+   //              frees the frame once no thread pins it any more.
+   void PageCache::dropFailedPin(unsigned int frame) {
+
+      if (--frames[frame].pinCount == 0) {
+         freeFrames.push_back(frame);
+         unpinned.notify_all();
+      }
+   }
+
+   // Description: LRU: moves "frame" to the newest end of the recency list.
+   void PageCache::touch(unsigned int frame) {
+
+      if (newest == frame) {
+         return;
+      }
+      unlink(frame);
+      frames[frame].older = newest;
+      frames[frame].newer = NO_FRAME;
+      if (newest != NO_FRAME) frames[newest].newer = frame;
+      newest = frame;
+      if (oldest == NO_FRAME) oldest = frame;
+   }
+
+   // Description: LRU: takes "frame" out of the recency list.
+   void PageCache::unlink(unsigned int frame) {
+
+      Frame & node = frames[frame];
+      bool linked = (node.newer != NO_FRAME || node.older != NO_FRAME || newest == frame);
+      if (!linked) {
+         return;
+      }
+      if (node.newer != NO_FRAME) frames[node.newer].older = node.older;
+      else newest = node.older;
+      if (node.older != NO_FRAME) frames[node.older].newer = node.newer;
+      else oldest = node.newer;
+      node.newer = node.older = NO_FRAME;
+   }
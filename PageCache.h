@@ -0,0 +1,118 @@
+/*
+ * PageCache.h
+ *
+ * Description: Fixed-size buffer pool over the pages of a read-only file.
+ *              A page is read into one of "capacity" frames the first time
+ *              it is pinned, and stays there until its frame is needed for
+ *              another page. The frame given up is chosen by the eviction
+ *              policy: LRU takes the least recently used page, CLOCK sweeps
+ *              the frames and takes the first one not used since the last
+ *              sweep, which costs less bookkeeping per hit. A pinned page is
+ *              never evicted, so its data stays valid until it is unpinned;
+ *              a thread that finds every frame pinned waits for one to be
+ *              unpinned. Pages are read outside the pool's lock: other threads
+ *              carry on meanwhile, and only those pinning the page being read
+ *              wait, for that read alone. Thread safe.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef PAGE_CACHE_H
+#define PAGE_CACHE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class PageCache {
+
+public:
+
+   // Eviction policies.
+   enum Policy { LRU, CLOCK };
+
+private:
+
+   static const unsigned int NO_FRAME = 0xFFFFFFFF;
+
+   struct Frame {
+      uint32_t page = 0;
+      bool used = false;                      // holds a page
+      bool loading = false;                   // the page is being read into the frame
+      bool referenced = false;                // CLOCK: used since the hand last passed
+      unsigned int pinCount = 0;
+      unsigned int newer = NO_FRAME;          // LRU: neighbours in the recency list
+      unsigned int older = NO_FRAME;
+   };
+
+   int fd;
+   unsigned int pageSize;
+   Policy policy;
+   std::vector<Frame> frames;
+   std::unique_ptr<char[]> data;              // frame i holds bytes [i * pageSize, (i + 1) * pageSize)
+   std::unordered_map<uint32_t, unsigned int> pageFrames;
+   unsigned int newest = NO_FRAME;            // LRU: ends of the recency list
+   unsigned int oldest = NO_FRAME;
+   unsigned int hand = 0;                     // CLOCK: next frame to look at
+   std::vector<unsigned int> freeFrames;      // frames holding no page
+   unsigned long hitCount = 0;
+   unsigned long readCount = 0;
+   mutable std::mutex lock;
+   std::condition_variable unpinned;          // signalled when a frame is no longer pinned
+   std::condition_variable loaded;            // signalled when a frame's page read ends
+
+   // Description: Returns a frame that can take a new page, or NO_FRAME if every frame is pinned.
+   unsigned int findVictim();
+
+   // Description: Drops a pin of "frame", whose page could not be read, and
+   //              frees the frame once no thread pins it any more.
+   // Precondition: The caller holds "lock".
+   void dropFailedPin(unsigned int frame);
+
+   // Description: LRU: moves "frame" to the newest end of the recency list.
+   void touch(unsigned int frame);
+
+   // Description: LRU: takes "frame" out of the recency list.
+   void unlink(unsigned int frame);
+
+   // Not copyable.
+   PageCache(const PageCache &) = delete;
+   PageCache & operator=(const PageCache &) = delete;
+
+public:
+
+   // Constructor
+   // Description: A pool of "capacity" frames (at least 1) of "pageSize" bytes over
+   //              the file open for reading as "fd", which the caller keeps open.
+   PageCache(int fd, unsigned int pageSize, unsigned int capacity, Policy policy = LRU);
+
+   // Getters
+   unsigned int getCapacity() const;
+   Policy getPolicy() const;
+   unsigned long getHitCount() const;   // pins that found their page in a frame
+   unsigned long getReadCount() const;  // pages read from the file
+
+   // Description: Returns the number of bytes used by the pool.
+   size_t getMemoryUsage() const;
+
+   // Description: Pins page "page", reading it from the file if it is not in a
+   //              frame, and returns its frame. The page's data, from getData(),
+   //              stays valid until the frame is unpinned. Waits if every
+   //              frame is pinned, so a thread must not pin a second page
+   //              while it holds one, and if another thread is reading the page.
+   // Exception: Throws the exception logic_error if the page cannot be read.
+   // Time efficiency: O(1) on a hit, O(capacity) at worst with CLOCK
+   unsigned int pin(uint32_t page);
+
+   // Description: Returns the data of pinned frame "frame".
+   const char * getData(unsigned int frame) const;
+
+   // Description: Unpins frame "frame", pinned once more than unpinned.
+   void unpin(unsigned int frame);
+
+}; // end PageCache
+#endif
@@ -0,0 +1,132 @@
+/*
+ * ParallelExportTestDriver.cpp
+ *
+ * Description: Drives the testing of the parallel traversals of the Dictionary.
+ *              exportContent() must write, on any number of threads, the same
+ *              bytes as displayContent() printing each element; the parallel
+ *              traversal must visit every element once; and a snapshot must
+ *              export its own content while its original is put into.
+ *              Prints one line per check and returns the number of failures.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Dictionary.h"
+#include "TestReport.h"
+#include "WordPair.h"
+
+using std::cout;
+using std::endl;
+using std::vector;
+
+static const unsigned int WORD_COUNT = 20000;
+
+static TestReport report;
+
+// Description: Returns a Dictionary of "count" words put in random order, whose
+//              translations vary in length and hold UTF-8 and spaces.
+Dictionary makeDictionary(unsigned int count) {
+
+  vector<unsigned int> order(count);
+  for (unsigned int i = 0; i < count; i++) {
+     order[i] = i;
+  }
+  std::mt19937 generator(2023);
+  std::shuffle(order.begin(), order.end(), generator);
+  Dictionary myWords;
+  for (unsigned int i : order) {
+     WordPair aWord("word" + std::to_string(i), string(i % 50, 'a') + " caf\xC3\xA9 " + std::to_string(i));
+     myWords.put(aWord);
+  }
+  return myWords;
+}
+
+// Description: Returns what displayContent() prints for "myWords", one element per line.
+string displayed(const Dictionary & myWords) {
+
+  std::ostringstream out;
+  myWords.displayContent([&out](WordPair & anElement) {
+     out << anElement;
+  });
+  return out.str();
+}
+
+// Description: Checks that exportContent() writes what displayContent() prints,
+//              byte for byte, on 1 to 8 threads and on one per hardware thread,
+//              and writes nothing for an empty Dictionary.
+void testExportMatchesDisplay() {
+
+  Dictionary myWords = makeDictionary(WORD_COUNT);
+  string expected = displayed(myWords);
+  bool passed = true;
+  const unsigned int threadCounts[] = { 0, 1, 2, 3, 4, 7, 8 };
+  for (unsigned int threads : threadCounts) {
+     std::ostringstream exported;
+     myWords.exportContent(exported, threads);
+     if (exported.str() != expected) {
+        cout << "   export on " << threads << " thread(s) differs" << endl;
+        passed = false;
+     }
+  }
+  std::ostringstream empty;
+  Dictionary().exportContent(empty, 4);
+  report.check("export matches displayContent byte for byte", passed && empty.str().empty());
+}
+
+// Description: Checks that the parallel traversal visits every element once.
+void testParallelVisitsEachOnce() {
+
+  Dictionary myWords = makeDictionary(WORD_COUNT);
+  bool passed = true;
+  const unsigned int threadCounts[] = { 1, 3, 8 };
+  for (unsigned int threads : threadCounts) {
+     std::mutex visitedMutex;
+     vector<string> visited;
+     myWords.displayContentParallel([&visited, &visitedMutex](WordPair & anElement) {
+        std::lock_guard<std::mutex> lock(visitedMutex);
+        visited.push_back(anElement.getEnglish());
+     }, threads);
+     std::sort(visited.begin(), visited.end());
+     passed = passed && visited.size() == WORD_COUNT
+              && std::adjacent_find(visited.begin(), visited.end()) == visited.end();
+  }
+  report.check("parallel traversal visits every element once", passed);
+}
+
+// Description: Exports a snapshot on several threads while another thread puts
+//              into the original, and checks the snapshot's export.
+void testExportSnapshotDuringPuts() {
+
+  Dictionary original = makeDictionary(WORD_COUNT);
+  Dictionary snapshot(original);
+  string expected = displayed(snapshot);
+  std::thread writer([&original]() {
+     for (unsigned int i = WORD_COUNT; i < 2 * WORD_COUNT; i++) {
+        WordPair aWord("word" + std::to_string(i), "translation");
+        original.put(aWord);
+     }
+  });
+  std::ostringstream exported;
+  snapshot.exportContent(exported, 4);
+  writer.join();
+  report.check("a snapshot exports its own content during puts",
+               exported.str() == expected && original.getElementCount() == 2 * WORD_COUNT);
+}
+
+int main() {
+
+  testExportMatchesDisplay();
+  testParallelVisitsEachOnce();
+  testExportSnapshotDuringPuts();
+
+  return report.summarize();
+}
@@ -0,0 +1,486 @@
+/*
+ * PhraseTranslator.cpp
+ * 
+ * Description: Translates running text against a Dictionary, phrase by phrase.
+ *              The keys of the Dictionary are split into words and stored in
+ *              a trie of words, so that each position of the text is matched
+ *              against the longest key starting there ("ice cream" before "ice").
+ *              Text is read in large blocks and split into words in one pass;
+ *              words that start no key, spaces and punctuation are copied unchanged.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "PhraseTranslator.h"
+#include <cstring>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+const uint32_t PhraseTranslator::NONE;
+
+// Text is read in blocks of this size, then translated up to its last line break.
+static const size_t BLOCK_SIZE = 1 << 20;
+
+// A block without a line break is still translated once this large,
+// at the cost of splitting a phrase that would straddle the cut.
+static const size_t MAX_LINE = 16 << 20;
+
+// Description: Returns the class of each byte: 1 for word bytes (ASCII letters,
+//              digits, apostrophe, hyphen and every non-ASCII byte), 2 for blanks
+//              (space, tab), 0 for the rest (punctuation, line breaks, controls).
+static const unsigned char * byteClasses() {
+
+   static unsigned char classes[256];
+   static bool built = false;
+   if (!built) {
+      for (int c = 0; c < 256; c++) {
+         bool word = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+                     || c == '\'' || c == '-' || c >= 0x80;
+         classes[c] = word ? 1 : ((c == ' ' || c == '\t') ? 2 : 0);
+      }
+      built = true;
+   }
+   return classes;
+}
+
+// Classes are built before main() runs, so translating threads only read them.
+static const unsigned char * CLASSES = byteClasses();
+
+/* Constructor */
+
+   // Description: Builds the phrase index of every key of "words".
+   // Time efficiency: O(total length of the keys)
+   PhraseTranslator::PhraseTranslator(const Dictionary & words)
+      : normalizer(words.getNormalization()) {
+
+      foldCase = (normalizer.getPolicy() & KeyNormalizer::FOLD_CASE) != 0;
+      wordTable.resize(1024);
+      edgeKeys.assign(1024, UINT64_MAX);
+      edgeChildren.assign(1024, NONE);
+      addNode();
+      if (words.getElementCount() != 0) {
+         words.displayContent([this](WordPair & element) {
+            addPhrase(element.getKey(), element.getTranslation());
+         });
+      }
+   }
+
+
+/* Getters */
+
+   unsigned int PhraseTranslator::getPhraseCount() const {
+      return phraseCount;
+   }
+
+   unsigned int PhraseTranslator::getSkippedKeyCount() const {
+      return skippedKeyCount;
+   }
+
+
+/* Translation */
+
+   // Description: Appends the translation of "text" to "out".
+   // Time efficiency: O(length of text)
+   void PhraseTranslator::translate(const char * text, size_t length, string & out) const {
+
+      vector<Token> tokens;
+      string scratch;
+      translate(text, length, out, tokens, scratch);
+   }
+
+   // Description: Appends the translation of "text" to "out", reusing "tokens" and "scratch".
+   // Time efficiency: O(length of text)
+   void PhraseTranslator::translate(const char * text, size_t length, string & out,
+                                    vector<Token> & tokens, string & scratch) const {
+
+      tokenize(text, length, tokens, scratch);
+
+      //bytes of "text" before "copied" are in "out" already
+      size_t copied = 0;
+      for (size_t i = 0; i < tokens.size(); i++) {
+         if (tokens[i].word == NONE) {
+            continue;
+         }
+         //walk the trie for as long as the words go, remembering the last key seen
+         uint32_t node = tokens[i].node;
+         uint32_t best = nodes[node].translation;
+         size_t bestEnd = i;
+         for (size_t j = i + 1; j < tokens.size() && nodes[node].childCount != 0; j++) {
+            if (!tokens[j].joined || tokens[j].word == NONE) {
+               break;
+            }
+            node = findChild(node, tokens[j].word);
+            if (node == NONE) {
+               break;
+            }
+            if (nodes[node].translation != NONE) {
+               best = nodes[node].translation;
+               bestEnd = j;
+            }
+         }
+         if (best != NONE) {
+            out.append(text + copied, tokens[i].start - copied);
+            out += translations[best];
+            copied = tokens[bestEnd].start + tokens[bestEnd].length;
+            i = bestEnd;
+         }
+      }
+      out.append(text + copied, length - copied);
+   }
+
+   // Description: Writes the translation of every line of "in" to "out".
+   // Time efficiency: O(length of in)
+   void PhraseTranslator::translate(std::istream & in, std::ostream & out) const {
+
+      string pending;
+      string translated;
+      vector<Token> tokens;
+      string scratch;
+      size_t filled = 0;
+      while (true) {
+         pending.resize(filled + BLOCK_SIZE);
+         in.read(&pending[filled], BLOCK_SIZE);
+         filled += in.gcount();
+         bool ended = in.gcount() == 0 || !in;
+         //phrases never span lines, so every complete line can be translated now
+         const char * lastBreak = (const char *) memrchr(pending.data(), '\n', filled);
+         size_t ready = ended ? filled
+                      : (lastBreak != nullptr ? lastBreak - pending.data() + 1
+                      : (filled >= MAX_LINE ? filled : 0));
+         if (!ended && lastBreak == nullptr && ready > 0) {
+            //an overlong line is cut after its last punctuation or blank, never inside a word
+            while (ready > 0 && CLASSES[(unsigned char) pending[ready - 1]] == 1) {
+               ready--;
+            }
+            if (ready == 0) {
+               ready = filled;
+            }
+         }
+         if (ready > 0) {
+            translate(pending.data(), ready, translated, tokens, scratch);
+            out.write(translated.data(), translated.size());
+            translated.clear();
+            pending.erase(0, ready);
+            filled -= ready;
+         }
+         if (ended) {
+            break;
+         }
+      }
+   }
+
+   // Description: Splits "text" into its words, stored into "tokens".
+   //              Bytes are classified 64 at a time into bit masks, and words
+   //              are read off the transitions of the mask, which keeps the
+   //              loop free of a hard-to-predict branch per byte.
+   void PhraseTranslator::tokenize(const char * text, size_t length, vector<Token> & tokens,
+                                   string & scratch) const {
+
+      const unsigned char * bytes = (const unsigned char *) text;
+      tokens.clear();
+      bool inWord = false;
+      size_t start = 0;
+      size_t previousEnd = 0;
+      long lastOther = -1;              // position of the last byte neither word nor blank
+      for (size_t base = 0; base < length; base += 64) {
+         size_t count = (length - base < 64) ? length - base : 64;
+         uint64_t word;
+         uint64_t other;
+         classify(bytes + base, count, word, other);
+         //a bit for each position where a word starts or ends
+         uint64_t transitions = word ^ ((word << 1) | (inWord ? 1 : 0));
+         while (transitions != 0) {
+            unsigned int position = __builtin_ctzll(transitions);
+            transitions &= transitions - 1;
+            if (!inWord) {
+               start = base + position;
+               //only blanks since the previous word: the two may form a phrase
+               uint64_t otherBefore = other & (((uint64_t) 1 << position) - 1);
+               if (otherBefore != 0) {
+                  lastOther = base + 63 - __builtin_clzll(otherBefore);
+               }
+               inWord = true;
+            }
+            else {
+               lookUp(text, length, start, base + position,
+                      !tokens.empty() && lastOther < (long) previousEnd, tokens, scratch);
+               previousEnd = base + position;
+               inWord = false;
+            }
+         }
+         if (other != 0) {
+            lastOther = base + 63 - __builtin_clzll(other);
+         }
+      }
+      if (inWord) {
+         lookUp(text, length, start, length, !tokens.empty() && lastOther < (long) previousEnd, tokens, scratch);
+      }
+   }
+
+   // Description: Sets the bit k of "word" if byte k of "block" is a word byte,
+   //              and of "other" if it is neither a word byte nor a blank,
+   //              for the "count" (at most 64) bytes of "block".
+   void PhraseTranslator::classify(const unsigned char * block, size_t count,
+                                   uint64_t & word, uint64_t & other) {
+
+      word = 0;
+      other = 0;
+      size_t k = 0;
+#ifdef __SSE2__
+      //16 bytes at a time; every byte from 0x80 is negative, hence a word byte
+      for (; k + 16 <= count; k += 16) {
+         __m128i b = _mm_loadu_si128((const __m128i *) (block + k));
+         __m128i lower = _mm_or_si128(b, _mm_set1_epi8(0x20));
+         __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                        _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+         __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(b, _mm_set1_epi8('0' - 1)),
+                                       _mm_cmplt_epi8(b, _mm_set1_epi8('9' + 1)));
+         __m128i mark = _mm_or_si128(_mm_cmpeq_epi8(b, _mm_set1_epi8('\'')),
+                                     _mm_cmpeq_epi8(b, _mm_set1_epi8('-')));
+         __m128i isWord = _mm_or_si128(_mm_or_si128(letter, digit),
+                                       _mm_or_si128(mark, _mm_cmplt_epi8(b, _mm_setzero_si128())));
+         __m128i isBlank = _mm_or_si128(_mm_cmpeq_epi8(b, _mm_set1_epi8(' ')),
+                                        _mm_cmpeq_epi8(b, _mm_set1_epi8('\t')));
+         uint64_t wordBits = (unsigned int) _mm_movemask_epi8(isWord);
+         uint64_t blankBits = (unsigned int) _mm_movemask_epi8(isBlank);
+         word |= wordBits << k;
+         other |= (~(wordBits | blankBits) & 0xFFFF) << k;
+      }
+#endif
+      for (; k < count; k++) {
+         unsigned char c = CLASSES[block[k]];
+         word |= (uint64_t) (c == 1) << k;
+         other |= (uint64_t) (c == 0) << k;
+      }
+   }
+
+   // Description: Appends the word "text[start..end)" to "tokens", looked up in the
+   //              vocabulary. Words are normalized as the keys were: ASCII words by
+   //              folding their case as they are hashed, other words through the normalizer.
+   void PhraseTranslator::lookUp(const char * text, size_t length, size_t start, size_t end,
+                                 bool joined, vector<Token> & tokens, string & scratch) const {
+
+      Token token;
+      token.start = start;
+      token.length = end - start;
+      token.joined = joined;
+      bool ascii = true;
+      uint64_t h = hash(text + start, token.length, length - start, foldCase, ascii);
+      const WordSlot * slot;
+      if (ascii || normalizer.isIdentity()) {
+         slot = findWord(text + start, token.length,
+                         ascii ? h : hash(text + start, token.length, length - start, false, ascii));
+      }
+      else {
+         //non-ASCII word under a policy: accents and non-ASCII case need the normalizer
+         normalizer.normalizeInto(string(text + start, token.length), scratch);
+         slot = findWord(scratch.data(), scratch.size(), hash(scratch.data(), scratch.size(), scratch.size(), false, ascii));
+      }
+      token.word = (slot != nullptr) ? slot->offset : NONE;
+      token.node = (slot != nullptr) ? slot->node : NONE;
+      tokens.push_back(token);
+   }
+
+   // Description: Adds the key "key" translated by "translation".
+   void PhraseTranslator::addPhrase(const string & key, const string & translation) {
+
+      uint32_t node = 0;
+      bool empty = true;
+      size_t i = 0;
+      while (i < key.size()) {
+         unsigned char c = key[i];
+         if (CLASSES[c] == 0) {
+            //punctuation never matches inside a phrase of the text
+            skippedKeyCount++;
+            return;
+         }
+         if (CLASSES[c] == 2) {
+            i++;
+            continue;
+         }
+         size_t start = i;
+         while (i < key.size() && CLASSES[(unsigned char) key[i]] == 1) {
+            i++;
+         }
+         WordSlot & slot = addWord(key.substr(start, i - start));
+         node = empty ? slot.node : addChild(node, slot.offset);
+         empty = false;
+      }
+      if (empty) {
+         skippedKeyCount++;
+         return;
+      }
+      //a key equal to an earlier one once split into words keeps the earlier translation
+      if (nodes[node].translation == NONE) {
+         nodes[node].translation = translations.size();
+         translations.push_back(translation);
+         phraseCount++;
+      }
+   }
+
+
+/* Hash tables */
+
+   // Description: Returns the hash of the "length" bytes at "bytes", read 8 at a time
+   //              ("readable" bytes may be read). With "foldCase", ASCII upper case
+   //              letters hash as lower case.
+   //              "ascii" is cleared if a byte is not ASCII (the hash is then
+   //              only valid without "foldCase").
+   uint64_t PhraseTranslator::hash(const char * bytes, size_t length, size_t readable,
+                                   bool foldCase, bool & ascii) {
+
+      const uint64_t ONES = 0x0101010101010101ULL;
+      uint64_t h = length * 0x9e3779b97f4a7c15ULL;
+      uint64_t highBits = 0;
+      for (size_t i = 0; i < length; i += 8) {
+         uint64_t chunk = 0;
+         if (readable - i >= 8) {
+            //a whole load, then the bytes past the word are masked off
+            memcpy(&chunk, bytes + i, 8);
+            if (length - i < 8) {
+               chunk &= ((uint64_t) 1 << (8 * (length - i))) - 1;
+            }
+         }
+         else {
+            for (size_t k = length; k > i; k--) {
+               chunk = (chunk << 8) | (unsigned char) bytes[k - 1];
+            }
+         }
+         highBits |= chunk;
+         if (foldCase) {
+            //high bit of each byte from 'A' (+0x3F) that is not past 'Z' (+0x25)
+            uint64_t upper = (chunk + 0x3F * ONES) & ~(chunk + 0x25 * ONES) & (0x80 * ONES);
+            chunk |= upper >> 2;
+         }
+         h = (h ^ chunk) * 0xff51afd7ed558ccdULL;
+         h ^= h >> 32;
+      }
+      ascii = (highBits & (0x80 * ONES)) == 0;
+      return h;
+   }
+
+   // Description: Returns the slot of the word "bytes", or nullptr. With case folding,
+   //              the ASCII upper case letters of "bytes" match their lower case.
+   const PhraseTranslator::WordSlot * PhraseTranslator::findWord(const char * bytes, size_t length,
+                                                                 uint64_t h) const {
+
+      //spread the hash over the bits that pick the slot and the tag
+      h = (h ^ (h >> 32)) * 0x9e3779b97f4a7c15ULL;
+      uint32_t tag = (uint32_t) (h >> 32) | 1;
+      size_t mask = wordTable.size() - 1;
+      for (size_t slot = (h >> 16) & mask; wordTable[slot].tag != 0; slot = (slot + 1) & mask) {
+         const WordSlot & candidate = wordTable[slot];
+         if (candidate.tag != tag || candidate.length != length) {
+            continue;
+         }
+         const char * word = wordBytes.data() + candidate.offset;
+         size_t k = 0;
+         if (foldCase) {
+            while (k < length && (bytes[k] >= 'A' && bytes[k] <= 'Z' ? bytes[k] + 32 : bytes[k]) == word[k]) k++;
+         }
+         else {
+            while (k < length && bytes[k] == word[k]) k++;
+         }
+         if (k == length) {
+            return &candidate;
+         }
+      }
+      return nullptr;
+   }
+
+   // Description: Returns the slot of the word "word", adding it if new.
+   PhraseTranslator::WordSlot & PhraseTranslator::addWord(const string & word) {
+
+      bool ascii;
+      uint64_t h = hash(word.data(), word.size(), word.size(), false, ascii);
+      const WordSlot * found = findWord(word.data(), word.size(), h);
+      if (found != nullptr) {
+         return const_cast<WordSlot &>(*found);
+      }
+      //keep the table at most half full, so that probe sequences stay short
+      if (2 * (wordCount + 1) > wordTable.size()) {
+         vector<WordSlot> oldTable(2 * wordTable.size());
+         oldTable.swap(wordTable);
+         for (const WordSlot & moved : oldTable) {
+            if (moved.tag != 0) {
+               size_t mask = wordTable.size() - 1;
+               bool ascii;
+               uint64_t mixed = hash(wordBytes.data() + moved.offset, moved.length,
+                                      wordBytes.size() - moved.offset, false, ascii);
+               mixed = (mixed ^ (mixed >> 32)) * 0x9e3779b97f4a7c15ULL;
+               size_t slot = (mixed >> 16) & mask;
+               while (wordTable[slot].tag != 0) slot = (slot + 1) & mask;
+               wordTable[slot] = moved;
+            }
+         }
+      }
+      h = (h ^ (h >> 32)) * 0x9e3779b97f4a7c15ULL;
+      size_t mask = wordTable.size() - 1;
+      size_t slot = (h >> 16) & mask;
+      while (wordTable[slot].tag != 0) slot = (slot + 1) & mask;
+      WordSlot & added = wordTable[slot];
+      added.tag = (uint32_t) (h >> 32) | 1;
+      added.length = word.size();
+      added.offset = wordBytes.size();
+      wordBytes += word;
+      wordCount++;
+      //the root's edge lives in the slot
+      uint32_t node = addNode();
+      nodes[0].childCount++;
+      wordTable[slot].node = node;
+      return wordTable[slot];
+   }
+
+   // Description: Returns a new trie node.
+   uint32_t PhraseTranslator::addNode() {
+      nodes.push_back(Node());
+      return nodes.size() - 1;
+   }
+
+   // Description: Returns the slot of "edge" in "keys": where it is, or the empty slot ending its probe.
+   static size_t edgeSlot(const vector<uint64_t> & keys, uint64_t edge) {
+
+      uint64_t h = edge * 0x9e3779b97f4a7c15ULL;
+      size_t mask = keys.size() - 1;
+      size_t slot = (h >> 32) & mask;
+      while (keys[slot] != edge && keys[slot] != UINT64_MAX) {
+         slot = (slot + 1) & mask;
+      }
+      return slot;
+   }
+
+   // Description: Returns the child of "node" along "word", or NONE.
+   uint32_t PhraseTranslator::findChild(uint32_t node, uint32_t word) const {
+      return edgeChildren[edgeSlot(edgeKeys, (uint64_t) node << 32 | word)];
+   }
+
+   // Description: Returns the child of "node" along "word", adding it if new.
+   uint32_t PhraseTranslator::addChild(uint32_t node, uint32_t word) {
+
+      uint64_t edge = (uint64_t) node << 32 | word;
+      size_t slot = edgeSlot(edgeKeys, edge);
+      if (edgeKeys[slot] == edge) {
+         return edgeChildren[slot];
+      }
+      uint32_t child = addNode();
+      nodes[node].childCount++;
+      edgeKeys[slot] = edge;
+      edgeChildren[slot] = child;
+      //keep the table at most half full
+      if (2 * (nodes.size() - wordCount) > edgeKeys.size()) {
+         vector<uint64_t> oldKeys(2 * edgeKeys.size(), UINT64_MAX);
+         vector<uint32_t> oldChildren(2 * edgeKeys.size(), NONE);
+         oldKeys.swap(edgeKeys);
+         oldChildren.swap(edgeChildren);
+         for (size_t i = 0; i < oldKeys.size(); i++) {
+            if (oldKeys[i] != UINT64_MAX) {
+               size_t newSlot = edgeSlot(edgeKeys, oldKeys[i]);
+               edgeKeys[newSlot] = oldKeys[i];
+               edgeChildren[newSlot] = oldChildren[i];
+            }
+         }
+      }
+      return child;
+   }
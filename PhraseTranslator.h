@@ -0,0 +1,147 @@
+/*
+ * PhraseTranslator.h
+ * 
+ * Description: Translates running text against a Dictionary, phrase by phrase.
+ *              The keys of the Dictionary are split into words and stored in
+ *              a trie of words, so that each position of the text is matched
+ *              against the longest key starting there ("ice cream" before "ice").
+ *              Text is read in large blocks and split into words in one pass;
+ *              words that start no key, spaces and punctuation are copied unchanged.
+ *              Words are runs of letters, digits, apostrophes, hyphens and
+ *              non-ASCII (UTF-8) bytes. The words of a phrase may only be
+ *              separated by whitespace, and never by a line break.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef PHRASE_TRANSLATOR_H
+#define PHRASE_TRANSLATOR_H
+
+#include "Dictionary.h"
+#include "KeyNormalizer.h"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+class PhraseTranslator {
+
+private:
+
+   static const uint32_t NONE = 0xFFFFFFFF;
+
+   // One word of the text being translated.
+   struct Token {
+      uint32_t start;             // offset of its first byte
+      uint32_t length;
+      uint32_t word;              // offset of the word in "wordBytes", NONE if no key contains it
+      uint32_t node;              // trie node of the word as the first of a phrase
+      bool joined;                // only blanks since the previous word
+   };
+
+   // Slot of the vocabulary table, holding all a lookup needs in one place.
+   struct WordSlot {
+      uint32_t tag = 0;           // upper bits of the hash, 0: empty slot
+      uint32_t length = 0;
+      uint32_t offset = 0;        // of the word in "wordBytes", also its id
+      uint32_t node = 0;          // child of the root along the word
+   };
+
+   // Node of the trie of words.
+   struct Node {
+      uint32_t translation = NONE;        // index in "translations"
+      uint32_t childCount = 0;
+   };
+
+   // Vocabulary: the distinct words of the keys, in one byte array.
+   string wordBytes;
+   vector<WordSlot> wordTable;             // open addressing
+   unsigned int wordCount = 0;
+
+   // Trie of words: edge (node, word) -> child node, node 0 is the root.
+   // Edges from the root are kept in "wordTable" instead.
+   vector<uint64_t> edgeKeys;              // node << 32 | word, UINT64_MAX: empty
+   vector<uint32_t> edgeChildren;
+   vector<Node> nodes;
+   vector<string> translations;
+
+   KeyNormalizer normalizer;
+   bool foldCase = false;                  // ASCII words are folded inline
+   unsigned int phraseCount = 0;
+   unsigned int skippedKeyCount = 0;
+
+   // Description: Returns the hash of the "length" bytes at "bytes", read 8 at a
+   //              time, of which "readable" bytes may be read (past the end of a
+   //              word but not of the text). With "foldCase", ASCII upper case letters
+   //              hash as lower case. "ascii" is set to whether every byte is ASCII;
+   //              if not, a hash made with "foldCase" is not valid.
+   static uint64_t hash(const char * bytes, size_t length, size_t readable, bool foldCase, bool & ascii);
+
+   // Description: Sets bit k of "word" if byte k of "block" is a word byte, and
+   //              of "other" if it is neither a word byte nor a blank, for the
+   //              "count" (at most 64) bytes of "block".
+   static void classify(const unsigned char * block, size_t count, uint64_t & word, uint64_t & other);
+
+   // Description: Appends the word "text[start..end)" to "tokens", looked up in the
+   //              vocabulary. "text" holds "length" bytes.
+   void lookUp(const char * text, size_t length, size_t start, size_t end, bool joined,
+               vector<Token> & tokens, string & scratch) const;
+
+   // Description: Returns the slot of the word "bytes" (already normalized, with
+   //              hash "h"), or nullptr if the word is not in the vocabulary.
+   const WordSlot * findWord(const char * bytes, size_t length, uint64_t h) const;
+
+   // Description: Returns the slot of the word "word" (already normalized), adding it if new.
+   WordSlot & addWord(const string & word);
+
+   // Description: Returns the child of "node" along "word", or NONE.
+   uint32_t findChild(uint32_t node, uint32_t word) const;
+
+   // Description: Returns the child of "node" along "word", adding it if new.
+   uint32_t addChild(uint32_t node, uint32_t word);
+
+   // Description: Returns a new trie node.
+   uint32_t addNode();
+
+   // Description: Splits "text" into its words, stored into "tokens"; the words
+   //              are looked up in the vocabulary.
+   void tokenize(const char * text, size_t length, vector<Token> & tokens, string & scratch) const;
+
+   // Description: Appends the translation of "text" to "out", reusing the storage
+   //              of "tokens" and "scratch" from one block of text to the next.
+   void translate(const char * text, size_t length, string & out,
+                  vector<Token> & tokens, string & scratch) const;
+
+   // Description: Adds the key "key" translated by "translation".
+   void addPhrase(const string & key, const string & translation);
+
+public:
+
+   // Constructor
+   // Description: Builds the phrase index of every key of "words", compared
+   //              under the normalization policy of "words".
+   //              Keys holding characters other than word characters and
+   //              whitespace cannot occur as phrases, and are skipped.
+   // Time efficiency: O(total length of the keys)
+   PhraseTranslator(const Dictionary & words);
+
+   // Getters
+   unsigned int getPhraseCount() const;
+   unsigned int getSkippedKeyCount() const;
+
+   // Description: Appends the translation of "text" to "out".
+   //              "text" should end on a line break, as phrases never span calls.
+   // Time efficiency: O(length of text)
+   void translate(const char * text, size_t length, string & out) const;
+
+   // Description: Writes the translation of every line of "in" to "out".
+   // Time efficiency: O(length of in)
+   void translate(std::istream & in, std::ostream & out) const;
+
+}; // end PhraseTranslator
+#endif
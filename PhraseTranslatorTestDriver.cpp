@@ -0,0 +1,221 @@
+/*
+ * PhraseTranslatorTestDriver.cpp
+ *
+ * Description: Drives the testing of the PhraseTranslator class. Hand-picked
+ *              texts check the longest match and the boundaries a phrase may
+ *              not cross (punctuation, line breaks); random texts over a small
+ *              vocabulary are checked against a naive translator that tries
+ *              every phrase length at every word; a long stream is checked
+ *              across the blocks it is read in.
+ *              Prints one line per check and returns the number of failures.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "PhraseTranslator.h"
+#include "Dictionary.h"
+#include "KeyNormalizer.h"
+#include "TestReport.h"
+#include "WordPair.h"
+
+using std::cout;
+using std::endl;
+
+static TestReport report;
+
+// Keys of the tests and their translations.
+static const char * PHRASES[][2] = {
+  { "ice", "glace" },
+  { "cream", "creme" },
+  { "ice cream", "creme glacee" },
+  { "ice cream cone", "cornet" },
+  { "new york", "NEW-YORK" },
+  { "new york city", "NYC" },
+  { "don't", "ne pas" },
+  { "e-mail", "courriel" },
+  { "caf\xC3\xA9", "kahvila" }
+};
+
+// Description: Returns a Dictionary of PHRASES under "normalization".
+Dictionary makeDictionary(unsigned int normalization) {
+
+  Dictionary myWords;
+  myWords.setNormalization(normalization);
+  for (const auto & phrase : PHRASES) {
+     WordPair aWord(phrase[0], phrase[1]);
+     myWords.put(aWord);
+  }
+  return myWords;
+}
+
+// Description: Returns the translation of "text" by "translator".
+string translated(const PhraseTranslator & translator, const string & text) {
+
+  string out;
+  translator.translate(text.data(), text.size(), out);
+  return out;
+}
+
+// Description: Returns true if "c" is part of a word.
+bool isWordByte(unsigned char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+         || c == '\'' || c == '-' || c >= 0x80;
+}
+
+// Description: Translates "text" the slow way: at each word, every run of words
+//              separated by blanks only is tried, longest first, against "keys".
+string naiveTranslation(const std::map<string, string> & keys, const string & text) {
+
+  struct Word { size_t start, end; bool joined; };
+  std::vector<Word> words;
+  bool onlyBlanks = false;
+  for (size_t i = 0; i < text.size(); ) {
+     if (isWordByte(text[i])) {
+        size_t end = i;
+        while (end < text.size() && isWordByte(text[end])) end++;
+        words.push_back({ i, end, onlyBlanks });
+        onlyBlanks = true;
+        i = end;
+     }
+     else {
+        if (text[i] != ' ' && text[i] != '\t') onlyBlanks = false;
+        i++;
+     }
+  }
+  string out;
+  size_t copied = 0;
+  for (size_t i = 0; i < words.size(); i++) {
+     size_t last = i;
+     while (last + 1 < words.size() && words[last + 1].joined) last++;
+     for (size_t end = last + 1; end > i; end--) {
+        string phrase;
+        for (size_t j = i; j < end; j++) {
+           phrase += (j > i ? " " : "") + text.substr(words[j].start, words[j].end - words[j].start);
+        }
+        auto found = keys.find(phrase);
+        if (found != keys.end()) {
+           out += text.substr(copied, words[i].start - copied) + found->second;
+           copied = words[end - 1].end;
+           i = end - 1;
+           break;
+        }
+     }
+  }
+  return out + text.substr(copied);
+}
+
+// Description: Checks the longest match and the boundaries phrases may not cross.
+void testLongestMatchAndBoundaries() {
+
+  PhraseTranslator translator(makeDictionary(KeyNormalizer::NONE));
+  const char * cases[][2] = {
+     { "ice", "glace" },
+     { "ice cream", "creme glacee" },
+     { "ice cream cone", "cornet" },
+     { "ice cream cones", "creme glacee cones" },
+     { "ice creamy", "glace creamy" },
+     { "ice  \t cream", "creme glacee" },
+     { "ice, cream", "glace, creme" },
+     { "ice.cream", "glace.creme" },
+     { "ice\ncream", "glace\ncreme" },
+     { "(ice cream)", "(creme glacee)" },
+     { "icecream", "icecream" },
+     { "new york city", "NYC" },
+     { "new york cities", "NEW-YORK cities" },
+     { "new yorker", "new yorker" },
+     { "I don't like e-mail", "I ne pas like courriel" },
+     { "dont email", "dont email" },
+     { "caf\xC3\xA9 caf\xC3\xA9s", "kahvila caf\xC3\xA9s" },
+     { "", "" }
+  };
+  bool passed = true;
+  for (const auto & aCase : cases) {
+     string out = translated(translator, aCase[0]);
+     if (out != aCase[1]) {
+        cout << "   \"" << aCase[0] << "\" gave \"" << out << "\", not \"" << aCase[1] << "\"" << endl;
+        passed = false;
+     }
+  }
+  report.check("longest match and punctuation boundaries", passed);
+}
+
+// Description: Checks that keys follow the normalization policy, and that keys
+//              holding punctuation are skipped.
+void testNormalizationAndSkippedKeys() {
+
+  Dictionary myWords = makeDictionary(KeyNormalizer::ALL);
+  WordPair punctuated("u.s.a.", "USA");
+  myWords.put(punctuated);
+  PhraseTranslator translator(myWords);
+  bool passed = translator.getPhraseCount() == sizeof(PHRASES) / sizeof(PHRASES[0])
+                && translator.getSkippedKeyCount() == 1
+                && translated(translator, "ICE Cream, New York City!") == "creme glacee, NYC!"
+                && translated(translator, "CAFE and CAF\xC3\x89") == "kahvila and kahvila"
+                && translated(translator, "u.s.a.") == "u.s.a.";
+  report.check("normalized keys, keys with punctuation skipped", passed);
+}
+
+// Description: Translates random texts over the words of the keys, some others,
+//              and separators, and checks them against the naive translator.
+void testAgainstNaiveTranslation() {
+
+  PhraseTranslator translator(makeDictionary(KeyNormalizer::NONE));
+  std::map<string, string> keys;
+  for (const auto & phrase : PHRASES) {
+     keys[phrase[0]] = phrase[1];
+  }
+  const char * words[] = { "ice", "cream", "cone", "new", "york", "city", "don't", "e-mail",
+                           "caf\xC3\xA9", "creamy", "-", "x" };
+  const char * separators[] = { " ", " ", " ", "  ", "\t", ", ", ".", "\n", " (", ") ", "" };
+  std::mt19937 generator(2023);
+  bool passed = true;
+  for (unsigned int text = 0; passed && text < 2000; text++) {
+     string input;
+     unsigned int length = generator() % 20;
+     for (unsigned int i = 0; i < length; i++) {
+        input += separators[generator() % (sizeof(separators) / sizeof(separators[0]))];
+        input += words[generator() % (sizeof(words) / sizeof(words[0]))];
+     }
+     string expected = naiveTranslation(keys, input);
+     string out = translated(translator, input);
+     if (out != expected) {
+        cout << "   \"" << input << "\" gave \"" << out << "\", not \"" << expected << "\"" << endl;
+        passed = false;
+     }
+  }
+  report.check("random texts agree with a naive translator", passed);
+}
+
+// Description: Streams many lines, more than a block holds, and checks that
+//              every line is translated whole.
+void testStream() {
+
+  PhraseTranslator translator(makeDictionary(KeyNormalizer::NONE));
+  std::ostringstream text;
+  std::ostringstream expected;
+  for (unsigned int i = 0; i < 200000; i++) {
+     text << "an ice cream cone, new york city " << i << "\n";
+     expected << "an cornet, NYC " << i << "\n";
+  }
+  std::istringstream in(text.str());
+  std::ostringstream out;
+  translator.translate(in, out);
+  report.check("a stream of many lines", out.str() == expected.str());
+}
+
+int main() {
+
+  testLongestMatchAndBoundaries();
+  testNormalizationAndSkippedKeys();
+  testAgainstNaiveTranslation();
+  testStream();
+
+  return report.summarize();
+}
@@ -0,0 +1,372 @@
+/*
+ * QueryReplay.cpp
+ * 
+ * Description: Replays a captured query log against a Dictionary loaded from
+ *              a data file and reports latency percentiles, throughput and
+ *              miss ratio.
+ *
+ *              Usage: replay [-n] [-o] [-f falsePositiveRate] [-t threads] [-s timeScale] [-b backend] [-c cachePages] [-m mergeThreshold] dataFile queryLog
+ *
+ *              Each line of the query log is either a word, or a time offset
+ *              in microseconds, a tab and a word. With -s, timed queries are
+ *              issued at their offset divided by "timeScale" (1 = real time,
+ *              2 = twice as fast); latency is then measured from the time a
+ *              query was due, so a stall also counts against the queries
+ *              that queued up behind it. Without -s, queries run back to back.
+ *              Queries are dealt round-robin to the threads.
+ *              Backends: bst (default), btree, compact, skiplist, sharded, and
+ *              disk or disk-clock, which write the words to a temporary page
+ *              file and read it through a cache of "cachePages" pages (256 by
+ *              default) evicted by LRU or CLOCK, and tiered, which puts the
+ *              words one by one into a compact base and a delta merged into it
+ *              once it holds "mergeThreshold" words (4096 by default) or 1/8 of
+ *              the base.
+ *              With -f, the bst backend checks a Bloom filter before each lookup.
+ *              With -o, the log is first replayed once to count the accesses
+ *              of each word and the bst is rebuilt for them before the replay.
+ *              Only the bst has a shape to rebuild, so -o needs -b bst.
+ *
+ * Author: Aidan de Vaal
+ * Last Modification Date: Nov. 3, 2023
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <unistd.h>
+#include "BTreeDictionary.h"
+#include "Dictionary.h"
+#include "DictionaryLoader.h"
+#include "DiskDictionary.h"
+#include "DiskDictionaryBuilder.h"
+#include "FrontCodedDictionary.h"
+#include "LatencyHistogram.h"
+#include "ShardedDictionary.h"
+#include "SkipListDictionary.h"
+#include "TieredDictionary.h"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+typedef std::chrono::steady_clock Clock;
+
+// One line of the query log.
+struct Query {
+  long long offsetMicroseconds = 0;
+  string word;
+};
+
+// What each replay thread measured.
+struct ThreadResult {
+  LatencyHistogram latencies;
+  unsigned long misses = 0;
+};
+
+// Description: Returns the queries of "filename", or an empty vector if it cannot be read.
+vector<Query> readQueryLog(const string & filename) {
+
+  vector<Query> queries;
+  std::ifstream log(filename);
+  string line;
+  while (getline(log, line)) {
+     Query query;
+     size_t tab = line.find('\t');
+     if (tab != string::npos) {
+        query.offsetMicroseconds = atoll(line.substr(0, tab).c_str());
+        query.word = line.substr(tab + 1);
+     }
+     else {
+        query.word = line;
+     }
+     queries.push_back(query);
+  }
+  return queries;
+}
+
+// Description: Returns a lookup function over "words" stored in "backend", which
+//              returns false on a miss. "keepAlive" owns the backend's storage.
+std::function<bool(WordPair &)> makeLookup(const string & backend, std::shared_ptr<Dictionary> words,
+                                           unsigned int cachePages, unsigned int mergeThreshold,
+                                           std::shared_ptr<void> & keepAlive) {
+
+  unsigned int normalization = words->getNormalization();
+  if (backend == "disk" || backend == "disk-clock") {
+     char fileName[] = "/tmp/replay-XXXXXX";
+     int fd = mkstemp(fileName);
+     if (fd < 0) {
+        throw std::logic_error("Unable to create a temporary file.");
+     }
+     close(fd);
+     //the file is removed once open: it lasts as long as the DiskDictionary
+     std::shared_ptr<DiskDictionary> disk;
+     try {
+        DiskDictionaryBuilder::build(*words, fileName);
+        disk = std::make_shared<DiskDictionary>(fileName, cachePages,
+                  backend == "disk" ? PageCache::LRU : PageCache::CLOCK);
+     }
+     catch (std::logic_error & anException) {
+        unlink(fileName);
+        throw;
+     }
+     unlink(fileName);
+     keepAlive = disk;
+     return [disk](WordPair & query) {
+        try { disk->get(query); return true; }
+        catch (ElementDoesNotExistException & anException) { return false; }
+     };
+  }
+  if (backend == "btree" || backend == "skiplist" || backend == "sharded") {
+     std::shared_ptr<BTreeDictionary> btree;
+     std::shared_ptr<SkipListDictionary> skipList;
+     std::shared_ptr<ShardedDictionary> sharded;
+     if (backend == "btree") btree = std::make_shared<BTreeDictionary>(normalization);
+     if (backend == "skiplist") skipList = std::make_shared<SkipListDictionary>(normalization);
+     if (backend == "sharded") sharded = std::make_shared<ShardedDictionary>(16, ShardedDictionary::BY_HASH, normalization);
+     words->displayContent([&](WordPair & element) {
+        WordPair copy(element.getEnglish(), element.getTranslation());
+        if (btree) btree->put(copy);
+        if (skipList) skipList->put(copy);
+        if (sharded) sharded->put(copy);
+     });
+     if (btree) {
+        keepAlive = btree;
+        return [btree](WordPair & query) {
+           try { btree->get(query); return true; }
+           catch (ElementDoesNotExistException & anException) { return false; }
+        };
+     }
+     if (skipList) {
+        keepAlive = skipList;
+        return [skipList](WordPair & query) {
+           try { skipList->get(query); return true; }
+           catch (ElementDoesNotExistException & anException) { return false; }
+        };
+     }
+     keepAlive = sharded;
+     return [sharded](WordPair & query) {
+        try { sharded->get(query); return true; }
+        catch (ElementDoesNotExistException & anException) { return false; }
+     };
+  }
+  if (backend == "tiered") {
+     //put one at a time and in no particular order, as a trickle of new words
+     //would come, so that the base is built by merges
+     vector<WordPair> trickle;
+     words->displayContent([&trickle](WordPair & element) {
+        trickle.push_back(WordPair(element.getEnglish(), element.getTranslation()));
+     });
+     std::shuffle(trickle.begin(), trickle.end(), std::mt19937(1));
+     std::shared_ptr<TieredDictionary> tiered = std::make_shared<TieredDictionary>(normalization, mergeThreshold);
+     for (WordPair & element : trickle) {
+        tiered->put(element);
+     }
+     keepAlive = tiered;
+     return [tiered](WordPair & query) {
+        try { tiered->get(query); return true; }
+        catch (ElementDoesNotExistException & anException) { return false; }
+     };
+  }
+  if (backend == "compact") {
+     std::shared_ptr<FrontCodedDictionary> compact = std::make_shared<FrontCodedDictionary>(*words);
+     keepAlive = compact;
+     return [compact](WordPair & query) {
+        try { compact->get(query); return true; }
+        catch (ElementDoesNotExistException & anException) { return false; }
+     };
+  }
+  keepAlive = words;
+  //get() checks the Bloom filter itself, if there is one
+  return [words](WordPair & query) {
+     try { words->get(query); return true; }
+     catch (ElementDoesNotExistException & anException) { return false; }
+  };
+}
+
+// Description: Counts the accesses of "queries" to "words", rebuilds it for them and
+//              reports the average comparisons per lookup found, before and after,
+//              next to the entropy of those lookups (the best any tree can do, give or take 2).
+//              Counting is then turned off again.
+void optimizeForQueries(Dictionary & words, const vector<Query> & queries) {
+
+  words.enableAccessCounts();
+  std::unordered_map<string, unsigned long> hits;
+  for (const Query & query : queries) {
+     WordPair target(query.word);
+     try {
+        hits[words.get(target).getKey()]++;
+     }
+     catch (ElementDoesNotExistException & anException) { }
+  }
+  double entropy = 0;
+  double found = 0;
+  for (const auto & hit : hits) found += hit.second;
+  for (const auto & hit : hits) {
+     double p = hit.second / found;
+     entropy -= p * std::log2(p);
+  }
+  double before = words.getAverageAccessComparisons();
+  words.rebuildForAccesses();
+  cout << std::fixed << std::setprecision(2) << "comparisons: " << before << " per lookup found, "
+       << words.getAverageAccessComparisons() << " after rebuild (entropy " << entropy
+       << ", log2 n " << std::log2((double) words.getElementCount()) << ")" << endl;
+  cout.unsetf(std::ios::floatfield);
+  //the timed replay measures the lookups alone, not the counting
+  words.disableAccessCounts();
+}
+
+int main(int argc, char *argv[]) {
+
+  unsigned int threads = 1;
+  double timeScale = 0;
+  string backend = "bst";
+  unsigned int normalization = KeyNormalizer::NONE;
+  double falsePositiveRate = 0;
+  unsigned int cachePages = 256;
+  unsigned int mergeThreshold = 4096;
+  bool optimize = false;
+  vector<string> files;
+  for (int i = 1; i < argc; i++) {
+     if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+     else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) timeScale = atof(argv[++i]);
+     else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) backend = argv[++i];
+     else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) falsePositiveRate = atof(argv[++i]);
+     else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) cachePages = atoi(argv[++i]);
+     else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) mergeThreshold = atoi(argv[++i]);
+     else if (strcmp(argv[i], "-o") == 0) optimize = true;
+     else if (strcmp(argv[i], "-n") == 0) normalization = KeyNormalizer::ALL;
+     else files.push_back(argv[i]);
+  }
+  if (files.size() != 2 || threads == 0 || mergeThreshold == 0) {
+     cerr << "Usage: replay [-n] [-o] [-f falsePositiveRate] [-t threads] [-s timeScale] [-b bst|btree|compact|skiplist|sharded|disk|disk-clock|tiered] [-c cachePages] [-m mergeThreshold] dataFile queryLog" << endl;
+     return 1;
+  }
+  if (optimize && backend != "bst") {
+     cerr << "-o rebuilds the bst backend only, not " << backend << endl;
+     return 1;
+  }
+
+  std::shared_ptr<Dictionary> words = std::make_shared<Dictionary>();
+  words->setNormalization(normalization);
+  //the loader's progress lines are not wanted: a stream with no buffer drops them
+  std::ostream discard(nullptr);
+  if (!DictionaryLoader::load(files[0], *words, discard)) {
+     cerr << "Unable to open file " << files[0] << endl;
+     return 1;
+  }
+  if (words->getElementCount() == 0) {
+     cerr << files[0] << " holds no words" << endl;
+     return 1;
+  }
+  if (falsePositiveRate > 0) {
+     try {
+        words->enableBloomFilter(falsePositiveRate);
+     }
+     catch (std::logic_error & anException) {
+        cerr << anException.what() << endl;
+        return 1;
+     }
+  }
+  vector<Query> queries = readQueryLog(files[1]);
+  if (queries.empty()) {
+     cerr << "No queries in " << files[1] << endl;
+     return 1;
+  }
+  if (optimize) {
+     optimizeForQueries(*words, queries);
+  }
+  std::shared_ptr<void> keepAlive;
+  std::function<bool(WordPair &)> lookup;
+  try {
+     lookup = makeLookup(backend, words, cachePages, mergeThreshold, keepAlive);
+  }
+  catch (std::logic_error & anException) {
+     cerr << anException.what() << endl;
+     return 1;
+  }
+
+  // Every thread replays every threads-th query against the same start time.
+  vector<ThreadResult> results(threads);
+  vector<std::thread> workers;
+  Clock::time_point start = Clock::now();
+  for (unsigned int t = 0; t < threads; t++) {
+     workers.emplace_back([&, t]() {
+        ThreadResult & result = results[t];
+        for (size_t i = t; i < queries.size(); i += threads) {
+           WordPair query(queries[i].word);
+           Clock::time_point issued = Clock::now();
+           if (timeScale > 0) {
+              Clock::time_point due = start + std::chrono::microseconds(
+                 (long long) (queries[i].offsetMicroseconds / timeScale));
+              if (due > issued) {
+                 std::this_thread::sleep_until(due);
+              }
+              issued = due;
+           }
+           if (!lookup(query)) {
+              result.misses++;
+           }
+           result.latencies.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+              Clock::now() - issued).count());
+        }
+     });
+  }
+  for (std::thread & worker : workers) {
+     worker.join();
+  }
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  LatencyHistogram latencies;
+  unsigned long misses = 0;
+  for (const ThreadResult & result : results) {
+     latencies.merge(result.latencies);
+     misses += result.misses;
+  }
+
+  cout << "backend:     " << backend << " (" << words->getElementCount() << " words, "
+       << threads << " thread" << (threads > 1 ? "s" : "") << ")" << endl;
+  cout << "queries:     " << queries.size() << " in " << std::fixed << std::setprecision(3) << seconds << " s" << endl;
+  cout << "throughput:  " << std::setprecision(0) << queries.size() / seconds << " queries/s" << endl;
+  cout << "miss ratio:  " << std::setprecision(4) << (double) misses / queries.size() << endl;
+  cout << "latency ns:  mean " << std::setprecision(0) << latencies.getMean()
+       << "  p50 " << latencies.getPercentile(50)
+       << "  p90 " << latencies.getPercentile(90)
+       << "  p99 " << latencies.getPercentile(99)
+       << "  p99.9 " << latencies.getPercentile(99.9)
+       << "  max " << latencies.getMaximum() << endl;
+  if (backend == "disk" || backend == "disk-clock") {
+     const DiskDictionary & disk = *std::static_pointer_cast<DiskDictionary>(keepAlive);
+     const PageCache & cache = disk.getCache();
+     cout << "page cache:  " << cache.getCapacity() << " pages, " << disk.getPinnedPageCount()
+          << " pinned, height " << disk.getHeight() << ", " << cache.getReadCount() << " page reads, hit ratio "
+          << std::setprecision(4) << (double) cache.getHitCount() / (cache.getHitCount() + cache.getReadCount())
+          << ", " << disk.getMemoryUsage() << " bytes" << endl;
+  }
+  if (backend == "tiered") {
+     const TieredDictionary & tiered = *std::static_pointer_cast<TieredDictionary>(keepAlive);
+     cout << "tiers:       " << tiered.getBaseElementCount() << " words in the base ("
+          << tiered.getBaseMemoryUsage() << " bytes), " << tiered.getDeltaElementCount()
+          << " in the delta, " << tiered.getMergeCount() << " merges" << endl;
+  }
+  const BloomFilter * filter = words->getBloomFilter();
+  if (filter && backend == "bst") {
+     cout << "bloom filter: " << filter->getMemoryUsage() << " bytes, " << filter->getHashCount()
+          << " hashes, false-positive rate " << std::setprecision(4) << filter->getFalsePositiveRate()
+          << " configured, " << filter->getExpectedFalsePositiveRate() << " expected" << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,203 @@
+/*
+ * ReverseIndex.cpp
+ *
+ * Description: Secondary index of the elements of a Dictionary by their
+ *              translation, answering translation-to-English lookups in
+ *              O(1) expected time.
+ *              Open-addressing hash table (linear probing) whose slots hold
+ *              the hash of a translation and the BST node of its element:
+ *              the index points at the Dictionary's own nodes and stores
+ *              no strings. A translation shared by several elements has a
+ *              slot for each of them.
+ *              The index does not own the nodes: the Dictionary keeps it in
+ *              step with its tree, replacing a node whenever the tree copies it.
+ *              The slots are kept in a ChunkedArray, so a copy of the index
+ *              (taken by a Dictionary put after a snapshot) shares them
+ *              until an insert or a replace writes to their chunk.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "ReverseIndex.h"
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+/* Constructor */
+
+   ReverseIndex::ReverseIndex(unsigned int normalization, unsigned int capacity)
+      : normalizer(normalization) {
+
+      size_t size = 16;
+      while (size * 7 < (size_t) capacity * 10) {
+         size *= 2;
+      }
+      slots.assign(size, Slot());
+   }
+
+
+/* Getters */
+
+   // Description: Returns the number of elements in the index.
+   unsigned int ReverseIndex::getElementCount() const {
+      return elementCount;
+   }
+
+   // Description: Returns the number of bytes used by the index.
+   size_t ReverseIndex::getMemoryUsage() const {
+      return sizeof(*this) - sizeof(slots) + slots.getMemoryUsage();
+   }
+
+
+/* Index operations */
+
+   // Description: Adds the element of "node" to the index.
+   // Time efficiency: O(1) expected, amortized
+   void ReverseIndex::insert(const BSTNode * node) {
+
+      makeRoomFor(elementCount + 1);
+      place(hashOf(node->element.getTranslation()), node);
+      elementCount++;
+   }
+
+   // Description: Readies the index for a put of "element" whose insertion goes
+   //              through the nodes of "path".
+   // Exception: Throws the exception bad_alloc if memory ran out, leaving the index valid.
+   // Time efficiency: O(|path|) expected, amortized
+   ReverseIndex::Reservation ReverseIndex::reserve(const std::vector<const BSTNode *> & path,
+                                                   const WordPair & element) {
+
+      //growing moves every slot, so it comes before they are located
+      makeRoomFor(elementCount + 1);
+      Reservation reservation;
+      reservation.replaced.reserve(path.size());
+      for (const BSTNode * node : path) {
+         size_t position = positionOf(node);
+         if (position != slots.size()) {
+            slots.modify(position);
+            reservation.replaced.push_back(std::make_pair(node, position));
+         }
+      }
+      //replaces only change which node a slot points at, never which slots are free
+      reservation.hash = hashOf(element.getTranslation());
+      size_t mask = slots.size() - 1;
+      size_t i = firstSlot(reservation.hash);
+      while (slots[i].node != nullptr) {
+         i = (i + 1) & mask;
+      }
+      slots.modify(i);
+      reservation.freeSlot = i;
+      return reservation;
+   }
+
+   // Description: Adds "node", the element reserved by "reservation", to the index.
+   // Time efficiency: O(1)
+   void ReverseIndex::insert(const BSTNode * node, const Reservation & reservation) noexcept {
+
+      //reserve() already took this index's own copy of the chunk
+      Slot & slot = slots.modify(reservation.freeSlot);
+      slot.hash = reservation.hash;
+      slot.node = node;
+      elementCount++;
+   }
+
+   // Description: Makes the slot of "oldNode" point at "newNode", a copy of it.
+   // Time efficiency: O(|path|)
+   void ReverseIndex::replace(const BSTNode * oldNode, const BSTNode * newNode,
+                              const Reservation & reservation) noexcept {
+
+      for (const auto & replaced : reservation.replaced) {
+         if (replaced.first == oldNode) {
+            slots.modify(replaced.second).node = newNode;
+            return;
+         }
+      }
+   }
+
+   // Description: Returns the elements whose translation matches "translation", in key order.
+   // Time efficiency: O(1) expected, plus the number of matches
+   std::vector<WordPair> ReverseIndex::find(const string & translation) const {
+
+      std::vector<WordPair> found;
+      string query = normalizer.isIdentity() ? translation : normalizer.normalize(translation);
+      uint64_t hash = std::hash<string>()(query);
+      size_t mask = slots.size() - 1;
+      for (size_t i = firstSlot(hash); slots[i].node != nullptr; i = (i + 1) & mask) {
+         if (slots[i].hash != hash) {
+            continue;
+         }
+         //equal hashes are confirmed on the strings, normalized like the query
+         const string & candidate = slots[i].node->element.getTranslation();
+         if (normalizer.isIdentity() ? candidate == query : normalizer.normalize(candidate) == query) {
+            found.push_back(slots[i].node->element);
+         }
+      }
+      std::sort(found.begin(), found.end());
+      return found;
+   }
+
+
+/* Utility methods */
+
+   // Description: Returns the hash of "translation" once normalized.
+   uint64_t ReverseIndex::hashOf(const string & translation) const {
+
+      if (normalizer.isIdentity()) {
+         return std::hash<string>()(translation);
+      }
+      return std::hash<string>()(normalizer.normalize(translation));
+   }
+
+   // Description: Returns the slot where the probe sequence of "hash" starts.
+   unsigned int ReverseIndex::firstSlot(uint64_t hash) const {
+      //the product spreads every bit of the hash over the bits that pick the slot
+      return (unsigned int) ((hash * 0x9e3779b97f4a7c15ULL) >> 32) & (slots.size() - 1);
+   }
+
+   // Description: Doubles the table until "count" elements fill at most 70% of it.
+   void ReverseIndex::makeRoomFor(unsigned int count) {
+
+      size_t size = slots.size();
+      while ((size_t) count * 10 > size * 7) {
+         size *= 2;
+      }
+      if (size == slots.size()) {
+         return;
+      }
+      //the hashes are kept in the slots, so growing does not rehash any string
+      ChunkedArray<Slot> previous;
+      previous.assign(size, Slot());
+      std::swap(previous, slots);
+      for (size_t i = 0; i < previous.size(); i++) {
+         if (previous[i].node != nullptr) {
+            place(previous[i].hash, previous[i].node);
+         }
+      }
+   }
+
+   // Description: Returns the position of the slot of "node", or slots.size() if there is none.
+   size_t ReverseIndex::positionOf(const BSTNode * node) const {
+
+      uint64_t hash = hashOf(node->element.getTranslation());
+      size_t mask = slots.size() - 1;
+      for (size_t i = firstSlot(hash); slots[i].node != nullptr; i = (i + 1) & mask) {
+         if (slots[i].node == node) {
+            return i;
+         }
+      }
+      return slots.size();
+   }
+
+   // Description: Stores "node" with "hash" in the first free slot of its probe sequence.
+   void ReverseIndex::place(uint64_t hash, const BSTNode * node) {
+
+      size_t mask = slots.size() - 1;
+      size_t i = firstSlot(hash);
+      while (slots[i].node != nullptr) {
+         i = (i + 1) & mask;
+      }
+      Slot & slot = slots.modify(i);
+      slot.hash = hash;
+      slot.node = node;
+   }
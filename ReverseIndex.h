@@ -0,0 +1,116 @@
+/*
+ * ReverseIndex.h
+ *
+ * Description: Secondary index of the elements of a Dictionary by their
+ *              translation, answering translation-to-English lookups in
+ *              O(1) expected time.
+ *              Open-addressing hash table (linear probing) whose slots hold
+ *              the hash of a translation and the BST node of its element:
+ *              the index points at the Dictionary's own nodes and stores
+ *              no strings. A translation shared by several elements has a
+ *              slot for each of them.
+ *              The index does not own the nodes: the Dictionary keeps it in
+ *              step with its tree, replacing a node whenever the tree copies it.
+ *              The slots are kept in a ChunkedArray, so a copy of the index
+ *              (taken by a Dictionary put after a snapshot) shares them
+ *              until an insert or a replace writes to their chunk.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef REVERSE_INDEX_H
+#define REVERSE_INDEX_H
+
+#include "BSTNode.h"
+#include "ChunkedArray.h"
+#include "KeyNormalizer.h"
+#include "WordPair.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class ReverseIndex {
+
+private:
+
+   struct Slot {
+      uint64_t hash = 0;                        // of the normalized translation
+      const BSTNode * node = nullptr;           // nullptr when the slot is free
+   };
+
+   ChunkedArray<Slot> slots;                    // size is a power of 2
+   unsigned int elementCount = 0;
+   KeyNormalizer normalizer;                    // the Dictionary's policy, applied to translations
+
+   // Description: Returns the hash of "translation" once normalized.
+   uint64_t hashOf(const string & translation) const;
+
+   // Description: Returns the slot where the probe sequence of "hash" starts.
+   unsigned int firstSlot(uint64_t hash) const;
+
+   // Description: Stores "node" with "hash" in the first free slot of its probe sequence.
+   // Precondition: There is a free slot.
+   void place(uint64_t hash, const BSTNode * node);
+
+   // Description: Doubles the table until "count" elements fill at most 70% of it.
+   void makeRoomFor(unsigned int count);
+
+   // Description: Returns the position of the slot of "node", or slots.size() if there is none.
+   size_t positionOf(const BSTNode * node) const;
+
+public:
+
+   // What a put into the Dictionary will write to the index, located in advance.
+   struct Reservation {
+      std::vector< std::pair<const BSTNode *, size_t> > replaced;   // node, position of its slot
+      size_t freeSlot = 0;                                          // of the inserted node
+      uint64_t hash = 0;                                            // of the inserted node
+   };
+
+   // Constructor
+   // Description: An empty index whose translations are compared after the
+   //              "normalization" policy (KeyNormalizer flags), with room for
+   //              "capacity" elements before it grows.
+   ReverseIndex(unsigned int normalization = KeyNormalizer::NONE, unsigned int capacity = 0);
+
+   // Description: Returns the number of elements in the index.
+   unsigned int getElementCount() const;
+
+   // Description: Returns the number of bytes used by the index.
+   size_t getMemoryUsage() const;
+
+   // Description: Adds the element of "node" to the index.
+   //              The table doubles when it is more than 70% full.
+   // Time efficiency: O(1) expected, amortized
+   void insert(const BSTNode * node);
+
+   // Description: Readies the index for a put of "element" whose insertion goes
+   //              through the nodes of "path": makes room for one more element,
+   //              copies the chunks the put will write to if a copy of the index
+   //              shares them, and locates the slots. The insert and the replaces
+   //              of that put, given the reservation, then cannot throw, so the
+   //              index can always follow the nodes the tree copied.
+   // Exception: Throws the exception bad_alloc if memory ran out, leaving the index valid.
+   // Time efficiency: O(|path|) expected, amortized
+   Reservation reserve(const std::vector<const BSTNode *> & path, const WordPair & element);
+
+   // Description: Adds "node", the element reserved by "reservation", to the index.
+   // Precondition: The index did not change since reserve().
+   // Time efficiency: O(1)
+   void insert(const BSTNode * node, const Reservation & reservation) noexcept;
+
+   // Description: Makes the slot of "oldNode" point at "newNode", a copy of it.
+   //              Does nothing if "oldNode" is not on the path of "reservation".
+   // Precondition: The index did not change since reserve(), but for replaces.
+   // Time efficiency: O(|path|)
+   void replace(const BSTNode * oldNode, const BSTNode * newNode,
+                const Reservation & reservation) noexcept;
+
+   // Description: Returns the elements whose translation matches "translation",
+   //              in key order; none if there is no such element.
+   // Time efficiency: O(1) expected, plus the number of matches
+   std::vector<WordPair> find(const string & translation) const;
+
+}; // end ReverseIndex
+#endif
@@ -0,0 +1,220 @@
+/*
+ * ShardedDictionary.cpp
+ * 
+ * Description: Dictonary data collection ADT class for concurrent writers.
+ *              Keys are partitioned, by hash or by key range, across N
+ *              BSTs ("shards"), each with its own readers-writer lock and
+ *              element count, so puts to different shards run in parallel.
+ *              Traversals still visit every element in key order.
+ *              Duplicated elements not allowed.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "ShardedDictionary.h"
+#include <algorithm>
+#include <mutex>
+#include <queue>
+
+// Share, per mille, of the English words starting with each letter 'a' to 'z':
+// BY_RANGE shards split these weights evenly rather than the alphabet.
+static const unsigned int FIRST_LETTER_WEIGHTS[26] = {
+   60, 56, 96, 60, 40, 42, 34, 38, 36, 9, 9, 32, 55, 21, 26, 83, 5, 54, 115, 53, 29, 16, 23, 1, 3, 3
+};
+
+// Second characters told apart by BY_RANGE: none or below 'a', each of 'a' to 'z', above 'z'.
+static const unsigned int SECOND_LETTERS = 28;
+
+/* Constructor */
+
+   ShardedDictionary::ShardedDictionary(unsigned int shardCount, Partitioning partitioning,
+                                        unsigned int normalization)
+      : partitioning(partitioning), normalizer(normalization) {
+
+      if (shardCount == 0) {
+         shardCount = 1;
+      }
+      for (unsigned int i = 0; i < shardCount; i++) {
+         shards.push_back(std::unique_ptr<Shard>(new Shard()));
+      }
+      if (partitioning == BY_RANGE) {
+         //each first letter's weight is spread evenly over its second letters;
+         //positions only grow with the prefix, so shard order stays key order
+         double total = 0;
+         for (unsigned int weight : FIRST_LETTER_WEIGHTS) {
+            total += weight;
+         }
+         double before = 0;
+         for (unsigned int first = 0; first < 26; first++) {
+            for (unsigned int second = 0; second < SECOND_LETTERS; second++) {
+               double position = (before + FIRST_LETTER_WEIGHTS[first] * second / (double) SECOND_LETTERS) / total;
+               rangeShards.push_back(std::min(shardCount - 1, (unsigned int) (position * shardCount)));
+            }
+            before += FIRST_LETTER_WEIGHTS[first];
+         }
+      }
+   }
+
+
+/* Getters */
+
+   // Description: Returns the number of elements currently stored in the Dictionary.
+   // Time efficiency: O(N) for N shards
+   unsigned int ShardedDictionary::getElementCount() const {
+
+      unsigned int count = 0;
+      for (unsigned int shard = 0; shard < shards.size(); shard++) {
+         count += getShardElementCount(shard);
+      }
+      return count;
+   }
+
+   // Description: Returns the number of shards.
+   unsigned int ShardedDictionary::getShardCount() const {
+      return shards.size();
+   }
+
+   // Description: Returns the number of elements currently stored in shard "shard".
+   // Time efficiency: O(1)
+   unsigned int ShardedDictionary::getShardElementCount(unsigned int shard) const {
+      std::shared_lock<std::shared_mutex> guard(shards[shard]->lock);
+      return shards[shard]->keyValuePairs.getElementCount();
+   }
+
+
+/* Dictionary operations */
+
+   // Description: Puts "newElement" (association of key-value) into the Dictionary.
+   //              Only the shard of "newElement" is locked.
+   // Time efficiency: O(log2 (n / N))
+   void ShardedDictionary::put(WordPair & newElement) {
+
+      //normalize before locking, the lock only covers the tree descent
+      WordPair keyed = newElement;
+      if (!normalizer.isIdentity()) {
+         keyed.setKey(normalizer.normalize(newElement.getEnglish()));
+      }
+
+      Shard & shard = *shards[shardOf(keyed.getKey())];
+      std::unique_lock<std::shared_mutex> guard(shard.lock);
+      shard.keyValuePairs.insert(keyed);
+   }
+
+   // Description: Gets the element whose key matches "targetElement".
+   // Time efficiency: O(log2 (n / N)), O(N) when the shard of the key is empty
+   WordPair & ShardedDictionary::get(WordPair & targetElement) const {
+
+      WordPair query = makeQuery(targetElement);
+      const Shard & shard = *shards[shardOf(query.getKey())];
+      std::shared_lock<std::shared_mutex> guard(shard.lock);
+      if (shard.keyValuePairs.getElementCount() != 0) {
+         return shard.keyValuePairs.retrieve(query);
+      }
+      //an empty shard only means an empty Dictionary if every other shard is empty too
+      guard.unlock();
+      if (getElementCount() == 0)
+         throw EmptyDataCollectionException("Dictionary is empty.");
+      throw ElementDoesNotExistException("***Not Found!***");
+   }
+
+   // Description: Visits the content of the Dictionary in key order.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   void ShardedDictionary::displayContent(void visit(WordPair &)) const {
+      displayContent(std::function<void(WordPair &)>(visit));
+   }
+
+   // Description: Visits the content of the Dictionary in key order.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Time efficiency: O(n) by range, O(n log2 N) by hash
+   void ShardedDictionary::displayContent(const std::function<void(WordPair &)> & visit) const {
+
+      //always lock in shard order, writers only ever hold one shard lock
+      std::vector< std::shared_lock<std::shared_mutex> > guards;
+      unsigned int count = 0;
+      for (const std::unique_ptr<Shard> & shard : shards) {
+         guards.emplace_back(shard->lock);
+         count += shard->keyValuePairs.getElementCount();
+      }
+      if (count == 0)
+         throw EmptyDataCollectionException("Dictionary is empty.");
+
+      traverseLocked(visit);
+   }
+
+   // Description: Visits every element of every shard in key order.
+   // Precondition: The caller holds every shard's lock.
+   void ShardedDictionary::traverseLocked(const std::function<void(WordPair &)> & visit) const {
+
+      if (partitioning == BY_RANGE) {
+         //shards hold consecutive ranges, one after the other is in order
+         for (const std::unique_ptr<Shard> & shard : shards) {
+            if (shard->keyValuePairs.getElementCount() != 0) {
+               shard->keyValuePairs.traverseInOrder(visit);
+            }
+         }
+         return;
+      }
+
+      //merge the in-order sequences of every shard, smallest element first
+      typedef std::vector<BSTNode *> Cursor;          // stack of an in-order iteration
+      std::vector<Cursor> cursors(shards.size());
+      auto pushLeft = [](Cursor & cursor, BSTNode * node) {
+         for (; node != nullptr; node = node->left) {
+            cursor.push_back(node);
+         }
+      };
+      auto greater = [&cursors](unsigned int a, unsigned int b) {
+         return cursors[a].back()->element > cursors[b].back()->element;
+      };
+      std::priority_queue<unsigned int, std::vector<unsigned int>, decltype(greater)> next(greater);
+      for (unsigned int shard = 0; shard < shards.size(); shard++) {
+         pushLeft(cursors[shard], shards[shard]->keyValuePairs.root);
+         if (!cursors[shard].empty()) {
+            next.push(shard);
+         }
+      }
+      while (!next.empty()) {
+         unsigned int shard = next.top();
+         next.pop();
+         BSTNode * node = cursors[shard].back();
+         cursors[shard].pop_back();
+         pushLeft(cursors[shard], node->right);
+         visit(node->element);
+         if (!cursors[shard].empty()) {
+            next.push(shard);
+         }
+      }
+   }
+
+   // Description: Returns the shard of the element whose key is "key".
+   // Time efficiency: O(1) by range, O(|key|) by hash
+   unsigned int ShardedDictionary::shardOf(const string & key) const {
+
+      unsigned int shardCount = shards.size();
+      if (partitioning == BY_HASH) {
+         return std::hash<string>()(key) % shardCount;
+      }
+      //monotonic in the first two bytes, so shard order is key order
+      unsigned char first = key.empty() ? 0 : key[0];
+      if (first < 'a') {
+         return 0;
+      }
+      if (first > 'z') {
+         return shardCount - 1;
+      }
+      unsigned char second = (key.size() > 1) ? key[1] : 0;
+      unsigned int column = (second < 'a') ? 0 : (second > 'z') ? SECOND_LETTERS - 1 : second - 'a' + 1;
+      return rangeShards[(first - 'a') * SECOND_LETTERS + column];
+   }
+
+   // Description: Returns "targetElement" with its key normalized by the policy.
+   WordPair ShardedDictionary::makeQuery(const WordPair & targetElement) const {
+
+      if (normalizer.isIdentity()) {
+         return targetElement;
+      }
+      WordPair query;
+      query.setKey(normalizer.normalize(targetElement.getEnglish()));
+      return query;
+   }
@@ -0,0 +1,108 @@
+/*
+ * ShardedDictionary.h
+ * 
+ * Description: Dictonary data collection ADT class for concurrent writers.
+ *              Keys are partitioned, by hash or by key range, across N
+ *              BSTs ("shards"), each with its own readers-writer lock and
+ *              element count, so puts to different shards run in parallel.
+ *              Traversals still visit every element in key order.
+ *              Duplicated elements not allowed.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef SHARDED_DICTIONARY_H
+#define SHARDED_DICTIONARY_H
+
+#include "BST.h"
+#include "KeyNormalizer.h"
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+class ShardedDictionary {
+
+public:
+
+   // How keys are assigned to shards.
+   enum Partitioning {
+      BY_HASH,     // even spread; traversals merge the shards
+      BY_RANGE     // shards hold consecutive key ranges, split on the first two
+                   // letters so that each range holds about as many English words
+                   // (keys not starting with 'a'..'z' go to the first or last shard;
+                   // keys far from English spelling, or not lower case, are skewed)
+   };
+
+private:
+
+   struct Shard {
+      BST keyValuePairs;
+      mutable std::shared_mutex lock;     // shared for get, exclusive for put
+   };
+
+   std::vector< std::unique_ptr<Shard> > shards;
+   Partitioning partitioning;
+   KeyNormalizer normalizer;
+   std::vector<unsigned int> rangeShards;  // BY_RANGE: shard of each two-letter prefix, see shardOf()
+
+   // Description: Returns the shard of the element whose key is "key".
+   // Time efficiency: O(1) by range, O(|key|) by hash
+   unsigned int shardOf(const string & key) const;
+
+   // Description: Returns "targetElement" with its key normalized by the policy.
+   WordPair makeQuery(const WordPair & targetElement) const;
+
+   // Description: Visits every element of every shard in key order.
+   // Precondition: The caller holds every shard's lock.
+   void traverseLocked(const std::function<void(WordPair &)> & visit) const;
+
+public:
+
+   // Constructor
+   // Keys are compared after the "normalization" policy (KeyNormalizer flags).
+   ShardedDictionary(unsigned int shardCount, Partitioning partitioning = BY_HASH,
+                     unsigned int normalization = KeyNormalizer::NONE);
+
+   // Description: Returns the number of elements currently stored in the Dictionary.
+   // Time efficiency: O(N) for N shards
+   unsigned int getElementCount() const;
+
+   // Description: Returns the number of shards.
+   unsigned int getShardCount() const;
+
+   // Description: Returns the number of elements currently stored in shard "shard".
+   // Precondition: shard < getShardCount().
+   unsigned int getShardElementCount(unsigned int shard) const;
+
+   // Description: Puts "newElement" (association of key-value) into the Dictionary.
+   //              Only the shard of "newElement" is locked.
+   // Precondition: "newElement" does not already exist in the Dictionary.
+   // Exception: Throws the exception "UnableToInsertException" 
+   //            when newElement cannot be inserted in the Dictionary.  
+   // Exception: Throws the exception "ElementAlreadyExistsException" 
+   //            if "newElement" already exists in the Dictionary.
+   // Time efficiency: O(log2 (n / N))
+   void put(WordPair & newElement);
+
+   // Description: Gets the element whose key matches "targetElement".
+   //              Elements are never moved or removed, so the returned
+   //              reference stays valid while other threads put.
+   // Exception: Throws the exception ElementDoesNotExistException
+   //            if the key is not found in the Dictionary.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Time efficiency: O(log2 (n / N)), O(N) when the shard of the key is empty
+   WordPair & get(WordPair & targetElement) const;
+
+   // Description: Visits the content of the Dictionary in key order.
+   //              Every shard is locked for reading during the traversal,
+   //              so "visit" must not put into this Dictionary.
+   // Precondition: Dictionary is not empty.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Time efficiency: O(n) by range, O(n log2 N) by hash
+   void displayContent(void visit(WordPair &)) const;
+   void displayContent(const std::function<void(WordPair &)> & visit) const;
+
+}; // end ShardedDictionary
+#endif
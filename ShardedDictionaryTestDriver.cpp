@@ -0,0 +1,169 @@
+/*
+ * ShardedDictionaryTestDriver.cpp
+ *
+ * Description: Drives the testing of the ShardedDictionary ADT class, by hash
+ *              and by key range. Random puts and gets are checked against a
+ *              std::map holding what the Dictionary should, with keys starting
+ *              below, within and above the letters, so that every range column
+ *              is used, and puts from several threads are checked the same way.
+ *              Prints one line per check and returns the number of failures.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <atomic>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ShardedDictionary.h"
+#include "KeyNormalizer.h"
+#include "TestReport.h"
+#include "WordPair.h"
+#include "ElementAlreadyExistsException.h"
+#include "ElementDoesNotExistException.h"
+#include "EmptyDataCollectionException.h"
+
+using std::vector;
+
+static const unsigned int SHARD_COUNT = 16;
+
+static TestReport report;
+
+// Description: Returns a random key of 1 to 6 bytes. Most bytes are lower case
+//              letters; the others are below 'a' or above 'z', first or second.
+string randomKey(std::mt19937 & generator) {
+
+  const string others = " 0AZ_`{|~";
+  string key(1 + generator() % 6, 'a');
+  for (char & byte : key) {
+     byte = (generator() % 5 == 0) ? others[generator() % others.size()] : 'a' + generator() % 26;
+  }
+  return key;
+}
+
+// Description: Returns true if "myWords" holds exactly the content of "model",
+//              in key order, and its shards hold as many elements in total.
+bool holdsExactly(const ShardedDictionary & myWords, const std::map<string, string> & model) {
+
+  if (myWords.getElementCount() != model.size()) {
+     return false;
+  }
+  unsigned int inShards = 0;
+  for (unsigned int shard = 0; shard < myWords.getShardCount(); shard++) {
+     inShards += myWords.getShardElementCount(shard);
+  }
+  if (inShards != model.size()) {
+     return false;
+  }
+  bool passed = true;
+  auto next = model.begin();
+  myWords.displayContent([&passed, &next, &model](WordPair & anElement) {
+     if (next == model.end() || anElement.getEnglish() != next->first
+         || anElement.getTranslation() != next->second) {
+        passed = false;
+     }
+     else {
+        next++;
+     }
+  });
+  return passed && next == model.end();
+}
+
+// Description: Runs random puts, some of keys already put, and random gets,
+//              some of keys never put, checking each outcome against a model.
+void testAgainstModel(ShardedDictionary::Partitioning partitioning, const string & name) {
+
+  ShardedDictionary myWords(SHARD_COUNT, partitioning);
+  std::map<string, string> model;
+  std::mt19937 generator(2023);
+  bool passed = true;
+  try {
+     WordPair query("food");
+     myWords.get(query);
+     passed = false;
+  }
+  catch (EmptyDataCollectionException& anException) { }
+
+  for (unsigned int step = 0; passed && step < 40000; step++) {
+     string english = randomKey(generator);
+     if (generator() % 2 == 0) {
+        WordPair aWord(english, "translation" + std::to_string(step));
+        bool expected = (model.find(english) == model.end());
+        try {
+           myWords.put(aWord);
+           passed = expected;
+           model[english] = aWord.getTranslation();
+        }
+        catch (ElementAlreadyExistsException& anException) {
+           passed = !expected;
+        }
+     }
+     else if (!model.empty()) {
+        auto found = model.find(english);
+        WordPair query(english);
+        try {
+           WordPair & translated = myWords.get(query);
+           passed = (found != model.end() && translated.getTranslation() == found->second);
+        }
+        catch (ElementDoesNotExistException& anException) {
+           passed = (found == model.end());
+        }
+        catch (EmptyDataCollectionException& anException) {
+           passed = false;
+        }
+     }
+  }
+  report.check("random puts and gets agree with a model, " + name, passed && holdsExactly(myWords, model));
+}
+
+// Description: Puts the same random keys from several threads, each key put by
+//              every thread, and checks that each was put once and the content.
+void testConcurrentPuts(ShardedDictionary::Partitioning partitioning, const string & name) {
+
+  const unsigned int threadCount = 4;
+  ShardedDictionary myWords(SHARD_COUNT, partitioning);
+  std::mt19937 generator(2023);
+  vector<string> keys;
+  std::map<string, string> model;
+  for (unsigned int i = 0; i < 20000; i++) {
+     string english = randomKey(generator) + std::to_string(i % 100);
+     if (model.find(english) == model.end()) {
+        keys.push_back(english);
+        model[english] = "translation" + english;
+     }
+  }
+  std::atomic<unsigned int> puts{0};
+  vector<std::thread> threads;
+  for (unsigned int t = 0; t < threadCount; t++) {
+     threads.emplace_back([&, t]() {
+        for (unsigned int i = 0; i < keys.size(); i++) {
+           const string & english = keys[(i + t * keys.size() / threadCount) % keys.size()];
+           WordPair aWord(english, "translation" + english);
+           try {
+              myWords.put(aWord);
+              puts++;
+           }
+           catch (ElementAlreadyExistsException& anException) { }
+        }
+     });
+  }
+  for (std::thread & thread : threads) {
+     thread.join();
+  }
+  report.check("puts from " + std::to_string(threadCount) + " threads, " + name,
+               puts == keys.size() && holdsExactly(myWords, model));
+}
+
+int main() {
+
+  testAgainstModel(ShardedDictionary::BY_HASH, "by hash");
+  testAgainstModel(ShardedDictionary::BY_RANGE, "by range");
+  testConcurrentPuts(ShardedDictionary::BY_HASH, "by hash");
+  testConcurrentPuts(ShardedDictionary::BY_RANGE, "by range");
+
+  return report.summarize();
+}
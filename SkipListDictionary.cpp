@@ -0,0 +1,223 @@
+/*
+ * SkipListDictionary.cpp
+ * 
+ * Description: Dictonary data collection ADT class for many concurrent
+ *              writers and readers. Lock-free skip list implementation:
+ *              put and get only use atomic loads and compare-and-swap,
+ *              so no thread ever blocks another.
+ *              Duplicated elements not allowed.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "SkipListDictionary.h"
+#include <chrono>
+#include <new>
+#include <thread>
+
+/* Constructor and destructor */
+
+   SkipListDictionary::SkipListDictionary(unsigned int normalization) : normalizer(normalization) {
+      head = createNode(WordPair(), MAX_LEVEL);
+   }
+
+   // Destructor
+   // Precondition: No other thread uses the Dictionary any more.
+   SkipListDictionary::~SkipListDictionary() {
+      Node * node = head;
+      while (node != nullptr) {
+         Node * next = node->next[0].load(std::memory_order_relaxed);
+         destroyNode(node);
+         node = next;
+      }
+   }
+
+
+/* Getters */
+
+   // Description: Returns the number of elements currently stored in the Dictionary.
+   // Time efficiency: O(1)
+   unsigned int SkipListDictionary::getElementCount() const {
+      return elementCount.load(std::memory_order_relaxed);
+   }
+
+
+/* Dictionary operations */
+
+   // Description: Puts "newElement" (association of key-value) into the Dictionary.
+   // Time efficiency: O(log n) expected
+   void SkipListDictionary::put(WordPair & newElement) {
+
+      WordPair keyed = newElement;
+      if (!normalizer.isIdentity()) {
+         keyed.setKey(normalizer.normalize(newElement.getEnglish()));
+      }
+
+      Node * predecessors[MAX_LEVEL];
+      Node * successors[MAX_LEVEL];
+      if (find(keyed, predecessors, successors) != nullptr) {
+         throw ElementAlreadyExistsException("Element already exists.");
+      }
+      int height = randomHeight();
+      Node * newNode = createNode(keyed, height);
+
+      //linking level 0 is what makes the element part of the Dictionary
+      while (true) {
+         for (int level = 0; level < height; level++) {
+            newNode->next[level].store(successors[level], std::memory_order_relaxed);
+         }
+         Node * expected = successors[0];
+         if (predecessors[0]->next[0].compare_exchange_strong(expected, newNode,
+                                                              std::memory_order_release,
+                                                              std::memory_order_relaxed)) {
+            break;
+         }
+         //another put got in between, look again
+         if (find(keyed, predecessors, successors) != nullptr) {
+            //never linked, so no other thread can hold it
+            destroyNode(newNode);
+            throw ElementAlreadyExistsException("Element already exists.");
+         }
+      }
+      elementCount.fetch_add(1, std::memory_order_relaxed);
+
+      //the upper levels are only shortcuts, link them one by one
+      for (int level = 1; level < height; level++) {
+         while (true) {
+            Node * expected = successors[level];
+            if (predecessors[level]->next[level].compare_exchange_strong(expected, newNode,
+                                                                         std::memory_order_release,
+                                                                         std::memory_order_relaxed)) {
+               break;
+            }
+            find(keyed, predecessors, successors);
+            //not yet linked on this level, so it is still ours to update
+            newNode->next[level].store(successors[level], std::memory_order_relaxed);
+         }
+      }
+   }
+
+   // Description: Gets the element whose key matches "targetElement".
+   // Time efficiency: O(log n) expected
+   WordPair & SkipListDictionary::get(WordPair & targetElement) const {
+
+      if (getElementCount() == 0)
+         throw EmptyDataCollectionException("Dictionary is empty.");
+
+      WordPair query = makeQuery(targetElement);
+      Node * node = head;
+      for (int level = MAX_LEVEL - 1; level >= 0; level--) {
+         Node * next = node->next[level].load(std::memory_order_acquire);
+         while (next != nullptr && next->element < query) {
+            node = next;
+            next = node->next[level].load(std::memory_order_acquire);
+         }
+         if (next != nullptr && next->element == query) {
+            return next->element;
+         }
+      }
+      throw ElementDoesNotExistException("***Not Found!***");
+   }
+
+   // Description: Visits the content of the Dictionary in key order.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   void SkipListDictionary::displayContent(void visit(WordPair &)) const {
+      displayContent(std::function<void(WordPair &)>(visit));
+   }
+
+   // Description: Visits the content of the Dictionary in key order.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Time efficiency: O(n)
+   void SkipListDictionary::displayContent(const std::function<void(WordPair &)> & visit) const {
+
+      if (getElementCount() == 0)
+         throw EmptyDataCollectionException("Dictionary is empty.");
+
+      for (Node * node = head->next[0].load(std::memory_order_acquire); node != nullptr;
+           node = node->next[0].load(std::memory_order_acquire)) {
+         visit(node->element);
+      }
+   }
+
+
+/* Utility methods */
+
+   // Description: Fills "predecessors" and "successors" with, on each level,
+   //              the last node before "key" and the first node not before it.
+   // Postcondition: Returns successors[0] if its key equals "key", nullptr otherwise.
+   SkipListDictionary::Node * SkipListDictionary::find(const WordPair & key, Node ** predecessors,
+                                                       Node ** successors) const {
+      Node * node = head;
+      for (int level = MAX_LEVEL - 1; level >= 0; level--) {
+         Node * next = node->next[level].load(std::memory_order_acquire);
+         while (next != nullptr && next->element < key) {
+            node = next;
+            next = node->next[level].load(std::memory_order_acquire);
+         }
+         predecessors[level] = node;
+         successors[level] = next;
+      }
+      return (successors[0] != nullptr && successors[0]->element == key) ? successors[0] : nullptr;
+   }
+
+   // Description: Allocates a node of "height" levels holding "element".
+   //              The node and its links share one allocation: the links are
+   //              an array of their own, constructed right after the node.
+   SkipListDictionary::Node * SkipListDictionary::createNode(const WordPair & element, int height) {
+
+      size_t linksOffset = (sizeof(Node) + alignof(std::atomic<Node *>) - 1)
+                         / alignof(std::atomic<Node *>) * alignof(std::atomic<Node *>);
+      void * memory = ::operator new(linksOffset + height * sizeof(std::atomic<Node *>), std::nothrow);
+      if (memory == nullptr) {
+         throw UnableToInsertException("'new' operator failed.");
+      }
+      std::atomic<Node *> * links = reinterpret_cast<std::atomic<Node *> *>(static_cast<char *>(memory) + linksOffset);
+      for (int level = 0; level < height; level++) {
+         new (&links[level]) std::atomic<Node *>(nullptr);
+      }
+      try {
+         return new (memory) Node{element, height, links};
+      }
+      catch (...) {
+         ::operator delete(memory);
+         throw;
+      }
+   }
+
+   void SkipListDictionary::destroyNode(Node * node) {
+      //the links are trivially destructible, only the node itself needs destroying
+      node->~Node();
+      ::operator delete(node);
+   }
+
+   // Description: Returns a random height: level i+1 is reached with probability 1/4.
+   int SkipListDictionary::randomHeight() {
+
+      //xorshift per thread, so that writers share no state
+      thread_local unsigned long long state =
+         std::hash<std::thread::id>()(std::this_thread::get_id())
+         ^ (unsigned long long) std::chrono::steady_clock::now().time_since_epoch().count()
+         ^ 0x9E3779B97F4A7C15ULL;
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      int height = 1;
+      unsigned long long bits = state;
+      while (height < MAX_LEVEL && (bits & 3) == 0) {
+         height++;
+         bits >>= 2;
+      }
+      return height;
+   }
+
+   // Description: Returns "targetElement" with its key normalized by the policy.
+   WordPair SkipListDictionary::makeQuery(const WordPair & targetElement) const {
+
+      if (normalizer.isIdentity()) {
+         return targetElement;
+      }
+      WordPair query;
+      query.setKey(normalizer.normalize(targetElement.getEnglish()));
+      return query;
+   }
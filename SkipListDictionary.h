@@ -0,0 +1,108 @@
+/*
+ * SkipListDictionary.h
+ * 
+ * Description: Dictonary data collection ADT class for many concurrent
+ *              writers and readers. Lock-free skip list implementation:
+ *              put and get only use atomic loads and compare-and-swap,
+ *              so no thread ever blocks another.
+ *              Duplicated elements not allowed.
+ *
+ *              Memory reclamation: elements are never removed, so a node,
+ *              once linked, stays reachable until the Dictionary is destroyed
+ *              and readers can never hold a node that has been freed. A node
+ *              that loses a race to a duplicate was never linked and is freed
+ *              at once. All linked nodes are freed by the destructor, which
+ *              must not run while other threads still use the Dictionary.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef SKIP_LIST_DICTIONARY_H
+#define SKIP_LIST_DICTIONARY_H
+
+#include "KeyNormalizer.h"
+#include "WordPair.h"
+#include "ElementAlreadyExistsException.h"
+#include "ElementDoesNotExistException.h"
+#include "EmptyDataCollectionException.h"
+#include "UnableToInsertException.h"
+#include <atomic>
+#include <functional>
+
+class SkipListDictionary {
+
+private:
+
+   // Highest level of the skip list - enough for 4^16 elements.
+   static const int MAX_LEVEL = 16;
+
+   struct Node {
+      WordPair element;
+      int height;
+      std::atomic<Node *> * next;    // "height" links, allocated right after the node
+   };
+
+   Node * head = nullptr;            // sentinel before every element, MAX_LEVEL links
+   std::atomic<unsigned int> elementCount{0};
+   KeyNormalizer normalizer;
+
+   // Description: Allocates a node of "height" levels holding "element".
+   static Node * createNode(const WordPair & element, int height);
+   static void destroyNode(Node * node);
+
+   // Description: Returns a random height: level i+1 is reached with probability 1/4.
+   static int randomHeight();
+
+   // Description: Fills "predecessors" and "successors" with, on each level,
+   //              the last node before "key" and the first node not before it.
+   // Postcondition: Returns successors[0] if its key equals "key", nullptr otherwise.
+   Node * find(const WordPair & key, Node ** predecessors, Node ** successors) const;
+
+   // Description: Returns "targetElement" with its key normalized by the policy.
+   WordPair makeQuery(const WordPair & targetElement) const;
+
+   // Not copyable: copies would race with writers of the original.
+   SkipListDictionary(const SkipListDictionary &) = delete;
+   SkipListDictionary & operator=(const SkipListDictionary &) = delete;
+
+public:
+
+   // Constructor and destructor
+   // Keys are compared after the "normalization" policy (KeyNormalizer flags).
+   SkipListDictionary(unsigned int normalization = KeyNormalizer::NONE);
+   ~SkipListDictionary();
+
+   // Description: Returns the number of elements currently stored in the Dictionary.
+   // Time efficiency: O(1)
+   unsigned int getElementCount() const;
+
+   // Description: Puts "newElement" (association of key-value) into the Dictionary.
+   //              Safe to call from many threads at once.
+   // Precondition: "newElement" does not already exist in the Dictionary.
+   // Exception: Throws the exception "UnableToInsertException" 
+   //            when newElement cannot be inserted in the Dictionary.  
+   // Exception: Throws the exception "ElementAlreadyExistsException" 
+   //            if "newElement" already exists in the Dictionary.
+   // Time efficiency: O(log n) expected
+   void put(WordPair & newElement);
+
+   // Description: Gets the element whose key matches "targetElement".
+   //              Safe to call from many threads at once, also during puts.
+   //              The returned reference is valid until the Dictionary is destroyed.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Exception: Throws the exception ElementDoesNotExistException
+   //            if the key is not found in the Dictionary.
+   // Time efficiency: O(log n) expected
+   WordPair & get(WordPair & targetElement) const;
+
+   // Description: Visits the content of the Dictionary in key order.
+   //              Elements put during the traversal may or may not be visited.
+   // Precondition: Dictionary is not empty.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Time efficiency: O(n)
+   void displayContent(void visit(WordPair &)) const;
+   void displayContent(const std::function<void(WordPair &)> & visit) const;
+
+}; // end SkipListDictionary
+#endif
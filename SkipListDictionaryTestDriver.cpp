@@ -0,0 +1,185 @@
+/*
+ * SkipListDictionaryTestDriver.cpp
+ *
+ * Description: Drives the testing of the SkipListDictionary ADT class. Random
+ *              puts and gets are checked against a std::map holding what the
+ *              Dictionary should; then threads race to put the same keys while
+ *              readers get those already put, and each key must be put once.
+ *              Prints one line per check and returns the number of failures.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SkipListDictionary.h"
+#include "KeyNormalizer.h"
+#include "TestReport.h"
+#include "WordPair.h"
+#include "ElementAlreadyExistsException.h"
+#include "ElementDoesNotExistException.h"
+#include "EmptyDataCollectionException.h"
+
+using std::vector;
+
+static TestReport report;
+
+// Description: Returns true if "myWords" holds exactly the content of "model", in key order.
+bool holdsExactly(const SkipListDictionary & myWords, const std::map<string, string> & model) {
+
+  if (myWords.getElementCount() != model.size()) {
+     return false;
+  }
+  bool passed = true;
+  auto next = model.begin();
+  myWords.displayContent([&passed, &next, &model](WordPair & anElement) {
+     if (next == model.end() || anElement.getEnglish() != next->first
+         || anElement.getTranslation() != next->second) {
+        passed = false;
+     }
+     else {
+        next++;
+     }
+  });
+  return passed && next == model.end();
+}
+
+// Description: Runs random puts, some of keys already put, and random gets,
+//              some of keys never put, checking each outcome against a model.
+void testAgainstModel() {
+
+  SkipListDictionary myWords;
+  std::map<string, string> model;
+  std::mt19937 generator(2023);
+  std::uniform_int_distribution<unsigned int> keys(0, 19999);
+  bool passed = true;
+  try {
+     WordPair query("food");
+     myWords.get(query);
+     passed = false;
+  }
+  catch (EmptyDataCollectionException& anException) { }
+
+  for (unsigned int step = 0; passed && step < 50000; step++) {
+     string english = "word" + std::to_string(keys(generator));
+     if (generator() % 2 == 0) {
+        WordPair aWord(english, "translation" + std::to_string(step));
+        bool expected = (model.find(english) == model.end());
+        try {
+           myWords.put(aWord);
+           passed = expected;
+           model[english] = aWord.getTranslation();
+        }
+        catch (ElementAlreadyExistsException& anException) {
+           passed = !expected;
+        }
+     }
+     else if (!model.empty()) {
+        auto found = model.find(english);
+        WordPair query(english);
+        try {
+           WordPair & translated = myWords.get(query);
+           passed = (found != model.end() && translated.getTranslation() == found->second);
+        }
+        catch (ElementDoesNotExistException& anException) {
+           passed = (found == model.end());
+        }
+     }
+  }
+  report.check("random puts and gets agree with a model", passed && holdsExactly(myWords, model));
+}
+
+// Description: Writers put every key, each from a different starting point, so
+//              that they race on the same keys; readers meanwhile get random keys
+//              and check the translation of those found. Each key must be put
+//              by exactly one writer.
+void testConcurrentPutsAndGets() {
+
+  const unsigned int wordCount = 20000;
+  const unsigned int writers = 3;
+  const unsigned int readers = 2;
+  SkipListDictionary myWords;
+  vector<unsigned int> order(wordCount);
+  for (unsigned int i = 0; i < wordCount; i++) {
+     order[i] = i;
+  }
+  std::shuffle(order.begin(), order.end(), std::mt19937(2023));
+
+  std::atomic<unsigned int> puts{0};
+  std::atomic<unsigned int> wrong{0};
+  std::atomic<unsigned int> writing{writers};
+  vector<std::thread> threads;
+  for (unsigned int w = 0; w < writers; w++) {
+     threads.emplace_back([&, w]() {
+        for (unsigned int i = 0; i < wordCount; i++) {
+           unsigned int word = order[(i + w * wordCount / writers) % wordCount];
+           WordPair aWord("word" + std::to_string(word), "translation" + std::to_string(word));
+           try {
+              myWords.put(aWord);
+              puts++;
+           }
+           catch (ElementAlreadyExistsException& anException) { }
+        }
+        writing--;
+     });
+  }
+  for (unsigned int r = 0; r < readers; r++) {
+     threads.emplace_back([&, r]() {
+        std::mt19937 generator(r);
+        while (writing > 0) {
+           unsigned int word = generator() % wordCount;
+           WordPair query("word" + std::to_string(word));
+           try {
+              if (myWords.get(query).getTranslation() != "translation" + std::to_string(word)) {
+                 wrong++;
+              }
+           }
+           catch (ElementDoesNotExistException& anException) { }
+           catch (EmptyDataCollectionException& anException) { }
+        }
+     });
+  }
+  for (std::thread & thread : threads) {
+     thread.join();
+  }
+
+  std::map<string, string> model;
+  for (unsigned int i = 0; i < wordCount; i++) {
+     model["word" + std::to_string(i)] = "translation" + std::to_string(i);
+  }
+  report.check("writers racing on the same keys put each once",
+               puts == wordCount && wrong == 0 && holdsExactly(myWords, model));
+}
+
+// Description: Checks that keys follow the normalization policy.
+void testNormalization() {
+
+  SkipListDictionary myWords(KeyNormalizer::ALL);
+  WordPair cafe("Café", "kahvila");
+  myWords.put(cafe);
+  WordPair query("  CAFE ");
+  bool passed = myWords.get(query).getEnglish() == "Café";
+  try {
+     WordPair duplicate("cafe", "kafe");
+     myWords.put(duplicate);
+     passed = false;
+  }
+  catch (ElementAlreadyExistsException& anException) { }
+  report.check("normalized keys", passed && myWords.getElementCount() == 1);
+}
+
+int main() {
+
+  testAgainstModel();
+  testConcurrentPutsAndGets();
+  testNormalization();
+
+  return report.summarize();
+}
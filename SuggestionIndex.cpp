@@ -0,0 +1,150 @@
+/*
+ * SuggestionIndex.cpp
+ * 
+ * Description: BK-tree over the keys of a Dictionary, answering
+ *              "did you mean" queries: the keys closest to a word
+ *              by edit (Levenshtein) distance.
+ *              Each child of a node is labelled with its distance to the
+ *              node, so by the triangle inequality a search within radius r
+ *              of a word at distance d from a node only visits the children
+ *              labelled d - r to d + r.
+ *              The nodes are kept in a ChunkedArray, so a copy of the index
+ *              (taken by a Dictionary put after a snapshot) shares them
+ *              until an insert writes to their chunk.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "SuggestionIndex.h"
+#include <algorithm>
+
+   // Description: Returns the number of keys in the index.
+   // Time efficiency: O(1)
+   unsigned int SuggestionIndex::getElementCount() const {
+      return nodes.size();
+   }
+
+   // Description: Adds "key" (displayed as "english") to the index.
+   // Time efficiency: O(depth * |key|^2 + CHUNK_SIZE)
+   void SuggestionIndex::insert(const string & key, const string & english) {
+
+      Node newNode;
+      newNode.key = key;
+      if (english != key) {
+         newNode.english = english;
+      }
+      if (nodes.empty()) {
+         nodes.push_back(newNode);
+         return;
+      }
+
+      //walk down the edges labelled with the distance to each node
+      unsigned int current = 0;
+      while (true) {
+         unsigned int d = distance(key, nodes[current].key, (unsigned int) -1);
+         if (d == 0) {
+            return;
+         }
+         bool descended = false;
+         for (const auto & child : nodes[current].children) {
+            if (child.first == d) {
+               current = child.second;
+               descended = true;
+               break;
+            }
+         }
+         if (!descended) {
+            //the node before the edge: should the edge fail to be added, the node
+            //is merely unreachable, whereas an edge to a missing node is not harmless
+            nodes.push_back(newNode);
+            nodes.modify(current).children.push_back(std::make_pair(d, (unsigned int) nodes.size() - 1));
+            return;
+         }
+      }
+   }
+
+   // Description: Returns the English words of at most "k" keys within edit
+   //              distance "maxDistance" of "key", closest first (ties in key order).
+   vector<string> SuggestionIndex::suggest(const string & key, unsigned int k, unsigned int maxDistance) const {
+
+      vector< std::pair<unsigned int, unsigned int> > best;     // (distance, node index)
+      if (nodes.empty() || k == 0) {
+         return vector<string>();
+      }
+
+      unsigned int radius = maxDistance;
+      vector<unsigned int> pending(1, 0);
+      while (!pending.empty()) {
+         unsigned int current = pending.back();
+         pending.pop_back();
+
+         //a node farther than radius + largest edge cannot lead anywhere, the cutoff is safe
+         const Node & node = nodes[current];
+         unsigned int widest = 0;
+         for (const auto & child : node.children) {
+            widest = std::max(widest, child.first);
+         }
+         unsigned int d = distance(key, node.key, radius + widest);
+
+         if (d <= radius) {
+            best.push_back(std::make_pair(d, current));
+            std::sort(best.begin(), best.end(), [this](const std::pair<unsigned int, unsigned int> & a,
+                                                      const std::pair<unsigned int, unsigned int> & b) {
+               return a.first != b.first ? a.first < b.first : nodes[a.second].key < nodes[b.second].key;
+            });
+            if (best.size() > k) {
+               best.pop_back();
+            }
+            //once k suggestions are known, only closer ones (or equally close) can replace them
+            if (best.size() == k) {
+               radius = best.back().first;
+            }
+         }
+         for (const auto & child : node.children) {
+            if (child.first + radius >= d && child.first <= d + radius) {
+               pending.push_back(child.second);
+            }
+         }
+      }
+
+      vector<string> words;
+      for (const auto & found : best) {
+         const Node & node = nodes[found.second];
+         words.push_back(node.english.empty() ? node.key : node.english);
+      }
+      return words;
+   }
+
+   // Description: Returns the edit distance between "a" and "b", or any value
+   //              above "limit" as soon as the distance is known to exceed it.
+   // Time efficiency: O(|a| * |b|)
+   unsigned int SuggestionIndex::distance(const string & a, const string & b, unsigned int limit) {
+
+      size_t lengthDifference = (a.size() > b.size()) ? a.size() - b.size() : b.size() - a.size();
+      if (lengthDifference > limit) {
+         return limit + 1;
+      }
+
+      //two rows of the dynamic programming table
+      vector<unsigned int> previous(b.size() + 1);
+      vector<unsigned int> row(b.size() + 1);
+      for (size_t j = 0; j <= b.size(); j++) {
+         previous[j] = j;
+      }
+      for (size_t i = 1; i <= a.size(); i++) {
+         row[0] = i;
+         unsigned int rowMinimum = row[0];
+         for (size_t j = 1; j <= b.size(); j++) {
+            unsigned int substitution = previous[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1);
+            row[j] = std::min(std::min(previous[j] + 1, row[j - 1] + 1), substitution);
+            rowMinimum = std::min(rowMinimum, row[j]);
+         }
+         //every later row is at least this row's minimum
+         if (rowMinimum > limit) {
+            return limit + 1;
+         }
+         previous.swap(row);
+      }
+      return previous[b.size()];
+   }
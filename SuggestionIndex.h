@@ -0,0 +1,65 @@
+/*
+ * SuggestionIndex.h
+ * 
+ * Description: BK-tree over the keys of a Dictionary, answering
+ *              "did you mean" queries: the keys closest to a word
+ *              by edit (Levenshtein) distance.
+ *              Each child of a node is labelled with its distance to the
+ *              node, so by the triangle inequality a search within radius r
+ *              of a word at distance d from a node only visits the children
+ *              labelled d - r to d + r.
+ *              The nodes are kept in a ChunkedArray, so a copy of the index
+ *              (taken by a Dictionary put after a snapshot) shares them
+ *              until an insert writes to their chunk.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef SUGGESTION_INDEX_H
+#define SUGGESTION_INDEX_H
+
+#include "ChunkedArray.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+class SuggestionIndex {
+
+private:
+
+   struct Node {
+      string key;                 // compared key of the element
+      string english;             // English word shown, empty when equal to "key"
+      vector< std::pair<unsigned int, unsigned int> > children;   // (distance, node index)
+   };
+
+   ChunkedArray<Node> nodes;      // nodes[0] is the root
+
+   // Description: Returns the edit distance between "a" and "b", or any value
+   //              above "limit" as soon as the distance is known to exceed it.
+   // Time efficiency: O(|a| * |b|)
+   static unsigned int distance(const string & a, const string & b, unsigned int limit);
+
+public:
+
+   // Description: Returns the number of keys in the index.
+   unsigned int getElementCount() const;
+
+   // Description: Adds "key" (displayed as "english") to the index.
+   //              Adding a key already in the index does nothing.
+   //              Only the chunks of the new node and of its parent are copied
+   //              if the index shares them with a copy.
+   // Time efficiency: O(depth * |key|^2 + CHUNK_SIZE)
+   void insert(const string & key, const string & english);
+
+   // Description: Returns the English words of at most "k" keys within edit
+   //              distance "maxDistance" of "key", closest first (ties in key order).
+   // Time efficiency: Visits only the subtrees the triangle inequality cannot prune.
+   vector<string> suggest(const string & key, unsigned int k, unsigned int maxDistance) const;
+
+}; // end SuggestionIndex
+#endif
@@ -0,0 +1,150 @@
+/*
+ * SuggestionIndexTestDriver.cpp
+ *
+ * Description: Drives the testing of the SuggestionIndex class. Suggestions
+ *              from the BK-tree are checked against those of a brute-force
+ *              search, which computes the edit distance to every key, for
+ *              random words over a small alphabet, so that most have many
+ *              near neighbours; then through Dictionary, across a snapshot.
+ *              Prints one line per check and returns the number of failures.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "SuggestionIndex.h"
+#include "Dictionary.h"
+#include "KeyNormalizer.h"
+#include "TestReport.h"
+#include "WordPair.h"
+
+using std::cout;
+using std::endl;
+
+static TestReport report;
+
+// Description: Returns a random word of 1 to 8 letters from "a" to "e".
+string randomWord(std::mt19937 & generator) {
+
+  string word(1 + generator() % 8, 'a');
+  for (char & letter : word) {
+     letter = 'a' + generator() % 5;
+  }
+  return word;
+}
+
+// Description: Returns the edit distance between "a" and "b", computed in full.
+unsigned int levenshtein(const string & a, const string & b) {
+
+  vector<unsigned int> previous(b.size() + 1), current(b.size() + 1);
+  for (unsigned int j = 0; j <= b.size(); j++) {
+     previous[j] = j;
+  }
+  for (unsigned int i = 1; i <= a.size(); i++) {
+     current[0] = i;
+     for (unsigned int j = 1; j <= b.size(); j++) {
+        unsigned int substitution = previous[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1);
+        current[j] = std::min(substitution, std::min(previous[j], current[j - 1]) + 1);
+     }
+     previous.swap(current);
+  }
+  return previous[b.size()];
+}
+
+// Description: Returns every word of "keys" with its edit distance to "key",
+//              closest first and ties in key order, by trying them all.
+vector< std::pair<unsigned int, string> > byDistance(const vector<string> & keys, const string & key) {
+
+  vector< std::pair<unsigned int, string> > near;
+  for (const string & candidate : keys) {
+     near.push_back(std::make_pair(levenshtein(key, candidate), candidate));
+  }
+  std::sort(near.begin(), near.end());
+  return near;
+}
+
+// Description: Returns the at most "k" first words of "near" within "maxDistance".
+vector<string> closest(const vector< std::pair<unsigned int, string> > & near, unsigned int k,
+                       unsigned int maxDistance) {
+
+  vector<string> words;
+  for (unsigned int i = 0; i < near.size() && i < k && near[i].first <= maxDistance; i++) {
+     words.push_back(near[i].second);
+  }
+  return words;
+}
+
+// Description: Checks the suggestions of random queries, for several "k" and
+//              distances, against the brute-force search over the same keys.
+void testAgainstBruteForce() {
+
+  std::mt19937 generator(2023);
+  SuggestionIndex index;
+  vector<string> keys;
+  for (unsigned int i = 0; i < 2000; i++) {
+     string key = randomWord(generator);
+     index.insert(key, key);
+     if (std::find(keys.begin(), keys.end(), key) == keys.end()) {
+        keys.push_back(key);
+     }
+  }
+  bool passed = (index.getElementCount() == keys.size());
+  const unsigned int ks[] = { 1, 3, 10, 100000 };
+  for (unsigned int query = 0; passed && query < 100; query++) {
+     string key = randomWord(generator);
+     vector< std::pair<unsigned int, string> > near = byDistance(keys, key);
+     for (unsigned int k : ks) {
+        for (unsigned int maxDistance = 0; passed && maxDistance <= 3; maxDistance++) {
+           vector<string> expected = closest(near, k, maxDistance);
+           vector<string> found = index.suggest(key, k, maxDistance);
+           if (found != expected) {
+              cout << "   \"" << key << "\" with k " << k << " within " << maxDistance << " gave "
+                   << found.size() << " word(s), not " << expected.size() << endl;
+              passed = false;
+           }
+        }
+     }
+  }
+  passed = passed && index.suggest("abc", 0, 3).empty() && SuggestionIndex().suggest("abc", 5, 3).empty();
+  report.check("suggestions agree with a brute-force search", passed);
+}
+
+// Description: Checks that suggestions are found by normalized key and shown
+//              by English word, and that a snapshot does not suggest the words
+//              put into its original after it was taken.
+void testThroughDictionary() {
+
+  Dictionary myWords;
+  myWords.setNormalization(KeyNormalizer::ALL);
+  myWords.enableSuggestions();
+  WordPair cafe("Café", "kahvila");
+  WordPair cake("Cake", "kakku");
+  myWords.put(cafe);
+  myWords.put(cake);
+  Dictionary snapshot(myWords);
+  WordPair care("care", "hoito");
+  myWords.put(care);
+
+  vector<string> first = { "Café" };
+  vector<string> all = { "Café", "Cake", "care" };
+  vector<string> beforePut = { "Café", "Cake" };
+  bool passed = myWords.hasSuggestions() && myWords.suggest(WordPair("CAFE"), 1, 1) == first
+                && myWords.suggest(WordPair(" cafe "), 5, 1) == all
+                && snapshot.suggest(WordPair("cafe"), 5, 1) == beforePut;
+  passed = passed && Dictionary().suggest(WordPair("cafe")).empty();
+  report.check("suggestions through a Dictionary and its snapshot", passed);
+}
+
+int main() {
+
+  testAgainstBruteForce();
+  testThroughDictionary();
+
+  return report.summarize();
+}
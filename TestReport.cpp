@@ -0,0 +1,42 @@
+/*
+ * TestReport.cpp
+ * 
+ * Description: Tally of the checks run by a test driver. Each check prints
+ *              one PASSED or FAILED line; a driver returns the number of
+ *              failures from main(), so that "make check" stops at the first
+ *              driver with one.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "TestReport.h"
+#include <iostream>
+
+/* Report operations */
+
+   // Description: Records and prints the outcome of check "name".
+   void TestReport::check(const string & name, bool passed) {
+      std::cout << (passed ? "PASSED: " : "FAILED: ") << name << std::endl;
+      checkCount++;
+      if (!passed) {
+         failureCount++;
+      }
+   }
+
+   // Description: Prints the number of checks failed and returns it.
+   unsigned int TestReport::summarize() const {
+      std::cout << failureCount << " of " << checkCount << " check(s) failed." << std::endl;
+      return failureCount;
+   }
+
+
+/* Getters */
+
+   unsigned int TestReport::getCheckCount() const {
+      return checkCount;
+   }
+
+   unsigned int TestReport::getFailureCount() const {
+      return failureCount;
+   }
@@ -0,0 +1,40 @@
+/*
+ * TestReport.h
+ * 
+ * Description: Tally of the checks run by a test driver. Each check prints
+ *              one PASSED or FAILED line; a driver returns the number of
+ *              failures from main(), so that "make check" stops at the first
+ *              driver with one.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef TEST_REPORT_H
+#define TEST_REPORT_H
+
+#include <string>
+
+using std::string;
+
+class TestReport {
+
+private:
+
+   unsigned int checkCount = 0;
+   unsigned int failureCount = 0;
+
+public:
+
+   // Description: Records and prints the outcome of check "name".
+   void check(const string & name, bool passed);
+
+   // Description: Prints the number of checks failed and returns it.
+   unsigned int summarize() const;
+
+   // Getters
+   unsigned int getCheckCount() const;
+   unsigned int getFailureCount() const;
+
+}; // end TestReport
+#endif
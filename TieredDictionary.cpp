@@ -0,0 +1,338 @@
+/*
+ * TieredDictionary.cpp
+ *
+ * Description: Dictonary data collection ADT class for a steady trickle of
+ *              puts into a large, read-mostly Dictionary (log-structured merge).
+ *              Elements live in two tiers: a compact read-only base
+ *              (FrontCodedDictionary) and a small mutable delta (Dictionary)
+ *              that takes the puts. A get checks the delta first, then the base;
+ *              the delta's Bloom filter sends most gets straight to the base.
+ *              When the delta reaches "mergeThreshold" elements, or 1/8 of the
+ *              base if that is more, it is frozen and a new, empty delta takes
+ *              the puts, while a background thread folds the frozen delta into
+ *              a new base and swaps it in. As the trigger grows with the base,
+ *              each merge adds a fixed fraction to it: n puts cost O(n) merge
+ *              work in all, not O(n^2 / mergeThreshold).
+ *              Readers are only blocked for that swap, never for the merge.
+ *              Puts never wait for a merge either: the delta grows past the
+ *              threshold meanwhile, and the next merge folds all of it.
+ *              Duplicated elements not allowed.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "TieredDictionary.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+using std::cerr;
+using std::endl;
+
+// False-positive rate of the Bloom filter of each delta.
+static const double DELTA_FALSE_POSITIVE_RATE = 0.01;
+
+// The delta is merged once it holds at least 1/BASE_PER_DELTA of the base.
+static const unsigned int BASE_PER_DELTA = 8;
+
+/* Constructor and destructor */
+
+   TieredDictionary::TieredDictionary(unsigned int normalization, unsigned int mergeThreshold)
+      : normalization(normalization), mergeThreshold(mergeThreshold > 0 ? mergeThreshold : 1),
+        base(std::make_shared<const FrontCodedDictionary>(normalization)) {
+
+      delta = makeDelta();
+      merger = std::thread(&TieredDictionary::mergeFrozenDeltas, this);
+   }
+
+   // Destructor
+   TieredDictionary::~TieredDictionary() {
+      {
+         std::lock_guard<std::mutex> lock(mergerMutex);
+         stopRequested = true;
+      }
+      mergerWakeUp.notify_one();
+      if (merger.joinable()) {
+         merger.join();
+      }
+   }
+
+
+/* Getters */
+
+   unsigned int TieredDictionary::getElementCount() const {
+      std::shared_lock<std::shared_mutex> read(tierLock);
+      return base->getElementCount() + (frozenDelta ? frozenDelta->getElementCount() : 0)
+           + delta->getElementCount();
+   }
+
+   unsigned int TieredDictionary::getBaseElementCount() const {
+      std::shared_lock<std::shared_mutex> read(tierLock);
+      return base->getElementCount();
+   }
+
+   unsigned int TieredDictionary::getDeltaElementCount() const {
+      std::shared_lock<std::shared_mutex> read(tierLock);
+      return (frozenDelta ? frozenDelta->getElementCount() : 0) + delta->getElementCount();
+   }
+
+   unsigned int TieredDictionary::getMergeCount() const {
+      return mergeCount.load();
+   }
+
+   size_t TieredDictionary::getBaseMemoryUsage() const {
+      std::shared_lock<std::shared_mutex> read(tierLock);
+      return base->getMemoryUsage();
+   }
+
+
+/* Dictionary operations */
+
+   // Description: Puts "newElement" (association of key-value) into the delta.
+   // Exception: Throws the exception "UnableToInsertException"
+   //            when newElement cannot be inserted in the Dictionary.
+   // Exception: Throws the exception "ElementAlreadyExistsException"
+   //            if "newElement" already exists in the Dictionary.
+   // Time efficiency: O(log2 m + log2 n + BLOCK_SIZE) for a delta of m elements
+   void TieredDictionary::put(WordPair & newElement) {
+
+      //the base and the frozen delta are read-only: searching them only needs
+      //the shared lock, so gets carry on meanwhile
+      std::shared_ptr<const FrontCodedDictionary> checkedBase;
+      std::shared_ptr<const Dictionary> checkedFrozen;
+      WordPair found;
+      {
+         std::shared_lock<std::shared_mutex> read(tierLock);
+         if (base->contains(newElement) || (frozenDelta && findIn(*frozenDelta, newElement, found)))
+            throw ElementAlreadyExistsException("Element already exists.");
+         checkedBase = base;
+         checkedFrozen = frozenDelta;
+      }
+
+      bool frozen = false;
+      {
+         std::unique_lock<std::shared_mutex> write(tierLock);
+         //a tier swapped in meanwhile holds elements put since the check: a merge
+         //moved the frozen delta into the base, or a put froze the delta
+         if ((base != checkedBase && base->contains(newElement))
+             || (frozenDelta && frozenDelta != checkedFrozen && findIn(*frozenDelta, newElement, found)))
+            throw ElementAlreadyExistsException("Element already exists.");
+         //the delta's own put rejects a key put into it meanwhile
+         delta->put(newElement);
+         if (!frozenDelta && delta->getElementCount() >= mergeTrigger()) {
+            freezeDelta();
+            frozen = true;
+         }
+      }
+      if (frozen) {
+         {
+            std::lock_guard<std::mutex> lock(mergerMutex);
+            mergeRequested = true;
+         }
+         mergerWakeUp.notify_one();
+      }
+   }
+
+   // Description: Gets the element whose key matches "targetElement".
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Exception: Throws the exception ElementDoesNotExistException
+   //            if the key is not found in the Dictionary.
+   // Time efficiency: O(log2 m + log2 n + BLOCK_SIZE) for a delta of m elements
+   WordPair TieredDictionary::get(const WordPair & targetElement) const {
+
+      WordPair query = targetElement;
+      WordPair found;
+      std::shared_lock<std::shared_mutex> read(tierLock);
+      //the newest tier first, although no key is in two tiers
+      if (findIn(*delta, query, found) || (frozenDelta && findIn(*frozenDelta, query, found))) {
+         return found;
+      }
+      if (base->getElementCount() != 0) {
+         return base->get(query);
+      }
+      //a frozen delta is never empty
+      if (delta->getElementCount() == 0 && !frozenDelta)
+         throw EmptyDataCollectionException("Dictionary is empty.");
+      throw ElementDoesNotExistException("***Not Found!***");
+   }
+
+   // Description: Returns true if the key of "targetElement" is in the Dictionary.
+   bool TieredDictionary::contains(const WordPair & targetElement) const {
+
+      WordPair query = targetElement;
+      WordPair found;
+      std::shared_lock<std::shared_mutex> read(tierLock);
+      return findIn(*delta, query, found) || (frozenDelta && findIn(*frozenDelta, query, found))
+          || base->contains(query);
+   }
+
+   // Description: Merges every element put so far into the base, waiting for
+   //              the merge under way, if any.
+   // Exception: Throws the exception bad_alloc if memory ran out.
+   void TieredDictionary::flush() {
+
+      std::lock_guard<std::mutex> merging(mergeMutex);
+      //a delta frozen by put() may still be waiting for the merger thread
+      mergeFrozenDelta();
+      {
+         std::unique_lock<std::shared_mutex> write(tierLock);
+         if (delta->getElementCount() == 0) {
+            return;
+         }
+         freezeDelta();
+      }
+      mergeFrozenDelta();
+   }
+
+   // Description: Visits the content of the Dictionary in key order, merging the tiers.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   void TieredDictionary::displayContent(void visit(WordPair &)) const {
+      displayContent(std::function<void(WordPair &)>(visit));
+   }
+
+   // Description: Visits the content of the Dictionary in key order, merging the tiers.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Time efficiency: O(n + m) for a delta of m elements
+   void TieredDictionary::displayContent(const std::function<void(WordPair &)> & visit) const {
+
+      std::shared_lock<std::shared_mutex> read(tierLock);
+
+      //the deltas are small: they are taken out and merged first, then slotted
+      //in while the base streams by
+      std::vector<WordPair> added;
+      auto collect = [&added](WordPair & element) {
+         added.push_back(element);
+      };
+      if (delta->getElementCount() != 0) {
+         delta->displayContent(collect);
+      }
+      size_t middle = added.size();
+      if (frozenDelta && frozenDelta->getElementCount() != 0) {
+         frozenDelta->displayContent(collect);
+      }
+      std::inplace_merge(added.begin(), added.begin() + middle, added.end(),
+                         [](const WordPair & left, const WordPair & right) {
+                            return left.getKey() < right.getKey();
+                         });
+      if (added.empty() && base->getElementCount() == 0)
+         throw EmptyDataCollectionException("Dictionary is empty.");
+
+      size_t next = 0;
+      if (base->getElementCount() != 0) {
+         base->displayContent([&](WordPair & element) {
+            while (next < added.size() && added[next].getKey() < element.getKey()) {
+               visit(added[next++]);
+            }
+            visit(element);
+         });
+      }
+      while (next < added.size()) {
+         visit(added[next++]);
+      }
+   }
+
+
+/* Utility methods */
+
+   // Description: Body of the merger thread.
+   void TieredDictionary::mergeFrozenDeltas() {
+
+      std::unique_lock<std::mutex> lock(mergerMutex);
+      while (!stopRequested) {
+         mergerWakeUp.wait(lock, [this]() { return stopRequested || mergeRequested; });
+         if (stopRequested) {
+            break;
+         }
+         mergeRequested = false;
+
+         //merge outside the lock so put() and the destructor never wait on a merge
+         lock.unlock();
+         try {
+            std::lock_guard<std::mutex> merging(mergeMutex);
+            bool pending = true;
+            while (pending) {
+               mergeFrozenDelta();
+               //puts carried on during the merge: the delta may be full again
+               std::unique_lock<std::shared_mutex> write(tierLock);
+               pending = !frozenDelta && delta->getElementCount() >= mergeTrigger();
+               if (pending) {
+                  freezeDelta();
+               }
+            }
+         }
+         catch (std::exception & anException) {
+            cerr << "Unable to merge the delta: " << anException.what() << endl;
+         }
+         lock.lock();
+      }
+   }
+
+   // Description: Returns the number of elements at which the delta is frozen.
+   //              A merge costs O(n + m): with m at least n / BASE_PER_DELTA, that is
+   //              O(m), so each put pays O(1) of merging, amortized.
+   unsigned int TieredDictionary::mergeTrigger() const {
+      return std::max(mergeThreshold, base->getElementCount() / BASE_PER_DELTA);
+   }
+
+   // Description: Returns a new, empty delta.
+   std::shared_ptr<Dictionary> TieredDictionary::makeDelta() const {
+
+      std::shared_ptr<Dictionary> fresh = std::make_shared<Dictionary>();
+      fresh->setNormalization(normalization);
+      fresh->enableBloomFilter(DELTA_FALSE_POSITIVE_RATE);
+      return fresh;
+   }
+
+   // Description: Makes the delta the frozen delta and starts a new, empty delta.
+   // Precondition: The caller holds "tierLock" exclusively and there is no frozen delta.
+   void TieredDictionary::freezeDelta() {
+
+      //the new delta is made first, so that running out of memory changes nothing
+      std::shared_ptr<Dictionary> fresh = makeDelta();
+      frozenDelta = delta;
+      delta = fresh;
+   }
+
+   // Description: Builds a new base from the base and the frozen delta, then swaps it in.
+   // Precondition: The caller holds "mergeMutex".
+   // Exception: Throws the exception bad_alloc if memory ran out, leaving the tiers unchanged.
+   // Time efficiency: O(n + m) for a frozen delta of m elements
+   void TieredDictionary::mergeFrozenDelta() {
+
+      std::shared_ptr<const FrontCodedDictionary> oldBase;
+      std::shared_ptr<const Dictionary> frozen;
+      {
+         std::shared_lock<std::shared_mutex> read(tierLock);
+         oldBase = base;
+         frozen = frozenDelta;
+      }
+      if (!frozen) {
+         return;
+      }
+      //both tiers are read-only, and only this merge replaces them ("mergeMutex")
+      std::shared_ptr<const FrontCodedDictionary> merged =
+         std::make_shared<const FrontCodedDictionary>(*oldBase, *frozen);
+      {
+         std::unique_lock<std::shared_mutex> write(tierLock);
+         base = merged;
+         frozenDelta.reset();
+      }
+      mergeCount++;
+   }
+
+   // Description: Returns true, with the element in "found", if the key of
+   //              "targetElement" is in "tier".
+   bool TieredDictionary::findIn(const Dictionary & tier, WordPair & targetElement, WordPair & found) {
+
+      if (!tier.mayContain(targetElement)) {
+         return false;
+      }
+      try {
+         found = tier.get(targetElement);
+         return true;
+      }
+      catch (ElementDoesNotExistException & anException) {
+         return false;
+      }
+   }
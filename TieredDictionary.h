@@ -0,0 +1,164 @@
+/*
+ * TieredDictionary.h
+ *
+ * Description: Dictonary data collection ADT class for a steady trickle of
+ *              puts into a large, read-mostly Dictionary (log-structured merge).
+ *              Elements live in two tiers: a compact read-only base
+ *              (FrontCodedDictionary) and a small mutable delta (Dictionary)
+ *              that takes the puts. A get checks the delta first, then the base;
+ *              the delta's Bloom filter sends most gets straight to the base.
+ *              When the delta reaches "mergeThreshold" elements, or 1/8 of the
+ *              base if that is more, it is frozen and a new, empty delta takes
+ *              the puts, while a background thread folds the frozen delta into
+ *              a new base and swaps it in. As the trigger grows with the base,
+ *              each merge adds a fixed fraction to it: n puts cost O(n) merge
+ *              work in all, not O(n^2 / mergeThreshold).
+ *              Readers are only blocked for that swap, never for the merge.
+ *              Puts never wait for a merge either: the delta grows past the
+ *              threshold meanwhile, and the next merge folds all of it.
+ *              Duplicated elements not allowed.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef TIERED_DICTIONARY_H
+#define TIERED_DICTIONARY_H
+
+#include "Dictionary.h"
+#include "FrontCodedDictionary.h"
+#include "KeyNormalizer.h"
+#include "WordPair.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+class TieredDictionary {
+
+private:
+
+   unsigned int normalization;
+   unsigned int mergeThreshold;
+
+   // The tiers - only accessed with "tierLock" held: shared for get, exclusive for put and swaps.
+   // No key is in more than one tier.
+   std::shared_ptr<const FrontCodedDictionary> base;
+   std::shared_ptr<const Dictionary> frozenDelta;   // being merged into the next base, or nullptr
+   std::shared_ptr<Dictionary> delta;               // takes the puts
+   mutable std::shared_mutex tierLock;
+
+   // Held for the whole of a merge, so that only one runs at a time.
+   std::mutex mergeMutex;
+
+   std::atomic<unsigned int> mergeCount{0};
+   std::thread merger;
+   std::mutex mergerMutex;
+   std::condition_variable mergerWakeUp;
+   bool stopRequested = false;
+   bool mergeRequested = false;
+
+   // Description: Body of the merger thread. Merges each delta frozen by put(),
+   //              and freezes the delta again if it filled up meanwhile.
+   //              A merge that runs out of memory leaves its frozen delta to flush().
+   void mergeFrozenDeltas();
+
+   // Description: Returns the number of elements at which the delta is frozen.
+   // Precondition: The caller holds "tierLock".
+   unsigned int mergeTrigger() const;
+
+   // Description: Returns a new, empty delta.
+   std::shared_ptr<Dictionary> makeDelta() const;
+
+   // Description: Makes the delta the frozen delta and starts a new, empty delta.
+   // Precondition: The caller holds "tierLock" exclusively and there is no frozen delta.
+   void freezeDelta();
+
+   // Description: Builds a new base from the base and the frozen delta, then swaps
+   //              it in and drops the frozen delta. The tiers are only locked to
+   //              read them and to swap: gets and puts carry on during the merge.
+   // Precondition: The caller holds "mergeMutex".
+   // Exception: Throws the exception bad_alloc if memory ran out, leaving the tiers unchanged.
+   // Time efficiency: O(n + m) for a frozen delta of m elements
+   void mergeFrozenDelta();
+
+   // Description: Returns true, with the element in "found", if the key of
+   //              "targetElement" is in "tier".
+   //              Throws nothing on a miss, which most gets are for a delta.
+   static bool findIn(const Dictionary & tier, WordPair & targetElement, WordPair & found);
+
+   // Not copyable: the merger thread works on this very object.
+   TieredDictionary(const TieredDictionary &) = delete;
+   TieredDictionary & operator=(const TieredDictionary &) = delete;
+
+public:
+
+   // Constructor and destructor
+   // Keys are compared after the "normalization" policy (KeyNormalizer flags).
+   // The delta is merged into the base once it holds "mergeThreshold" elements,
+   // or 1/8 of the base if that is more.
+   // Precondition: mergeThreshold > 0.
+   TieredDictionary(unsigned int normalization = KeyNormalizer::NONE, unsigned int mergeThreshold = 4096);
+   ~TieredDictionary();                      // Stops the merger thread once its merge, if any, is done
+
+   // Description: Returns the number of elements currently stored in the Dictionary.
+   unsigned int getElementCount() const;
+
+   // Description: Returns the number of elements in the base.
+   unsigned int getBaseElementCount() const;
+
+   // Description: Returns the number of elements not yet merged into the base.
+   unsigned int getDeltaElementCount() const;
+
+   // Description: Returns the number of bases swapped in by merges.
+   unsigned int getMergeCount() const;
+
+   // Description: Returns the number of bytes used by the base.
+   size_t getBaseMemoryUsage() const;
+
+   // Description: Puts "newElement" (association of key-value) into the delta.
+   //              The base and the frozen delta are searched for the key under the
+   //              shared lock; the exclusive lock is only taken for the delta put,
+   //              searching again only the tiers a merge or a freeze swapped in
+   //              since. When the delta is full and no merge is under way, it is
+   //              frozen and handed to the merger thread.
+   // Precondition: "newElement" does not already exist in the Dictionary.
+   // Exception: Throws the exception "UnableToInsertException"
+   //            when newElement cannot be inserted in the Dictionary.
+   // Exception: Throws the exception "ElementAlreadyExistsException"
+   //            if "newElement" already exists in the Dictionary.
+   // Time efficiency: O(log2 m + log2 n + BLOCK_SIZE) for a delta of m elements
+   void put(WordPair & newElement);
+
+   // Description: Gets the element whose key matches "targetElement",
+   //              looking in the delta, then the frozen delta, then the base.
+   //              The element is returned by value: the tier holding it may be
+   //              merged away as soon as the lookup is done.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Exception: Throws the exception ElementDoesNotExistException
+   //            if the key is not found in the Dictionary.
+   // Time efficiency: O(log2 m + log2 n + BLOCK_SIZE) for a delta of m elements
+   WordPair get(const WordPair & targetElement) const;
+
+   // Description: Returns true if the key of "targetElement" is in the Dictionary.
+   bool contains(const WordPair & targetElement) const;
+
+   // Description: Merges every element put so far into the base, waiting for
+   //              the merge under way, if any.
+   // Exception: Throws the exception bad_alloc if memory ran out.
+   void flush();
+
+   // Description: Visits the content of the Dictionary in key order, merging the tiers.
+   //              The tiers are locked for reading during the traversal,
+   //              so "visit" must not put into this Dictionary.
+   // Precondition: Dictionary is not empty.
+   // Exception: Throws the exception EmptyDataCollectionException if the Dictionary is empty.
+   // Time efficiency: O(n + m) for a delta of m elements
+   void displayContent(void visit(WordPair &)) const;
+   void displayContent(const std::function<void(WordPair &)> & visit) const;
+
+}; // end TieredDictionary
+#endif
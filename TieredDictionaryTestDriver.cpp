@@ -0,0 +1,217 @@
+/*
+ * TieredDictionaryTestDriver.cpp
+ *
+ * Description: Drives the testing of the TieredDictionary ADT class. Random
+ *              puts and gets are checked against a std::map holding what the
+ *              Dictionary should, with a merge threshold small enough that
+ *              the merger thread folds deltas into the base all along, and
+ *              readers check their gets while a writer's puts set off merges.
+ *              Prints one line per check and returns the number of failures.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TieredDictionary.h"
+#include "KeyNormalizer.h"
+#include "TestReport.h"
+#include "WordPair.h"
+#include "ElementAlreadyExistsException.h"
+#include "ElementDoesNotExistException.h"
+#include "EmptyDataCollectionException.h"
+
+using std::vector;
+
+// Small, so that the tests go through many merges.
+static const unsigned int MERGE_THRESHOLD = 64;
+
+static TestReport report;
+
+// Description: Returns true if "myWords" holds exactly the content of "model", in key order.
+bool holdsExactly(const TieredDictionary & myWords, const std::map<string, string> & model) {
+
+  if (myWords.getElementCount() != model.size()) {
+     return false;
+  }
+  bool passed = true;
+  auto next = model.begin();
+  myWords.displayContent([&passed, &next, &model](WordPair & anElement) {
+     if (next == model.end() || anElement.getEnglish() != next->first
+         || anElement.getTranslation() != next->second) {
+        passed = false;
+     }
+     else {
+        next++;
+     }
+  });
+  return passed && next == model.end();
+}
+
+// Description: Checks that a get on an empty Dictionary throws EmptyDataCollectionException.
+void testEmpty() {
+
+  TieredDictionary myWords;
+  bool passed = false;
+  try {
+     myWords.get(WordPair("food"));
+  }
+  catch (EmptyDataCollectionException& anException) {
+     passed = true;
+  }
+  report.check("get on an empty Dictionary", passed && !myWords.contains(WordPair("food")));
+}
+
+// Description: Runs random puts, some of keys already put, and random gets,
+//              some of keys never put, checking each outcome against "model".
+void testAgainstModel() {
+
+  TieredDictionary myWords(KeyNormalizer::NONE, MERGE_THRESHOLD);
+  std::map<string, string> model;
+  std::mt19937 generator(2023);
+  std::uniform_int_distribution<unsigned int> keys(0, 11999);
+  bool passed = true;
+
+  for (unsigned int step = 0; passed && step < 30000; step++) {
+     string english = "word" + std::to_string(keys(generator));
+     if (generator() % 5 < 3) {
+        WordPair aWord(english, "translation" + std::to_string(step));
+        bool expected = (model.find(english) == model.end());
+        try {
+           myWords.put(aWord);
+           passed = expected;
+           model[english] = aWord.getTranslation();
+        }
+        catch (ElementAlreadyExistsException& anException) {
+           passed = !expected;
+        }
+     }
+     else if (!model.empty()) {
+        auto found = model.find(english);
+        try {
+           WordPair translated = myWords.get(WordPair(english));
+           passed = (found != model.end() && translated.getTranslation() == found->second);
+        }
+        catch (ElementDoesNotExistException& anException) {
+           passed = (found == model.end());
+        }
+     }
+  }
+  passed = passed && myWords.getMergeCount() > 0 && holdsExactly(myWords, model);
+
+  //once flushed, every element is in the base
+  myWords.flush();
+  passed = passed && myWords.getBaseElementCount() == model.size()
+           && myWords.getDeltaElementCount() == 0 && holdsExactly(myWords, model);
+  report.check("random puts and gets agree with a model across merges", passed);
+}
+
+// Description: One thread puts while others get the elements already put,
+//              and some never put, so that gets run during every swap of tiers.
+void testReadersDuringMerges() {
+
+  const unsigned int wordCount = 20000;
+  const unsigned int readers = 2;
+  TieredDictionary myWords(KeyNormalizer::NONE, MERGE_THRESHOLD);
+  std::atomic<unsigned int> published{0};
+  std::atomic<unsigned int> wrong{0};
+
+  //words are put in a shuffled order, so that each merge slots them throughout the base
+  vector<unsigned int> order(wordCount);
+  for (unsigned int i = 0; i < wordCount; i++) {
+     order[i] = i;
+  }
+  std::shuffle(order.begin(), order.end(), std::mt19937(2023));
+
+  std::thread writer([&]() {
+     for (unsigned int i = 0; i < wordCount; i++) {
+        WordPair aWord("word" + std::to_string(order[i]), "translation" + std::to_string(order[i]));
+        try {
+           myWords.put(aWord);
+        }
+        catch (std::logic_error& anException) {
+           wrong++;
+        }
+        published.store(i + 1, std::memory_order_release);
+     }
+  });
+  vector<std::thread> readerThreads;
+  for (unsigned int r = 0; r < readers; r++) {
+     readerThreads.emplace_back([&, r]() {
+        std::mt19937 generator(r);
+        unsigned int done;
+        while ((done = published.load(std::memory_order_acquire)) < wordCount) {
+           if (done == 0) {
+              std::this_thread::yield();
+              continue;
+           }
+           unsigned int word = order[generator() % done];
+           try {
+              WordPair translated = myWords.get(WordPair("word" + std::to_string(word)));
+              if (translated.getTranslation() != "translation" + std::to_string(word)) {
+                 wrong++;
+              }
+           }
+           catch (std::logic_error& anException) {
+              wrong++;
+           }
+           if (myWords.contains(WordPair("absent" + std::to_string(word)))) {
+              wrong++;
+           }
+        }
+     });
+  }
+  writer.join();
+  for (std::thread & reader : readerThreads) {
+     reader.join();
+  }
+
+  std::map<string, string> model;
+  for (unsigned int i = 0; i < wordCount; i++) {
+     model["word" + std::to_string(i)] = "translation" + std::to_string(i);
+  }
+  bool passed = (wrong == 0) && myWords.getMergeCount() > 0 && holdsExactly(myWords, model);
+  report.check("gets during merges find every element put before them", passed);
+}
+
+// Description: Checks that keys follow the normalization policy in every tier,
+//              and that a duplicate is refused once its key is in the base.
+void testNormalization() {
+
+  TieredDictionary myWords(KeyNormalizer::ALL, MERGE_THRESHOLD);
+  WordPair cafe("Café", "kahvila");
+  myWords.put(cafe);
+  bool passed = myWords.contains(WordPair("  CAFE ")) && myWords.contains(WordPair("cafe"));
+  myWords.flush();
+  try {
+     WordPair translated = myWords.get(WordPair("cafe"));
+     passed = passed && translated.getEnglish() == "Café" && translated.getTranslation() == "kahvila";
+  }
+  catch (ElementDoesNotExistException& anException) {
+     passed = false;
+  }
+  try {
+     WordPair duplicate("CAFE", "kafe");
+     myWords.put(duplicate);
+     passed = false;
+  }
+  catch (ElementAlreadyExistsException& anException) { }
+  report.check("normalized keys in the delta and in the base", passed && myWords.getElementCount() == 1);
+}
+
+int main() {
+
+  testEmpty();
+  testAgainstModel();
+  testReadersDuringMerges();
+  testNormalization();
+
+  return report.summarize();
+}
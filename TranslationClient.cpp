@@ -0,0 +1,134 @@
+/*
+ * TranslationClient.cpp
+ * 
+ * Description: Client for the translation server. Sends each line of
+ *              standard input (or each word given on the command line)
+ *              to the server without waiting for the answers, and prints
+ *              the answers as they arrive, in order.
+ *
+ *              Usage: translate-client [-s socketPath] [word ...]
+ *
+ * Author: Aidan de Vaal
+ * Last Modification Date: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <string>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using std::cerr;
+using std::endl;
+using std::string;
+
+// Largest number of query bytes read from standard input but not yet sent.
+static const size_t MAX_PENDING = 64 * 1024;
+
+// Description: Writes all of "length" bytes of "data" to "fd".
+// Postcondition: Returns false if the write failed.
+static bool writeAll(int fd, const char * data, size_t length) {
+  while (length > 0) {
+     ssize_t count = write(fd, data, length);
+     if (count == -1) {
+        if (errno == EINTR) {
+           continue;
+        }
+        return false;
+     }
+     data += count;
+     length -= count;
+  }
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+
+  string socketPath = "/tmp/translate.sock";
+  string pending = "";
+  for (int i = 1; i < argc; i++) {
+     if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+        socketPath = argv[++i];
+     }
+     else {
+        pending += argv[i];
+        pending += '\n';
+     }
+  }
+
+  struct sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd == -1 || connect(fd, (struct sockaddr *) &address, sizeof(address)) == -1) {
+     cerr << "Unable to connect to " << socketPath << ": " << strerror(errno) << endl;
+     return 1;
+  }
+  // The socket never blocks: the server stops reading queries while too many
+  // of its answers wait, so queries are only written when the socket takes
+  // them, and answers are read whenever they arrive.
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+  // Words given on the command line are sent as they are, otherwise standard input is streamed.
+  bool inputOpen = pending.empty();
+  bool writeClosed = false;
+  char buffer[64 * 1024];
+  while (true) {
+     if (!inputOpen && pending.empty() && !writeClosed) {
+        // no more queries, the server closes once every answer is sent
+        shutdown(fd, SHUT_WR);
+        writeClosed = true;
+     }
+     struct pollfd fds[2];
+     fds[0].fd = fd;
+     fds[0].events = POLLIN | (pending.empty() ? 0 : POLLOUT);
+     fds[1].fd = STDIN_FILENO;
+     fds[1].events = POLLIN;
+     bool readInput = inputOpen && pending.size() < MAX_PENDING;
+     if (poll(fds, readInput ? 2 : 1, -1) == -1) {
+        if (errno == EINTR) {
+           continue;
+        }
+        break;
+     }
+     if (fds[0].revents & (POLLIN | POLLHUP | POLLERR)) {
+        ssize_t count = read(fd, buffer, sizeof(buffer));
+        if (count == 0) {
+           break;
+        }
+        if (count > 0) {
+           writeAll(STDOUT_FILENO, buffer, count);
+        }
+        else if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+           cerr << "read() failed: " << strerror(errno) << endl;
+           break;
+        }
+     }
+     if (!pending.empty() && (fds[0].revents & POLLOUT)) {
+        ssize_t count = send(fd, pending.data(), pending.size(), MSG_NOSIGNAL);
+        if (count > 0) {
+           pending.erase(0, count);
+        }
+        else if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+           cerr << "send() failed: " << strerror(errno) << endl;
+           break;
+        }
+     }
+     if (readInput && (fds[1].revents & (POLLIN | POLLHUP | POLLERR))) {
+        ssize_t count = read(STDIN_FILENO, buffer, sizeof(buffer));
+        if (count > 0) {
+           pending.append(buffer, count);
+        }
+        else if (count == 0 || errno != EINTR) {
+           inputOpen = false;
+        }
+     }
+  }
+  close(fd);
+  return 0;
+}
@@ -0,0 +1,53 @@
+/*
+ * TranslationDaemon.cpp
+ * 
+ * Description: Long-lived translation server. Loads the Dictionary once and
+ *              answers lookups from local clients over a Unix domain socket
+ *              until interrupted. The data file is reloaded when it changes.
+ *
+ *              Usage: translated [-n] [socketPath] [dataFile]
+ *              -n: lookups ignore case, extra whitespace and accents
+ *
+ * Author: Aidan de Vaal
+ * Last Modification Date: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include "DictionaryReloader.h"
+#include "TranslationServer.h"
+
+using std::cout;
+using std::string;
+
+int main(int argc, char *argv[]) {
+
+  unsigned int normalization = KeyNormalizer::NONE;
+  if ((argc > 1) && (strcmp(argv[1], "-n") == 0)) {
+     normalization = KeyNormalizer::ALL;
+     argc--;
+     argv++;
+  }
+  string socketPath = (argc > 1) ? argv[1] : "/tmp/translate.sock";
+  string filename = (argc > 2) ? argv[2] : "dataFile.txt";
+
+  DictionaryReloader::installSignalHandler();
+  TranslationServer::installSignalHandlers();
+
+  DictionaryReloader reloader(filename, normalization);
+  cout << "Reading..." << endl;
+  if (!reloader.start()) {
+     cout << "Unable to open file" << endl;
+     return 1;
+  }
+  cout << "Finished reading." << endl;
+
+  TranslationServer server(socketPath, reloader);
+  if (!server.start()) {
+     return 1;
+  }
+  cout << "Listening on " << socketPath << endl;
+  server.run();
+  return 0;
+}
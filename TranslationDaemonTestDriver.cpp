@@ -0,0 +1,168 @@
+/*
+ * TranslationDaemonTestDriver.cpp
+ *
+ * Description: Drives the testing of the translation daemon and its client.
+ *              Starts ./translated on a data file of its own and streams
+ *              queries through ./translate-client, checking every answer,
+ *              with more queries than the server buffers answers for, so
+ *              that the client must read answers while it still has
+ *              queries to send. Both programs must be built first.
+ *              Prints one line per check and returns the number of failures.
+ *
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <cstring>
+#include <unistd.h>
+#include "TestReport.h"
+
+using std::vector;
+
+// Files used by the tests, removed at the end.
+static const string SOCKET_PATH = "/tmp/translateTestDriver.sock";
+static const string DATA_FILE = "daemonTestDriver.txt";
+static const string QUERY_FILE = "daemonTestDriver.queries";
+static const string ANSWER_FILE = "daemonTestDriver.answers";
+
+// Past the 1 MB of answers the server buffers for a connection.
+static const unsigned int QUERY_COUNT = 400000;
+
+static TestReport report;
+
+// Description: Runs "arguments" with standard input read from "input" and standard
+//              output written to "output", and returns its exit status, or -1 if
+//              it ran for more than "seconds".
+int runProgram(const vector<string> & arguments, const string & input, const string & output,
+               unsigned int seconds) {
+
+  pid_t child = fork();
+  if (child == 0) {
+     int in = open(input.c_str(), O_RDONLY);
+     int out = open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+     dup2(in, STDIN_FILENO);
+     dup2(out, STDOUT_FILENO);
+     vector<char *> argv;
+     for (const string & argument : arguments) {
+        argv.push_back(const_cast<char *>(argument.c_str()));
+     }
+     argv.push_back(nullptr);
+     alarm(seconds);
+     execv(argv[0], argv.data());
+     _exit(127);
+  }
+  int status = 0;
+  waitpid(child, &status, 0);
+  if (WIFSIGNALED(status)) {
+     return -1;
+  }
+  return WEXITSTATUS(status);
+}
+
+// Description: Returns the lines of file "fileName".
+vector<string> readLines(const string & fileName) {
+
+  vector<string> lines;
+  std::ifstream file(fileName);
+  string line;
+  while (getline(file, line)) {
+     lines.push_back(line);
+  }
+  return lines;
+}
+
+// Description: Returns true once a connection to the daemon's socket succeeds,
+//              false if none does within a few seconds.
+bool waitForDaemon() {
+
+  struct sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strncpy(address.sun_path, SOCKET_PATH.c_str(), sizeof(address.sun_path) - 1);
+  for (int attempt = 0; attempt < 100; attempt++) {
+     int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+     bool connected = (connect(fd, (struct sockaddr *) &address, sizeof(address)) == 0);
+     close(fd);
+     if (connected) {
+        return true;
+     }
+     usleep(50000);
+  }
+  return false;
+}
+
+// Description: Streams QUERY_COUNT queries, alternating words in the data file
+//              and words not in it, and checks that each is answered, in order.
+void testStreamPastServerBuffer() {
+
+  std::ofstream queries(QUERY_FILE);
+  for (unsigned int i = 0; i < QUERY_COUNT; i++) {
+     queries << (i % 2 == 0 ? "food" : "foo") << "\n";
+  }
+  queries.close();
+
+  int status = runProgram({ "./translate-client", "-s", SOCKET_PATH }, QUERY_FILE, ANSWER_FILE, 30);
+  vector<string> answers = readLines(ANSWER_FILE);
+  bool passed = (status == 0) && answers.size() == QUERY_COUNT;
+  for (unsigned int i = 0; passed && i < answers.size(); i++) {
+     passed = (i % 2 == 0) ? (answers[i] == "food:nourriture")
+                           : (answers[i].find("Not Found") != string::npos);
+  }
+  report.check("over 1 MB of queries streamed through the daemon", passed);
+}
+
+// Description: Sends words given as arguments, whose answers again take more
+//              than the server buffers, and checks them.
+void testWordArguments() {
+
+  vector<string> arguments = { "./translate-client", "-s", SOCKET_PATH };
+  const unsigned int wordCount = 80000;
+  for (unsigned int i = 0; i < wordCount; i++) {
+     arguments.push_back(i % 2 == 0 ? "food" : "water");
+  }
+  int status = runProgram(arguments, "/dev/null", ANSWER_FILE, 30);
+  vector<string> answers = readLines(ANSWER_FILE);
+  bool passed = (status == 0) && answers.size() == wordCount;
+  for (unsigned int i = 0; passed && i < answers.size(); i++) {
+     passed = answers[i] == (i % 2 == 0 ? "food:nourriture" : "water:eau");
+  }
+  report.check("over 1 MB of answers to words given as arguments", passed);
+}
+
+int main() {
+
+  std::ofstream data(DATA_FILE);
+  data << "food:nourriture\nwater:eau\nbread:pain\n";
+  data.close();
+
+  pid_t daemon = fork();
+  if (daemon == 0) {
+     int out = open("/dev/null", O_WRONLY);
+     dup2(out, STDOUT_FILENO);
+     execl("./translated", "./translated", SOCKET_PATH.c_str(), DATA_FILE.c_str(), (char *) nullptr);
+     _exit(127);
+  }
+  bool started = waitForDaemon();
+  report.check("daemon started", started);
+  if (started) {
+     testStreamPastServerBuffer();
+     testWordArguments();
+  }
+  kill(daemon, SIGTERM);
+  waitpid(daemon, nullptr, 0);
+
+  std::remove(DATA_FILE.c_str());
+  std::remove(QUERY_FILE.c_str());
+  std::remove(ANSWER_FILE.c_str());
+  return report.summarize();
+}
@@ -0,0 +1,307 @@
+/*
+ * TranslationServer.cpp
+ * 
+ * Description: Serves Dictionary lookups to local clients over a Unix domain
+ *              socket. Clients send one English word per line and may pipeline
+ *              as many lines as they like; each line is answered, in order,
+ *              with the same line "translate" would print for it.
+ *              All connections are handled by one epoll event loop. Every
+ *              batch of lines read from a connection is answered from a single
+ *              Dictionary acquired from a DictionaryReloader, so the data file
+ *              can be reloaded while the server runs.
+ *              Each connection buffers at most MAX_BUFFERED bytes of answers:
+ *              past that, its input is no longer read until the client has
+ *              read its answers, and each wake-up reads a bounded amount from
+ *              it, so one client can neither exhaust memory nor starve others.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "TranslationServer.h"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using std::cerr;
+
+std::atomic<bool> TranslationServer::stopRequested{false};
+
+// Maximum number of epoll events handled per wake-up.
+static const int MAX_EVENTS = 64;
+
+// Size of the buffer each read() fills.
+static const size_t READ_CHUNK = 64 * 1024;
+
+// Number of read() calls per connection per wake-up: epoll is level-triggered,
+// so what is left is read on a later wake-up, after the other connections.
+static const int READS_PER_WAKE_UP = 4;
+
+// Bytes of answers a connection may have waiting before its input is paused,
+// and longest line accepted.
+static const size_t MAX_BUFFERED = 1024 * 1024;
+
+/* Constructors and destructor */
+
+   TranslationServer::TranslationServer(const string & socketPath, DictionaryReloader & reloader)
+      : socketPath(socketPath), reloader(reloader) { }
+
+   // Destructor
+   TranslationServer::~TranslationServer() {
+      while (!connections.empty()) {
+         closeConnection(connections.begin()->first);
+      }
+      if (epollFd != -1) {
+         close(epollFd);
+      }
+      if (listenFd != -1) {
+         close(listenFd);
+         unlink(socketPath.c_str());
+      }
+   }
+
+
+/* Server operations */
+
+   // Description: Creates, binds and listens on the Unix domain socket.
+   // Postcondition: Returns false, after printing the reason, if it failed.
+   bool TranslationServer::start() {
+
+      struct sockaddr_un address;
+      memset(&address, 0, sizeof(address));
+      address.sun_family = AF_UNIX;
+      if (socketPath.size() >= sizeof(address.sun_path)) {
+         cerr << "Socket path too long: " << socketPath << endl;
+         return false;
+      }
+      strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+      listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+      if (listenFd == -1) {
+         cerr << "socket() failed: " << strerror(errno) << endl;
+         return false;
+      }
+      unlink(socketPath.c_str());
+      if (bind(listenFd, (struct sockaddr *) &address, sizeof(address)) == -1
+          || listen(listenFd, SOMAXCONN) == -1) {
+         cerr << "Unable to listen on " << socketPath << ": " << strerror(errno) << endl;
+         return false;
+      }
+
+      epollFd = epoll_create1(EPOLL_CLOEXEC);
+      struct epoll_event event;
+      event.events = EPOLLIN;
+      event.data.fd = listenFd;
+      if (epollFd == -1 || epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event) == -1) {
+         cerr << "epoll setup failed: " << strerror(errno) << endl;
+         return false;
+      }
+      return true;
+   }
+
+   // Description: Runs the event loop until stop() is called or
+   //              SIGINT/SIGTERM is received.
+   void TranslationServer::run() {
+
+      struct epoll_event events[MAX_EVENTS];
+      while (!stopRequested.load()) {
+         //wake up regularly so that a stop request is noticed
+         int ready = epoll_wait(epollFd, events, MAX_EVENTS, 250);
+         if (ready == -1) {
+            if (errno == EINTR) {
+               continue;
+            }
+            cerr << "epoll_wait() failed: " << strerror(errno) << endl;
+            return;
+         }
+         for (int i = 0; i < ready; i++) {
+            int fd = events[i].data.fd;
+            if (fd == listenFd) {
+               acceptConnections();
+               continue;
+            }
+            auto found = connections.find(fd);
+            if (found != connections.end()) {
+               serviceConnection(fd, found->second, events[i].events);
+            }
+         }
+      }
+   }
+
+   // Description: Makes run() return.
+   void TranslationServer::stop() {
+      stopRequested.store(true);
+   }
+
+   // Description: Makes SIGINT and SIGTERM stop the server, and ignores SIGPIPE.
+   void TranslationServer::installSignalHandlers() {
+      std::signal(SIGINT, onTerminate);
+      std::signal(SIGTERM, onTerminate);
+      std::signal(SIGPIPE, SIG_IGN);
+   }
+
+   void TranslationServer::onTerminate(int signalNumber) {
+      stopRequested.store(true);
+   }
+
+   // Description: Accepts every pending connection on the listening socket.
+   void TranslationServer::acceptConnections() {
+
+      while (true) {
+         int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+         if (fd == -1) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+               cerr << "accept() failed: " << strerror(errno) << endl;
+            }
+            return;
+         }
+         struct epoll_event event;
+         event.events = EPOLLIN | EPOLLRDHUP;
+         event.data.fd = fd;
+         if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == -1) {
+            close(fd);
+            continue;
+         }
+         connections[fd] = Connection();
+      }
+   }
+
+   // Description: Reads a bounded amount of what is available from "fd", answers
+   //              every complete line and writes as much of the answers as the
+   //              socket accepts. Reading stops while too many answers are waiting.
+   void TranslationServer::serviceConnection(int fd, Connection & connection, unsigned int events) {
+
+      if (events & EPOLLERR) {
+         closeConnection(fd);
+         return;
+      }
+      if ((events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) && connection.out.size() < MAX_BUFFERED) {
+         char buffer[READ_CHUNK];
+         for (int reads = 0; reads < READS_PER_WAKE_UP && !connection.readClosed; reads++) {
+            ssize_t count = read(fd, buffer, sizeof(buffer));
+            if (count > 0) {
+               connection.in.append(buffer, count);
+            }
+            else if (count == 0) {
+               connection.readClosed = true;
+            }
+            else if (errno == EINTR) {
+               reads--;
+            }
+            else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+               break;
+            }
+            else {
+               closeConnection(fd);
+               return;
+            }
+         }
+         //everything read so far is answered as one batch
+         answerLines(connection);
+         if (connection.in.size() > MAX_BUFFERED) {
+            //a line that long would never be answered: waiting for its end cannot bound memory
+            cerr << "Closing a connection sending a line of over " << MAX_BUFFERED << " bytes." << endl;
+            closeConnection(fd);
+            return;
+         }
+      }
+      if (!flush(fd, connection)) {
+         closeConnection(fd);
+         return;
+      }
+      if (connection.readClosed && connection.out.empty()) {
+         closeConnection(fd);
+         return;
+      }
+
+      //only ask for EPOLLOUT while answers are waiting, and only for input while
+      //there is room for its answers and the client has not shut down its side
+      bool wantWrite = !connection.out.empty();
+      bool wantRead = !connection.readClosed && connection.out.size() < MAX_BUFFERED;
+      unsigned int wanted = (wantRead ? (EPOLLIN | EPOLLRDHUP) : 0) | (wantWrite ? EPOLLOUT : 0);
+      if (wanted != connection.events) {
+         struct epoll_event event;
+         event.events = wanted;
+         event.data.fd = fd;
+         epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+         connection.events = wanted;
+      }
+   }
+
+   // Description: Answers every complete line of "connection.in" in one batch.
+   //              At end of input, a last unterminated line is answered too.
+   void TranslationServer::answerLines(Connection & connection) {
+
+      size_t start = 0;
+      size_t end = connection.in.find('\n');
+      if (end == string::npos && !(connection.readClosed && !connection.in.empty())) {
+         return;
+      }
+
+      //one Dictionary for the whole batch, a reload cannot split it
+      std::shared_ptr<const Dictionary> myWords = reloader.acquire();
+      while (start < connection.in.size()) {
+         if (end == string::npos) {
+            if (!connection.readClosed) {
+               break;
+            }
+            end = connection.in.size();
+         }
+         WordPair nextWordPair(connection.in.substr(start, end - start));
+         try {
+            WordPair & check = myWords->get(nextWordPair);
+            connection.out += check.getEnglish();
+            connection.out += ':';
+            connection.out += check.getTranslation();
+            connection.out += '\n';
+         }
+         catch (EmptyDataCollectionException & anException) {
+            connection.out += "get() unsuccessful because ";
+            connection.out += anException.what();
+            connection.out += '\n';
+         }
+         catch (ElementDoesNotExistException & anException) {
+            connection.out += anException.what();
+            connection.out += '\n';
+         }
+         start = end + 1;
+         end = (start < connection.in.size()) ? connection.in.find('\n', start) : string::npos;
+      }
+      connection.in.erase(0, start);
+   }
+
+   // Description: Writes "connection.out" until done or the socket is full.
+   // Postcondition: Returns false if the socket failed.
+   bool TranslationServer::flush(int fd, Connection & connection) {
+
+      size_t written = 0;
+      while (written < connection.out.size()) {
+         ssize_t count = write(fd, connection.out.data() + written, connection.out.size() - written);
+         if (count > 0) {
+            written += count;
+         }
+         else if (count == -1 && errno == EINTR) {
+            continue;
+         }
+         else if (count == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+         }
+         else {
+            return false;
+         }
+      }
+      connection.out.erase(0, written);
+      return true;
+   }
+
+   void TranslationServer::closeConnection(int fd) {
+      epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+      close(fd);
+      connections.erase(fd);
+   }
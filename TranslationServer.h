@@ -0,0 +1,95 @@
+/*
+ * TranslationServer.h
+ * 
+ * Description: Serves Dictionary lookups to local clients over a Unix domain
+ *              socket. Clients send one English word per line and may pipeline
+ *              as many lines as they like; each line is answered, in order,
+ *              with the same line "translate" would print for it.
+ *              All connections are handled by one epoll event loop. Every
+ *              batch of lines read from a connection is answered from a single
+ *              Dictionary acquired from a DictionaryReloader, so the data file
+ *              can be reloaded while the server runs.
+ *              Each connection buffers at most MAX_BUFFERED bytes of answers:
+ *              past that, its input is no longer read until the client has
+ *              read its answers, and each wake-up reads a bounded amount from
+ *              it, so one client can neither exhaust memory nor starve others.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef TRANSLATION_SERVER_H
+#define TRANSLATION_SERVER_H
+
+#include "DictionaryReloader.h"
+#include <atomic>
+#include <sys/epoll.h>
+#include <string>
+#include <unordered_map>
+
+using std::string;
+
+class TranslationServer {
+
+private:
+
+   // Buffered state of one client connection.
+   struct Connection {
+      string in;                  // bytes received but not yet answered
+      string out;                 // answers not yet written to the socket
+      bool readClosed = false;    // the client has shut down its sending side
+      unsigned int events = EPOLLIN | EPOLLRDHUP;   // registered with epoll
+   };
+
+   string socketPath;
+   DictionaryReloader & reloader;
+   int listenFd = -1;
+   int epollFd = -1;
+   std::unordered_map<int, Connection> connections;
+
+   // Set by stop() or by the SIGINT/SIGTERM handler.
+   static std::atomic<bool> stopRequested;
+   static void onTerminate(int signalNumber);
+
+   // Description: Accepts every pending connection on the listening socket.
+   void acceptConnections();
+
+   // Description: Reads a bounded amount of what is available from "fd", answers
+   //              every complete line and writes as much of the answers as the
+   //              socket accepts. Reading stops while too many answers are waiting.
+   void serviceConnection(int fd, Connection & connection, unsigned int events);
+
+   // Description: Answers every complete line of "connection.in" in one batch.
+   //              At end of input, a last unterminated line is answered too.
+   void answerLines(Connection & connection);
+
+   // Description: Writes "connection.out" until done or the socket is full.
+   // Postcondition: Returns false if the socket failed.
+   bool flush(int fd, Connection & connection);
+
+   void closeConnection(int fd);
+
+public:
+
+   // Constructor and destructor
+   TranslationServer(const string & socketPath, DictionaryReloader & reloader);
+   ~TranslationServer();                     // Closes every socket
+
+   // Description: Creates, binds and listens on the Unix domain socket.
+   //              A stale socket file left at "socketPath" is replaced.
+   // Postcondition: Returns false, after printing the reason, if it failed.
+   bool start();
+
+   // Description: Runs the event loop until stop() is called or
+   //              SIGINT/SIGTERM is received.
+   // Precondition: start() returned true.
+   void run();
+
+   // Description: Makes run() return.
+   static void stop();
+
+   // Description: Makes SIGINT and SIGTERM stop the server, and ignores SIGPIPE.
+   static void installSignalHandlers();
+
+}; // end TranslationServer
+#endif
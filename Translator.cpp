@@ -17,6 +17,13 @@
 #include <fstream>
 #include "BST.h"
 #include "Dictionary.h"
+#include "DictionaryLoader.h"
+#include "DictionaryReloader.h"
+#include "DiskDictionary.h"
+#include "DiskDictionaryBuilder.h"
+#include "FrontCodedDictionary.h"
+#include "MultiLanguageDictionary.h"
+#include "PhraseTranslator.h"
 #include "WordPair.h"
 #include "ElementAlreadyExistsException.h"
 #include "ElementDoesNotExistException.h"
@@ -31,46 +38,269 @@ void display(WordPair& anElement) {
   cout << anElement;
 } 
 
-int main(int argc, char *argv[]) {
+// Description: Prints the "did you mean" suggestions of "myWords" for "notFound", if any.
+void printSuggestions(const Dictionary & myWords, const WordPair & notFound) {
 
-  Dictionary * myWords = new Dictionary();
+  std::vector<string> words = myWords.suggest(notFound);
+  if (words.empty()) {
+     return;
+  }
+  cout << "Did you mean: ";
+  for (unsigned int i = 0; i < words.size(); i++) {
+     cout << (i > 0 ? ", " : "") << words[i];
+  }
+  cout << "?" << endl;
+}
+
+// Description: Translates each line of standard input until EOF with "myWords".
+void translateCompact(const FrontCodedDictionary & myWords) {
+
+  string nextWord = "";
+  while (getline(cin, nextWord)) {
+     try {
+        cout << myWords.get(WordPair(nextWord));
+     }
+     catch (EmptyDataCollectionException& anException) {
+        cout << "get() unsuccessful because " << anException.what() << endl;
+     }
+     catch (ElementDoesNotExistException& anException) {
+        cout << anException.what() << endl;
+     }
+  }
+}
+
+// Description: Translates each line of standard input until EOF with "myWords",
+//              whose pages are read from disk as needed.
+void translateFromDisk(const DiskDictionary & myWords) {
+
+  string nextWord = "";
+  while (getline(cin, nextWord)) {
+     try {
+        cout << myWords.get(WordPair(nextWord));
+     }
+     catch (EmptyDataCollectionException& anException) {
+        cout << "get() unsuccessful because " << anException.what() << endl;
+     }
+     catch (ElementDoesNotExistException& anException) {
+        cout << anException.what() << endl;
+     }
+  }
+}
+
+// Description: Translates each line of standard input until EOF.
+//              Every query is answered by the Dictionary most recently
+//              swapped in by "reloader", so the data file can change meanwhile.
+void translateWithReload(DictionaryReloader & reloader) {
+
+  string nextWord = "";
+  while (getline(cin, nextWord)) {
+     WordPair nextWordPair(nextWord);
+     // hold the current Dictionary for the duration of this query only
+     std::shared_ptr<const Dictionary> myWords = reloader.acquire();
+     try {
+        WordPair& check = myWords->get(nextWordPair);
+        cout << check;
+     }
+     catch (EmptyDataCollectionException& anException) {
+        cout << "get() unsuccessful because " << anException.what() << endl;
+     }
+     catch (ElementDoesNotExistException& anException) {
+        cout << anException.what() << endl;
+     }
+  }
+}
+
+// Description: Translates each line of standard input until EOF into column
+//              "language" of "myWords", or into every column if "language" is -1.
+void translateMultiLanguage(const MultiLanguageDictionary & myWords, int language) {
+
+  string nextWord = "";
+  while (getline(cin, nextWord)) {
+     try {
+        if (language >= 0) {
+           cout << myWords.get(WordPair(nextWord), language);
+        }
+        else {
+           vector<string> translations = myWords.getAll(nextWord);
+           cout << nextWord;
+           for (const string & translation : translations) {
+              cout << ":" << translation;
+           }
+           cout << endl;
+        }
+     }
+     catch (EmptyDataCollectionException& anException) {
+        cout << "get() unsuccessful because " << anException.what() << endl;
+     }
+     catch (ElementDoesNotExistException& anException) {
+        cout << anException.what() << endl;
+     }
+  }
+}
+
+int main(int argc, char *argv[]) {
 
-  string nextLine = "";
   string nextWord = "";
-  string englishW = "";
-  string frenchW = "";
   string filename = "dataFile.txt";
-  string delimiter = ":";
-  size_t pos = 0;
-  WordPair translated;
- 
-  
-  ifstream myfile (filename);
-  if (myfile.is_open()) {
-     cout << "Reading..." << endl; 
-     while (getline(myfile,nextLine))
-     {
-        pos = nextLine.find(delimiter);
-        englishW = nextLine.substr(0, pos);
-        nextLine.erase(0, pos + delimiter.length());
-        frenchW = nextLine;
-        WordPair nextWordPair(englishW, frenchW);
-        // insert nextWordPair into "myWords" using a try/catch block
+  unsigned int normalization = KeyNormalizer::NONE;
+  bool suggestions = false;
+  bool compact = false;
+
+  // Options come first: "-n" lookups ignore case, extra whitespace and accents,
+  //                     "-s" words not found get "did you mean" suggestions
+  //                     "-c" queries are answered from a compact front-coded copy
+  while ((argc>1) && (argv[1][0] == '-')) {
+     if (strcmp(argv[1], "-n") == 0) {
+        normalization = KeyNormalizer::ALL;
+     }
+     else if (strcmp(argv[1], "-s") == 0) {
+        suggestions = true;
+     }
+     else if (strcmp(argv[1], "-c") == 0) {
+        compact = true;
+     }
+     argc--;
+     argv++;
+  }
+
+  // If user entered "multi <file> [language]", translate into one or all columns of <file>
+  if ((argc>2) && (strcmp(argv[1], "multi") == 0)) {
+     cout << "Reading..." << endl;
+     MultiLanguageDictionary * myWords = DictionaryLoader::loadMultiLanguage(argv[2], cout);
+     if (myWords == nullptr) {
+        cout << "Unable to open file";
+        return 0;
+     }
+     cout << "Finished reading." << endl;
+     int language = -1;
+     if (argc > 3) {
         try {
-           myWords->put(nextWordPair);
-        }
-        catch (ElementAlreadyExistsException& anException) {
-           cout << "put() unsuccessful because " << anException.what() << endl;
+           language = myWords->getLanguageIndex(argv[3]);
         }
-        catch (UnableToInsertException& anException) {
-           cout << "put() unsuccessful because " << anException.what() << endl;
+        catch (ElementDoesNotExistException& anException) {
+           cout << anException.what() << endl;
+           delete myWords;
+           return 0;
         }
      }
-     myfile.close();
+     translateMultiLanguage(*myWords, language);
+     delete myWords;
+     return 0;
+  }
+
+  // If user entered "reload" with program call, keep serving while dataFile.txt changes
+  if ((argc>1) && (strcmp(argv[1], "reload") == 0)) {
+     DictionaryReloader::installSignalHandler();
+     DictionaryReloader reloader(filename, normalization);
+     cout << "Reading..." << endl;
+     if (!reloader.start()) {
+        cout << "Unable to open file";
+        return 0;
+     }
      cout << "Finished reading." << endl;
+     translateWithReload(reloader);
+     return 0;
+  }
+
+  // If user entered "disk <file> [cachePages]", translate from a file written by "build"
+  // without loading the words into memory
+  if ((argc>2) && (strcmp(argv[1], "disk") == 0)) {
+     try {
+        DiskDictionary myWords(argv[2], (argc > 3) ? strtoul(argv[3], nullptr, 10) : 256);
+        translateFromDisk(myWords);
+     }
+     catch (std::logic_error& anException) {
+        cout << anException.what() << endl;
+     }
+     return 0;
+  }
+
+  // If user entered "build <file>", write the words as a disk dictionary file for "disk",
+  // sorting them in bounded runs rather than loading them into memory
+  if ((argc>2) && (strcmp(argv[1], "build") == 0)) {
+     try {
+        unsigned int written = DiskDictionaryBuilder::buildFromFile(filename, argv[2], normalization, cout);
+        cout << "Wrote " << written << " words to " << argv[2] << endl;
+     }
+     catch (std::logic_error& anException) {
+        cout << anException.what() << endl;
+     }
+     return 0;
+  }
+
+  Dictionary * myWords = new Dictionary();
+  myWords->setNormalization(normalization);
+  if (suggestions) {
+     myWords->enableSuggestions();
+  }
+
+  // In "text" mode standard output only carries the translated text
+  std::ostream & log = ((argc>1) && (strcmp(argv[1], "text") == 0)) ? std::cerr : cout;
+  log << "Reading..." << endl; 
+  if (DictionaryLoader::load(filename, *myWords, log)) {
+     log << "Finished reading." << endl;
+
+     // If user entered "-c", the pointer tree is only kept until the compact copy is built
+     if (compact && argc == 1) {
+        FrontCodedDictionary compactWords(*myWords);
+        delete myWords;
+        translateCompact(compactWords);
+        return 0;
+     }
 
+     // If user entered "text", translate running text phrase by phrase until EOF
+     if ((argc>1) && (strcmp(argv[1], "text") == 0)) {
+        PhraseTranslator phrases(*myWords);
+        delete myWords;
+        myWords = nullptr;
+        std::ios::sync_with_stdio(false);
+        phrases.translate(cin, cout);
+        return 0;
+     }
+     // If user entered "reverse", translate each line of standard input back into English
+     else if ((argc>1) && (strcmp(argv[1], "reverse") == 0)) {
+        myWords->enableReverseIndex();
+        while (getline(cin, nextWord)) {
+           std::vector<WordPair> found = myWords->getByTranslation(nextWord);
+           if (found.empty()) {
+              cout << "***Not Found!***" << endl;
+           }
+           for (WordPair & anElement : found) {
+              display(anElement);
+           }
+        }
+     }
+     // If user entered "export <file> [threads]", write all the words in order to <file>
+     else if ((argc>2) && (strcmp(argv[1], "export") == 0)) {
+        std::ofstream out(argv[2]);
+        if (!out) {
+           cout << "Unable to open file " << argv[2] << endl;
+        }
+        else {
+           myWords->exportContent(out, (argc > 3) ? strtoul(argv[3], nullptr, 10) : 0);
+           cout << "Exported " << myWords->getElementCount() << " words to " << argv[2] << endl;
+        }
+     }
+     // If user entered "page <offset> [count]", display one page of the words in order
+     else if ((argc>2) && (strcmp(argv[1], "page") == 0)) {
+        unsigned int offset = strtoul(argv[2], nullptr, 10);
+        unsigned int count = (argc > 3) ? strtoul(argv[3], nullptr, 10) : 50;
+        unsigned int shown = 0;
+        myWords->displayPage(offset, count, [&shown](WordPair & anElement) {
+           display(anElement);
+           shown++;
+        });
+        if (shown == 0) {
+           cout << "No words on this page (from " << offset + 1 << "): there are "
+                << myWords->getElementCount() << " words." << endl;
+        }
+        else {
+           cout << "Words " << offset + 1 << " to " << offset + shown << " of "
+                << myWords->getElementCount() << endl;
+        }
+     }
      // If user entered "display" with program call
-     if ((argc>1) && (strcmp(argv[1], "display") == 0)) {
+     else if ((argc>1) && (strcmp(argv[1], "display") == 0)) {
         try {
            myWords->displayContent(display);
         }
@@ -92,11 +322,13 @@ int main(int argc, char *argv[]) {
             }
             catch (ElementDoesNotExistException& anException) {
                cout << anException.what() << endl;
+               printSuggestions(*myWords, nextWordPair);
             }
             }
         }
   }
   else 
      cout << "Unable to open file"; 
+  delete myWords;
   return 0;
 }
\ No newline at end of file
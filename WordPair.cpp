@@ -26,17 +26,23 @@ WordPair::WordPair(string english, string translation) {
 }
 
 // Getters
-string WordPair::getEnglish() const {
+const string & WordPair::getEnglish() const {
    return this->english;
 }
 
-string WordPair::getTranslation() const {
+const string & WordPair::getTranslation() const {
    return this->translation;
 }
 
+const string & WordPair::getKey() const {
+   return this->hasKey ? this->key : this->english;
+}
+
 // Setters
 void WordPair::setEnglish(string english) {
    this->english = english;
+   this->key.clear();
+   this->hasKey = false;
    return;
 }
 
@@ -45,17 +51,29 @@ void WordPair::setTranslation(string translation) {
    return;
 }
 
+void WordPair::setKey(string key) {
+   //a key equal to "english" is not stored twice; any other key, even an
+   //empty one, is stored
+   this->hasKey = (key != this->english);
+   if (this->hasKey)
+      this->key = key;
+   else
+      this->key.clear();
+   return;
+}
+
 // Overloaded Operators
+// They compare keys in place, without copying either string.
 bool WordPair::operator==(const WordPair& rhs) const {
-   return (this->english.compare(rhs.getEnglish()) ) == 0;
+   return (this->getKey().compare(rhs.getKey()) ) == 0;
 } 
 
 bool WordPair::operator<(const WordPair& rhs) const {
-   return (this->english.compare(rhs.getEnglish()) ) < 0;
+   return (this->getKey().compare(rhs.getKey()) ) < 0;
 } 
 
 bool WordPair::operator>(const WordPair& rhs) const {
-   return (this->english.compare(rhs.getEnglish()) ) > 0;
+   return (this->getKey().compare(rhs.getKey()) ) > 0;
 } 
 
 // For testing purposes!
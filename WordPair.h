@@ -22,6 +22,8 @@ class WordPair {
 private:
    string english;
    string translation;
+   string key;          // normalized form of "english", when "hasKey"
+   bool hasKey = false; // false when "english" is its own key (the key is not stored twice)
    
 public:
    // Constructors
@@ -30,12 +32,14 @@ public:
    WordPair(string english, string translation) ;
 
    // Getters
-   string getEnglish() const ;
-   string getTranslation() const ;
+   const string & getEnglish() const ;
+   const string & getTranslation() const ;
+   const string & getKey() const ;      // what the overloaded operators compare
 
    // Setters
-   void setEnglish(string english) ;
+   void setEnglish(string english) ;    // also resets the key to "english"
    void setTranslation(string translation) ;
+   void setKey(string key) ;
 
    // Overloaded Operators
    bool operator==(const WordPair& rhs) const;
@@ -0,0 +1,112 @@
+/*
+ * WorkStealingPool.cpp
+ * 
+ * Description: Runs a batch of independent tasks on a fixed number of threads.
+ *              Each thread starts with its own contiguous share of the tasks,
+ *              which it runs in order from the front of its deque; a thread
+ *              that runs out steals from the back of another thread's deque,
+ *              so uneven tasks still keep every thread busy.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#include "WorkStealingPool.h"
+#include <exception>
+#include <thread>
+
+/* Constructor */
+
+   WorkStealingPool::WorkStealingPool(unsigned int threadCount) : threadCount(threadCount) {
+      if (this->threadCount == 0) {
+         this->threadCount = std::thread::hardware_concurrency();
+      }
+      if (this->threadCount == 0) {
+         this->threadCount = 1;
+      }
+   }
+
+
+/* Getter */
+
+   unsigned int WorkStealingPool::getThreadCount() const {
+      return threadCount;
+   }
+
+
+/* Pool operations */
+
+   // Description: Runs every task of "tasks" and returns once all have run.
+   // Exception: Rethrows the first exception a task threw, after all tasks have run.
+   void WorkStealingPool::run(std::vector< std::function<void()> > tasks) {
+
+      unsigned int workerCount = threadCount < tasks.size() ? threadCount : tasks.size();
+      if (workerCount == 0) {
+         return;
+      }
+      //contiguous shares: neighbouring tasks tend to touch neighbouring data
+      std::vector< std::unique_ptr<Worker> > workers;
+      for (unsigned int w = 0; w < workerCount; w++) {
+         workers.emplace_back(new Worker());
+         size_t first = tasks.size() * w / workerCount;
+         size_t last = tasks.size() * (w + 1) / workerCount;
+         for (size_t i = first; i < last; i++) {
+            workers[w]->tasks.push_back(std::move(tasks[i]));
+         }
+      }
+
+      std::exception_ptr failure;
+      std::mutex failureLock;
+      auto work = [&workers, &failure, &failureLock](unsigned int self) {
+         for (std::function<void()> task = nextTask(workers, self); task; task = nextTask(workers, self)) {
+            try {
+               task();
+            }
+            catch (...) {
+               std::lock_guard<std::mutex> guard(failureLock);
+               if (!failure) {
+                  failure = std::current_exception();
+               }
+            }
+         }
+      };
+      //the calling thread is one of the workers
+      std::vector<std::thread> threads;
+      for (unsigned int w = 1; w < workerCount; w++) {
+         threads.emplace_back(work, w);
+      }
+      work(0);
+      for (std::thread & thread : threads) {
+         thread.join();
+      }
+      if (failure) {
+         std::rethrow_exception(failure);
+      }
+   }
+
+   // Description: Removes and returns a task of "workers[self]", or else one
+   //              stolen from another worker; returns an empty function if none is left.
+   std::function<void()> WorkStealingPool::nextTask(std::vector< std::unique_ptr<Worker> > & workers,
+                                                    unsigned int self) {
+
+      std::function<void()> task;
+      {
+         std::lock_guard<std::mutex> guard(workers[self]->lock);
+         if (!workers[self]->tasks.empty()) {
+            task = std::move(workers[self]->tasks.front());
+            workers[self]->tasks.pop_front();
+            return task;
+         }
+      }
+      //steal the task its owner would run last
+      for (unsigned int i = 1; i < workers.size(); i++) {
+         Worker & victim = *workers[(self + i) % workers.size()];
+         std::lock_guard<std::mutex> guard(victim.lock);
+         if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            return task;
+         }
+      }
+      return task;
+   }
@@ -0,0 +1,55 @@
+/*
+ * WorkStealingPool.h
+ * 
+ * Description: Runs a batch of independent tasks on a fixed number of threads.
+ *              Each thread starts with its own contiguous share of the tasks,
+ *              which it runs in order from the front of its deque; a thread
+ *              that runs out steals from the back of another thread's deque,
+ *              so uneven tasks still keep every thread busy.
+ * 
+ * Author: Aidan de Vaal
+ * Date of last modification: Nov. 3, 2023
+ */
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class WorkStealingPool {
+
+private:
+
+   struct Worker {
+      std::deque< std::function<void()> > tasks;
+      std::mutex lock;
+   };
+
+   unsigned int threadCount;
+
+   // Description: Removes and returns a task of "workers[self]", or else one
+   //              stolen from another worker; returns an empty function if none is left.
+   static std::function<void()> nextTask(std::vector< std::unique_ptr<Worker> > & workers,
+                                         unsigned int self);
+
+public:
+
+   // Constructor
+   // Description: A pool of "threadCount" threads (at least 1), or one per
+   //              hardware thread if "threadCount" is 0.
+   WorkStealingPool(unsigned int threadCount = 0);
+
+   // Getter
+   unsigned int getThreadCount() const;
+
+   // Description: Runs every task of "tasks" and returns once all have run.
+   //              Tasks run concurrently, so they must not share unprotected state.
+   // Exception: Rethrows the first exception a task threw, after all tasks have run.
+   void run(std::vector< std::function<void()> > tasks);
+
+}; // end WorkStealingPool
+#endif